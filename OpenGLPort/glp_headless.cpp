@@ -0,0 +1,458 @@
+#include "glp_headless.h"
+
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace GL::Headless {
+    namespace {
+        struct BufferMemory {
+            std::vector<Ubyte> data;
+            Enum usage = 0;
+        };
+
+        struct State {
+            Uint nextName = 1;
+            std::unordered_map<Uint, BufferMemory> buffers;
+            std::unordered_map<Enum, Uint> bufferBindings;
+            std::unordered_map<Enum, Uint> textureBindings;
+            std::unordered_map<Enum, Uint> framebufferBindings;
+            std::unordered_map<std::string, Int> uniformLocations;
+            std::unordered_map<std::string_view, Uint64> callCounts;
+            std::unordered_map<Uint, Int> linkStatus; // only holds programs that failed
+            std::unordered_set<Uint> syncs;
+            Uint vertexArray = 0, program = 0;
+            Enum pendingError = 0;
+
+            FrameStats frame, totals;
+            bool tracing = false;
+            std::vector<std::string> trace;
+        };
+
+        State& GetState() {
+            static State state;
+            return state;
+        }
+
+        void Record(std::string_view function, const char* detailFmt = nullptr, ...) {
+            State& s = GetState();
+            ++s.callCounts[function];
+            ++s.frame.calls;
+            ++s.totals.calls;
+            if (!s.tracing) return;
+
+            std::string& line = s.trace.emplace_back(function);
+            if (detailFmt) {
+                char detail[128];
+                va_list args;
+                va_start(args, detailFmt);
+                std::vsnprintf(detail, sizeof(detail), detailFmt, args);
+                va_end(args);
+                line += ' ';
+                line += detail;
+            }
+        }
+
+        void AddStat(Uint64 FrameStats::* stat, Uint64 amount = 1) {
+            State& s = GetState();
+            s.frame.*stat += amount;
+            s.totals.*stat += amount;
+        }
+
+        void GenNames(Isize n, Uint* names) {
+            for (Isize i = 0; i < n; ++i) names[i] = GetState().nextName++;
+        }
+
+        BufferMemory* BoundMemory(Enum target) {
+            State& s = GetState();
+            const auto binding = s.bufferBindings.find(target);
+            if (binding == s.bufferBindings.end() || binding->second == 0) {
+                s.pendingError = INVALID_OPERATION;
+                return nullptr;
+            }
+            return &s.buffers[binding->second];
+        }
+
+        // what GetProgramBinary hands out, ProgramBinary only links programs given exactly this
+        constexpr Enum PROGRAM_BINARY_FORMAT = 0x9C70;
+        constexpr char PROGRAM_BINARY[] = "glp-headless";
+
+        Uint SyncName(Sync sync) { return (Uint)(std::uintptr_t)sync; }
+
+        template <class T> T DefaultReturn() {
+            if constexpr (!std::is_void_v<T>) return T {};
+        }
+    }
+
+    const FrameStats& CurrentFrame() { return GetState().frame; }
+
+    FrameStats EndFrame() {
+        const FrameStats last = GetState().frame;
+        GetState().frame = {};
+        return last;
+    }
+
+    const FrameStats& Totals() { return GetState().totals; }
+
+    Uint64 CallCount(const char* function) {
+        const auto& counts = GetState().callCounts;
+        const auto it = counts.find(function);
+        return it == counts.end() ? 0 : it->second;
+    }
+
+    Uint BoundBuffer(Enum target) {
+        const auto& bindings = GetState().bufferBindings;
+        const auto it = bindings.find(target);
+        return it == bindings.end() ? 0 : it->second;
+    }
+
+    Uint BoundVertexArray() { return GetState().vertexArray; }
+    Uint CurrentProgram() { return GetState().program; }
+    Uint LiveSyncCount() { return (Uint)GetState().syncs.size(); }
+
+    std::span<const Ubyte> BufferContents(Uint buffer) {
+        const auto& buffers = GetState().buffers;
+        const auto it = buffers.find(buffer);
+        if (it == buffers.end()) return {};
+        return { it->second.data.data(), it->second.data.size() };
+    }
+
+    void EnableTrace(bool enable) { GetState().tracing = enable; }
+
+    std::string DumpTrace() {
+        std::string out;
+        for (const std::string& line : GetState().trace) {
+            out += line;
+            out += '\n';
+        }
+        return out;
+    }
+
+    bool WriteTrace(const char* path) {
+        std::FILE* file = std::fopen(path, "w");
+        if (!file) return false;
+        const std::string dump = DumpTrace();
+        std::fwrite(dump.data(), 1, dump.size(), file);
+        std::fclose(file);
+        return true;
+    }
+
+    void ClearTrace() { GetState().trace.clear(); }
+
+    void Reset() {
+        const bool tracing = GetState().tracing;
+        GetState() = {};
+        GetState().tracing = tracing;
+    }
+}
+
+namespace GL {
+    using namespace Headless;
+
+#define COMMA() ,
+#define EMPTY()
+#define WAIT(X) X EMPTY() ()
+#define RUN(...) __VA_ARGS__
+#define CAT(A, B) A##B
+#define CAT2(A, B) CAT(A, B)
+#define DEL_FIRST(X, ...) __VA_ARGS__
+#define ARGS_1(T) WAIT(COMMA) T ARGS_2
+#define ARGS_2(V) V ARGS_1
+#define ARGS_1END
+#define ARGS_2END
+
+// functions listed here are written out by hand below, everything else only gets counted
+#define SECOND(A, B, ...) B
+#define CHECK_CUSTOM(...) SECOND(__VA_ARGS__, 0, )
+#define IS_CUSTOM(NAME) CHECK_CUSTOM(CAT2(CUSTOM_, NAME))
+#define CUSTOM_GenBuffers             ~, 1,
+#define CUSTOM_GenVertexArrays        ~, 1,
+#define CUSTOM_GenTextures            ~, 1,
+#define CUSTOM_GenFramebuffers        ~, 1,
+#define CUSTOM_GenRenderbuffers       ~, 1,
+#define CUSTOM_CreateProgram          ~, 1,
+#define CUSTOM_CreateShader           ~, 1,
+#define CUSTOM_DeleteBuffers          ~, 1,
+#define CUSTOM_BindBuffer             ~, 1,
+#define CUSTOM_BindBufferBase         ~, 1,
+#define CUSTOM_BindVertexArray        ~, 1,
+#define CUSTOM_BindTexture            ~, 1,
+#define CUSTOM_BindFramebuffer        ~, 1,
+#define CUSTOM_UseProgram             ~, 1,
+#define CUSTOM_Enable                 ~, 1,
+#define CUSTOM_Disable                ~, 1,
+#define CUSTOM_BufferData             ~, 1,
+#define CUSTOM_BufferSubData          ~, 1,
+#define CUSTOM_MapBuffer              ~, 1,
+#define CUSTOM_MapBufferRange         ~, 1,
+#define CUSTOM_UnmapBuffer            ~, 1,
+#define CUSTOM_GetError               ~, 1,
+#define CUSTOM_GetShaderiv            ~, 1,
+#define CUSTOM_GetProgramiv           ~, 1,
+#define CUSTOM_GetProgramBinary       ~, 1,
+#define CUSTOM_ProgramBinary          ~, 1,
+#define CUSTOM_GetUniformLocation     ~, 1,
+#define CUSTOM_GetIntegerv            ~, 1,
+#define CUSTOM_GetString              ~, 1,
+#define CUSTOM_CheckFramebufferStatus ~, 1,
+#define CUSTOM_DrawArrays             ~, 1,
+#define CUSTOM_DrawElements           ~, 1,
+#define CUSTOM_DrawElementsInstanced  ~, 1,
+#define CUSTOM_DrawElementsBaseVertex ~, 1,
+#define CUSTOM_DrawElementsInstancedBaseVertex ~, 1,
+#define CUSTOM_CopyBufferSubData      ~, 1,
+#define CUSTOM_MultiDrawElementsBaseVertex ~, 1,
+#define CUSTOM_FenceSync              ~, 1,
+#define CUSTOM_ClientWaitSync         ~, 1,
+#define CUSTOM_DeleteSync             ~, 1,
+
+#define IMPL_FN_0(NAME, RET, ARGS) \
+    RET NAME(RUN(DEL_FIRST EMPTY() (CAT2(ARGS_1 ARGS, END)))) \
+    { Record(#NAME); return DefaultReturn<RET>(); }
+#define IMPL_FN_1(NAME, RET, ARGS)
+#define IMPL_FN(NAME, RET, ARGS) CAT2(IMPL_FN_, IS_CUSTOM(NAME))(NAME, RET, ARGS)
+
+    GLPORT_ON_FUNCTIONS(IMPL_FN)
+
+    void GenBuffers(Isize n, Uint* buffers) {
+        GenNames(n, buffers);
+        for (Isize i = 0; i < n; ++i) GetState().buffers[buffers[i]];
+        Record("GenBuffers", "%d", n);
+    }
+    void GenVertexArrays(Isize n, Uint* arrays)             { GenNames(n, arrays);        Record("GenVertexArrays", "%d", n); }
+    void GenTextures(Isize n, Uint* textures)               { GenNames(n, textures);      Record("GenTextures", "%d", n); }
+    void GenFramebuffers(Isize n, Uint* framebuffers)       { GenNames(n, framebuffers);  Record("GenFramebuffers", "%d", n); }
+    void GenRenderbuffers(Isize n, Uint* renderbuffers)     { GenNames(n, renderbuffers); Record("GenRenderbuffers", "%d", n); }
+    Uint CreateProgram()                                    { Record("CreateProgram"); return GetState().nextName++; }
+    Uint CreateShader(Enum type)                            { Record("CreateShader", "0x%X", type); return GetState().nextName++; }
+
+    void DeleteBuffers(Isize n, const Uint* buffers) {
+        State& s = GetState();
+        for (Isize i = 0; i < n; ++i) {
+            s.buffers.erase(buffers[i]);
+            for (auto& [target, bound] : s.bufferBindings)
+                if (bound == buffers[i]) bound = 0;
+        }
+        Record("DeleteBuffers", "%d", n);
+    }
+
+    void BindBuffer(Enum target, Uint buffer) {
+        GetState().bufferBindings[target] = buffer;
+        AddStat(&FrameStats::stateChanges);
+        Record("BindBuffer", "0x%X %u", target, buffer);
+    }
+    void BindBufferBase(Enum target, Uint index, Uint buffer) {
+        // indexed points dont have storage here, only the plain binding they also change
+        GetState().bufferBindings[target] = buffer;
+        AddStat(&FrameStats::stateChanges);
+        Record("BindBufferBase", "0x%X %u %u", target, index, buffer);
+    }
+    void BindVertexArray(Uint array) {
+        GetState().vertexArray = array;
+        AddStat(&FrameStats::stateChanges);
+        Record("BindVertexArray", "%u", array);
+    }
+    void BindTexture(Enum target, Uint texture) {
+        GetState().textureBindings[target] = texture;
+        AddStat(&FrameStats::stateChanges);
+        Record("BindTexture", "0x%X %u", target, texture);
+    }
+    void BindFramebuffer(Enum target, Uint framebuffer) {
+        GetState().framebufferBindings[target] = framebuffer;
+        AddStat(&FrameStats::stateChanges);
+        Record("BindFramebuffer", "0x%X %u", target, framebuffer);
+    }
+    void UseProgram(Uint program) {
+        GetState().program = program;
+        AddStat(&FrameStats::stateChanges);
+        Record("UseProgram", "%u", program);
+    }
+    void Enable(Enum cap)  { AddStat(&FrameStats::stateChanges); Record("Enable",  "0x%X", cap); }
+    void Disable(Enum cap) { AddStat(&FrameStats::stateChanges); Record("Disable", "0x%X", cap); }
+
+    void BufferData(Enum target, IsizePtr size, const void* data, Enum usage) {
+        Record("BufferData", "0x%X %lld", target, (long long)size);
+        BufferMemory* storage = BoundMemory(target);
+        if (!storage) return;
+        storage->data.assign((std::size_t)size, 0);
+        storage->usage = usage;
+        if (data) {
+            std::memcpy(storage->data.data(), data, (std::size_t)size);
+            AddStat(&FrameStats::bytesUploaded, (Uint64)size);
+        }
+    }
+
+    void BufferSubData(Enum target, IntPtr offset, IsizePtr size, const void* data) {
+        Record("BufferSubData", "0x%X %lld+%lld", target, (long long)offset, (long long)size);
+        BufferMemory* storage = BoundMemory(target);
+        if (!storage) return;
+        // the same check a driver does, so out of range writes show up in GetError
+        if (offset < 0 || size < 0 || (std::size_t)(offset + size) > storage->data.size()) {
+            GetState().pendingError = INVALID_VALUE;
+            return;
+        }
+        std::memcpy(storage->data.data() + offset, data, (std::size_t)size);
+        AddStat(&FrameStats::bytesUploaded, (Uint64)size);
+    }
+
+    void* MapBuffer(Enum target, Enum access) {
+        Record("MapBuffer", "0x%X", target);
+        BufferMemory* storage = BoundMemory(target);
+        return storage ? storage->data.data() : nullptr;
+    }
+
+    void* MapBufferRange(Enum target, IntPtr offset, IsizePtr length, Bitfield access) {
+        Record("MapBufferRange", "0x%X %lld+%lld", target, (long long)offset, (long long)length);
+        BufferMemory* storage = BoundMemory(target);
+        if (!storage) return nullptr;
+        if (offset < 0 || length < 0 || (std::size_t)(offset + length) > storage->data.size()) {
+            GetState().pendingError = INVALID_VALUE;
+            return nullptr;
+        }
+        return storage->data.data() + offset;
+    }
+
+    void CopyBufferSubData(Enum readtarget, Enum writetarget, IntPtr readoffset, IntPtr writeoffset, IsizePtr size) {
+        Record("CopyBufferSubData", "0x%X 0x%X %lld->%lld %lld", readtarget, writetarget, (long long)readoffset, (long long)writeoffset, (long long)size);
+        BufferMemory* src = BoundMemory(readtarget), *dst = BoundMemory(writetarget);
+        if (!src || !dst) return;
+        if (readoffset < 0 || writeoffset < 0 || size < 0 ||
+            (std::size_t)(readoffset + size) > src->data.size() || (std::size_t)(writeoffset + size) > dst->data.size()) {
+            GetState().pendingError = INVALID_VALUE;
+            return;
+        }
+        std::memmove(dst->data.data() + writeoffset, src->data.data() + readoffset, (std::size_t)size);
+    }
+
+    Bool UnmapBuffer(Enum target) { Record("UnmapBuffer", "0x%X", target); return 1; }
+
+    Enum GetError() {
+        const Enum err = GetState().pendingError;
+        GetState().pendingError = 0;
+        return err;
+    }
+
+    void GetShaderiv(Uint shader, Enum pname, Int* param) {
+        Record("GetShaderiv", "%u 0x%X", shader, pname);
+        *param = pname == COMPILE_STATUS ? 1 : 0;
+    }
+
+    void GetProgramiv(Uint program, Enum pname, Int* param) {
+        Record("GetProgramiv", "%u 0x%X", program, pname);
+        const auto& status = GetState().linkStatus;
+        switch (pname) {
+            case LINK_STATUS:           *param = status.contains(program) ? status.at(program) : 1; break;
+            case VALIDATE_STATUS:       *param = 1; break;
+            case PROGRAM_BINARY_LENGTH: *param = sizeof(PROGRAM_BINARY); break;
+            default:                    *param = 0;
+        }
+    }
+
+    void GetProgramBinary(Uint program, Isize bufSize, Isize* length, Enum* binaryFormat, void* binary) {
+        Record("GetProgramBinary", "%u", program);
+        const Isize written = bufSize < (Isize)sizeof(PROGRAM_BINARY) ? 0 : (Isize)sizeof(PROGRAM_BINARY);
+        if (!written) GetState().pendingError = INVALID_OPERATION;
+        std::memcpy(binary, PROGRAM_BINARY, written);
+        if (length) *length = written;
+        *binaryFormat = PROGRAM_BINARY_FORMAT;
+    }
+
+    void ProgramBinary(Uint program, Enum binaryFormat, const void* binary, Isize length) {
+        Record("ProgramBinary", "%u 0x%X %d", program, binaryFormat, length);
+        if (binaryFormat != PROGRAM_BINARY_FORMAT) GetState().pendingError = INVALID_ENUM;
+        const bool valid = binaryFormat == PROGRAM_BINARY_FORMAT && length == (Isize)sizeof(PROGRAM_BINARY) &&
+                           std::memcmp(binary, PROGRAM_BINARY, sizeof(PROGRAM_BINARY)) == 0;
+        if (valid) GetState().linkStatus.erase(program);
+        else       GetState().linkStatus[program] = 0;
+    }
+
+    Int GetUniformLocation(Uint program, const char* name) {
+        Record("GetUniformLocation", "%u %s", program, name);
+        auto& locations = GetState().uniformLocations;
+        const auto [it, _] = locations.try_emplace(std::to_string(program) + ':' + name, (Int)locations.size());
+        return it->second;
+    }
+
+    void GetIntegerv(Enum pname, Int* params) {
+        Record("GetIntegerv", "0x%X", pname);
+        *params = pname == MAX_TEXTURE_IMAGE_UNITS ? 16 : pname == NUM_PROGRAM_BINARY_FORMATS ? 1 : 0;
+    }
+
+    const Ubyte* GetString(Enum name) {
+        Record("GetString", "0x%X", name);
+        return (const Ubyte*)"headless";
+    }
+
+    Enum CheckFramebufferStatus(Enum target) { Record("CheckFramebufferStatus"); return FRAMEBUFFER_COMPLETE; }
+
+    void DrawArrays(Enum mode, Int first, Isize count) {
+        AddStat(&FrameStats::drawCalls);
+        AddStat(&FrameStats::primitivesSubmitted, (Uint64)count);
+        Record("DrawArrays", "0x%X %d %d", mode, first, count);
+    }
+
+    void DrawElements(Enum mode, Isize count, Enum type, const void* indices) {
+        AddStat(&FrameStats::drawCalls);
+        AddStat(&FrameStats::primitivesSubmitted, (Uint64)count);
+        Record("DrawElements", "0x%X %d program=%u vao=%u", mode, count, CurrentProgram(), BoundVertexArray());
+    }
+
+    void DrawElementsInstanced(Enum mode, Isize count, Enum type, const void* indices, Isize primcount) {
+        AddStat(&FrameStats::drawCalls);
+        AddStat(&FrameStats::primitivesSubmitted, (Uint64)count * (Uint64)primcount);
+        Record("DrawElementsInstanced", "0x%X %d x%d program=%u vao=%u", mode, count, primcount, CurrentProgram(), BoundVertexArray());
+    }
+
+    void DrawElementsBaseVertex(Enum mode, Isize count, Enum type, void* indices, Int basevertex) {
+        AddStat(&FrameStats::drawCalls);
+        AddStat(&FrameStats::primitivesSubmitted, (Uint64)count);
+        Record("DrawElementsBaseVertex", "0x%X %d @%lld+%d program=%u vao=%u", mode, count, (long long)(IntPtr)indices, basevertex, CurrentProgram(), BoundVertexArray());
+    }
+
+    void DrawElementsInstancedBaseVertex(Enum mode, Isize count, Enum type, const void* indices, Isize primcount, Int basevertex) {
+        AddStat(&FrameStats::drawCalls);
+        AddStat(&FrameStats::primitivesSubmitted, (Uint64)count * (Uint64)primcount);
+        Record("DrawElementsInstancedBaseVertex", "0x%X %d x%d @%lld+%d program=%u vao=%u", mode, count, primcount, (long long)(IntPtr)indices, basevertex, CurrentProgram(), BoundVertexArray());
+    }
+
+    void MultiDrawElementsBaseVertex(Enum mode, Isize* count, Enum type, void** indices, Isize primcount, Int* basevertex) {
+        AddStat(&FrameStats::drawCalls);
+        for (Isize i = 0; i < primcount; ++i) AddStat(&FrameStats::primitivesSubmitted, (Uint64)count[i]);
+        Record("MultiDrawElementsBaseVertex", "0x%X x%d program=%u vao=%u", mode, primcount, CurrentProgram(), BoundVertexArray());
+    }
+
+    // nothing runs behind the cpu, so a fence is signaled as soon as its made
+    Sync FenceSync(Enum condition, Bitfield flags) {
+        const Uint name = GetState().nextName++;
+        GetState().syncs.insert(name);
+        Record("FenceSync", "%u", name);
+        return (Sync)(std::uintptr_t)name;
+    }
+
+    Enum ClientWaitSync(Sync sync, Bitfield flags, Uint64 timeout) {
+        Record("ClientWaitSync", "%u", SyncName(sync));
+        if (GetState().syncs.contains(SyncName(sync))) return ALREADY_SIGNALED;
+        GetState().pendingError = INVALID_VALUE;
+        return WAIT_FAILED;
+    }
+
+    void DeleteSync(Sync sync) {
+        Record("DeleteSync", "%u", SyncName(sync));
+        // deleting 0 is allowed and does nothing
+        if (sync && !GetState().syncs.erase(SyncName(sync))) GetState().pendingError = INVALID_VALUE;
+    }
+
+    bool Supports(const char* name) {
+        return false;
+    }
+
+    Enum InitGLEW() {
+        return 0;
+    }
+}
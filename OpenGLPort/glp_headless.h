@@ -0,0 +1,41 @@
+#pragma once
+
+#include <span>
+#include <string>
+
+#include "glp.h"
+
+// recording backend used when built with GLPORT_HEADLESS.
+// every GL:: call is counted (and traced if enabled) instead of reaching a driver,
+// object names and buffer contents are tracked so cpu side render code runs unchanged.
+// shaders are never compiled, so reflection queries (active uniforms, attributes, blocks)
+// report nothing and uniform locations are made up per name. fences are signaled right away
+namespace GL::Headless {
+    struct FrameStats {
+        Uint64 calls = 0;
+        Uint64 drawCalls = 0;
+        Uint64 primitivesSubmitted = 0; // indices or vertices passed to draws
+        Uint64 bytesUploaded = 0;       // through BufferData and BufferSubData
+        Uint64 stateChanges = 0;        // binds, UseProgram, Enable/Disable
+    };
+
+    // per frame counters, EndFrame returns them and starts counting the next frame
+    const FrameStats& CurrentFrame();
+    FrameStats EndFrame();
+    const FrameStats& Totals();
+    Uint64 CallCount(const char* function);
+
+    Uint BoundBuffer(Enum target);
+    Uint BoundVertexArray();
+    Uint CurrentProgram();
+    Uint LiveSyncCount(); // fences made and not deleted yet
+    std::span<const Ubyte> BufferContents(Uint buffer);
+
+    void EnableTrace(bool enable = true);
+    std::string DumpTrace();
+    bool WriteTrace(const char* path);
+    void ClearTrace();
+
+    // forgets all objects, counters and the trace
+    void Reset();
+}
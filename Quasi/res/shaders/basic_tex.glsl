@@ -9,8 +9,10 @@ layout(location = 3) in float texCorner;
 out vec4 v_color;
 out vec2 v_texID;
 
-uniform mat4 u_projection;
-uniform mat4 u_view;
+layout (std140) uniform Camera {
+    mat4 u_projection;
+    mat4 u_view;
+};
 uniform iVector2 texSize;
 
 void main()
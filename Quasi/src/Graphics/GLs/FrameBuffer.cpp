@@ -4,6 +4,7 @@
 
 #include "RenderBuffer.h"
 #include "GLDebug.h"
+#include "GLStateCache.h"
 #include "Textures/Texture.h"
 
 namespace Quasi::Graphics {
@@ -17,14 +18,15 @@ namespace Quasi::Graphics {
 
     void FrameBuffer::DestroyObject(GraphicsID id) {
         QGLCall$(GL::DeleteFramebuffers(1, &id));
+        GLStateCache::ForgetFramebuffer(id);
     }
 
     void FrameBuffer::BindObject(GraphicsID id) {
-        QGLCall$(GL::BindFramebuffer(GL::FRAMEBUFFER, id));
+        GLStateCache::BindFramebuffer(GL::FRAMEBUFFER, id);
     }
 
     void FrameBuffer::UnbindObject() {
-        QGLCall$(GL::BindFramebuffer(GL::FRAMEBUFFER, 0));
+        GLStateCache::BindFramebuffer(GL::FRAMEBUFFER, 0);
     }
 
     void FrameBuffer::Attach(const Texture& tex, AttachmentType type) const {
@@ -35,6 +37,17 @@ namespace Quasi::Graphics {
         QGLCall$(GL::FramebufferRenderbuffer(GL::FRAMEBUFFER, (int)type, GL::RENDERBUFFER, rbo.rendererID));
     }
 
+    void FrameBuffer::DrawTo(u32 colorCount) const {
+        if (colorCount == 0) {
+            QGLCall$(GL::DrawBuffer(0));
+            QGLCall$(GL::ReadBuffer(0));
+            return;
+        }
+        GL::Enum buffers[16];
+        for (u32 i = 0; i < colorCount; ++i) buffers[i] = (GL::Enum)AttachmentType::COLOR_0 + i;
+        QGLCall$(GL::DrawBuffers((int)colorCount, buffers));
+    }
+
     void FrameBuffer::Complete() const {
         const int status = GL::CheckFramebufferStatus(GL::FRAMEBUFFER);
         if (status != GL::FRAMEBUFFER_COMPLETE) {
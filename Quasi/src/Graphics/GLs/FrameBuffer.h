@@ -40,6 +40,8 @@ namespace Quasi::Graphics {
 
         void Attach(const Texture& tex, AttachmentType type = AttachmentType::COLOR_0) const;
         void Attach(const RenderBuffer& rbo, AttachmentType type) const;
+        // which color attachments get drawn to, 0 for depth only
+        void DrawTo(u32 colorCount) const;
         void Complete() const;
 
         friend class GraphicsDevice;
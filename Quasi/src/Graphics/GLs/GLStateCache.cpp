@@ -0,0 +1,227 @@
+#include "GLStateCache.h"
+
+#include <glp.h>
+#include "GLDebug.h"
+
+namespace Quasi::Graphics {
+    namespace {
+        constexpr GraphicsID UNKNOWN = ~0u;
+
+        enum BufferSlot { ARRAY_BUF, ELEMENT_BUF, UNIFORM_BUF, COPY_READ_BUF, COPY_WRITE_BUF, PIXEL_UNPACK_BUF, BUFFER_SLOT_COUNT };
+        enum TextureSlot { TEX_1D, TEX_2D, TEX_3D, TEX_CUBE, TEX_1D_ARRAY, TEX_2D_ARRAY, TEX_2D_MS, TEX_RECT, TEXTURE_SLOT_COUNT };
+        enum CapabilitySlot { CAP_BLEND, CAP_DEPTH, CAP_CULL, CAP_STENCIL, CAP_SCISSOR, CAP_MULTISAMPLE, CAPABILITY_SLOT_COUNT };
+
+        struct CachedState {
+            GraphicsID program, vertexArray, drawFramebuffer, readFramebuffer, renderbuffer;
+            GraphicsID buffers[BUFFER_SLOT_COUNT];
+            GraphicsID uniformBindings[GLStateCache::MAX_UNIFORM_BINDINGS];
+            u32 activeUnit;
+            GraphicsID textures[GLStateCache::MAX_TEXTURE_UNITS][TEXTURE_SLOT_COUNT];
+            i8 capabilities[CAPABILITY_SLOT_COUNT]; // -1 if unknown
+
+            CachedState() { Invalidate(); }
+
+            void Invalidate() {
+                program = vertexArray = drawFramebuffer = readFramebuffer = renderbuffer = UNKNOWN;
+                for (GraphicsID& b : buffers) b = UNKNOWN;
+                for (GraphicsID& b : uniformBindings) b = UNKNOWN;
+                activeUnit = UNKNOWN;
+                for (auto& unit : textures) for (GraphicsID& t : unit) t = UNKNOWN;
+                for (i8& c : capabilities) c = -1;
+            }
+        };
+
+        CachedState state;
+        GLStateCache::Counter counters[GLStateCache::CATEGORY_COUNT];
+
+        int BufferSlotOf(u32 target) {
+            switch (target) {
+                case GL::ARRAY_BUFFER:         return ARRAY_BUF;
+                case GL::ELEMENT_ARRAY_BUFFER: return ELEMENT_BUF;
+                case GL::UNIFORM_BUFFER:       return UNIFORM_BUF;
+                case GL::COPY_READ_BUFFER:     return COPY_READ_BUF;
+                case GL::COPY_WRITE_BUFFER:    return COPY_WRITE_BUF;
+                case GL::PIXEL_UNPACK_BUFFER:  return PIXEL_UNPACK_BUF;
+                default:                       return -1;
+            }
+        }
+
+        int TextureSlotOf(u32 target) {
+            switch (target) {
+                case GL::TEXTURE_1D:             return TEX_1D;
+                case GL::TEXTURE_2D:             return TEX_2D;
+                case GL::TEXTURE_3D:             return TEX_3D;
+                case GL::TEXTURE_CUBE_MAP:       return TEX_CUBE;
+                case GL::TEXTURE_1D_ARRAY:       return TEX_1D_ARRAY;
+                case GL::TEXTURE_2D_ARRAY:       return TEX_2D_ARRAY;
+                case GL::TEXTURE_2D_MULTISAMPLE: return TEX_2D_MS;
+                case GL::TEXTURE_RECTANGLE:      return TEX_RECT;
+                default:                         return -1;
+            }
+        }
+
+        int CapabilitySlotOf(u32 cap) {
+            switch (cap) {
+                case GL::BLEND:        return CAP_BLEND;
+                case GL::DEPTH_TEST:   return CAP_DEPTH;
+                case GL::CULL_FACE:    return CAP_CULL;
+                case GL::STENCIL_TEST: return CAP_STENCIL;
+                case GL::SCISSOR_TEST: return CAP_SCISSOR;
+                case GL::MULTISAMPLE:  return CAP_MULTISAMPLE;
+                default:               return -1;
+            }
+        }
+
+        // true if the call has to go through, counting it either way
+        template <class T>
+        bool Update(GLStateCache::Category category, T& cached, T value) {
+            if (cached == value) {
+                ++counters[category].hits;
+                return false;
+            }
+            ++counters[category].misses;
+            cached = value;
+            return true;
+        }
+
+        GraphicsID& ForgetIf(GraphicsID& cached, GraphicsID id) {
+            if (cached == id) cached = 0;
+            return cached;
+        }
+    }
+
+    void GLStateCache::UseProgram(GraphicsID id) {
+        if (Update(PROGRAM, state.program, id))
+            QGLCall$(GL::UseProgram(id));
+    }
+
+    void GLStateCache::BindVertexArray(GraphicsID id) {
+        if (!Update(VERTEX_ARRAY, state.vertexArray, id)) return;
+        QGLCall$(GL::BindVertexArray(id));
+        // the element buffer binding is part of the vao
+        state.buffers[ELEMENT_BUF] = UNKNOWN;
+    }
+
+    void GLStateCache::BindBuffer(u32 target, GraphicsID id) {
+        const int slot = BufferSlotOf(target);
+        if (slot < 0) {
+            ++counters[BUFFER].misses;
+            QGLCall$(GL::BindBuffer(target, id));
+            return;
+        }
+        if (Update(BUFFER, state.buffers[slot], id))
+            QGLCall$(GL::BindBuffer(target, id));
+    }
+
+    void GLStateCache::BindBufferBase(u32 target, u32 index, GraphicsID id) {
+        if (target != GL::UNIFORM_BUFFER || index >= MAX_UNIFORM_BINDINGS) {
+            ++counters[BUFFER].misses;
+            QGLCall$(GL::BindBufferBase(target, index, id));
+            if (const int slot = BufferSlotOf(target); slot >= 0) state.buffers[slot] = id;
+            return;
+        }
+        if (!Update(BUFFER, state.uniformBindings[index], id)) return;
+        QGLCall$(GL::BindBufferBase(target, index, id));
+        state.buffers[UNIFORM_BUF] = id;
+    }
+
+    void GLStateCache::BindFramebuffer(u32 target, GraphicsID id) {
+        bool changed = false;
+        if (target != GL::READ_FRAMEBUFFER) changed |= state.drawFramebuffer != id;
+        if (target != GL::DRAW_FRAMEBUFFER) changed |= state.readFramebuffer != id;
+        if (!changed) {
+            ++counters[FRAMEBUFFER].hits;
+            return;
+        }
+        ++counters[FRAMEBUFFER].misses;
+        if (target != GL::READ_FRAMEBUFFER) state.drawFramebuffer = id;
+        if (target != GL::DRAW_FRAMEBUFFER) state.readFramebuffer = id;
+        QGLCall$(GL::BindFramebuffer(target, id));
+    }
+
+    void GLStateCache::BindRenderbuffer(GraphicsID id) {
+        if (Update(FRAMEBUFFER, state.renderbuffer, id))
+            QGLCall$(GL::BindRenderbuffer(GL::RENDERBUFFER, id));
+    }
+
+    void GLStateCache::ActiveTexture(u32 unit) {
+        if (Update(TEXTURE, state.activeUnit, unit))
+            QGLCall$(GL::ActiveTexture(GL::TEXTURE0 + unit));
+    }
+
+    void GLStateCache::BindTexture(u32 target, GraphicsID id) {
+        const int slot = TextureSlotOf(target);
+        if (slot < 0 || state.activeUnit >= MAX_TEXTURE_UNITS) {
+            ++counters[TEXTURE].misses;
+            QGLCall$(GL::BindTexture(target, id));
+            return;
+        }
+        if (Update(TEXTURE, state.textures[state.activeUnit][slot], id))
+            QGLCall$(GL::BindTexture(target, id));
+    }
+
+    void GLStateCache::SetCapability(u32 cap, bool enabled) {
+        const int slot = CapabilitySlotOf(cap);
+        if (slot >= 0 && !Update(CAPABILITY, state.capabilities[slot], (i8)enabled)) return;
+        if (slot < 0) ++counters[CAPABILITY].misses;
+        if (enabled) QGLCall$(GL::Enable(cap));
+        else         QGLCall$(GL::Disable(cap));
+    }
+
+    void GLStateCache::ForgetProgram(GraphicsID id) {
+        // a deleted program stays in use until something else is bound
+        if (state.program == id) state.program = UNKNOWN;
+    }
+
+    void GLStateCache::ForgetVertexArray(GraphicsID id) {
+        if (ForgetIf(state.vertexArray, id) == 0) state.buffers[ELEMENT_BUF] = UNKNOWN;
+    }
+
+    void GLStateCache::ForgetBuffer(GraphicsID id) {
+        for (GraphicsID& b : state.buffers) ForgetIf(b, id);
+        for (GraphicsID& b : state.uniformBindings) ForgetIf(b, id);
+    }
+
+    void GLStateCache::ForgetTexture(GraphicsID id) {
+        for (auto& unit : state.textures)
+            for (GraphicsID& t : unit) ForgetIf(t, id);
+    }
+
+    void GLStateCache::ForgetFramebuffer(GraphicsID id) {
+        ForgetIf(state.drawFramebuffer, id);
+        ForgetIf(state.readFramebuffer, id);
+    }
+
+    void GLStateCache::Invalidate() {
+        state.Invalidate();
+    }
+
+    const GLStateCache::Counter& GLStateCache::GetCounter(Category category) {
+        return counters[category];
+    }
+
+    GLStateCache::Counter GLStateCache::Total() {
+        Counter total;
+        for (const Counter& c : counters) {
+            total.hits += c.hits;
+            total.misses += c.misses;
+        }
+        return total;
+    }
+
+    void GLStateCache::ResetCounters() {
+        for (Counter& c : counters) c = {};
+    }
+
+    Str GLStateCache::CategoryName(Category category) {
+        switch (category) {
+            case PROGRAM:      return "Program";
+            case VERTEX_ARRAY: return "Vertex Array";
+            case BUFFER:       return "Buffer";
+            case TEXTURE:      return "Texture";
+            case FRAMEBUFFER:  return "Framebuffer";
+            case CAPABILITY:   return "Capability";
+            default:           return "";
+        }
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "GLObject.h"
+
+namespace Quasi::Graphics {
+    // mirrors what is bound in the gl context, so binding something that is
+    // already bound never reaches the driver. every GLObject binds through here,
+    // there is only ever one context so the state is global
+    class GLStateCache {
+    public:
+        enum Category { PROGRAM, VERTEX_ARRAY, BUFFER, TEXTURE, FRAMEBUFFER, CAPABILITY, CATEGORY_COUNT };
+        struct Counter {
+            u64 hits = 0, misses = 0;
+        };
+        static constexpr u32 MAX_TEXTURE_UNITS = 32;
+        static constexpr u32 MAX_UNIFORM_BINDINGS = 36;
+
+        static void UseProgram(GraphicsID id);
+        static void BindVertexArray(GraphicsID id);
+        static void BindBuffer(u32 target, GraphicsID id);
+        // binds to an indexed point, which also changes the plain target binding
+        static void BindBufferBase(u32 target, u32 index, GraphicsID id);
+        static void BindFramebuffer(u32 target, GraphicsID id);
+        static void BindRenderbuffer(GraphicsID id);
+        static void ActiveTexture(u32 unit);
+        static void BindTexture(u32 target, GraphicsID id);
+        static void SetCapability(u32 cap, bool enabled);
+
+        // deleting an object unbinds it, so the cache has to forget it as well
+        static void ForgetProgram(GraphicsID id);
+        static void ForgetVertexArray(GraphicsID id);
+        static void ForgetBuffer(GraphicsID id);
+        static void ForgetTexture(GraphicsID id);
+        static void ForgetFramebuffer(GraphicsID id);
+        // marks everything unknown, for when gl was touched behind the cache's back
+        static void Invalidate();
+
+        static const Counter& GetCounter(Category category);
+        static Counter Total();
+        static void ResetCounters();
+        static Str CategoryName(Category category);
+    };
+}
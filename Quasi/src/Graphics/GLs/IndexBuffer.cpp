@@ -5,32 +5,47 @@
 #include <glp.h>
 
 #include "GLDebug.h"
+#include "GLStateCache.h"
 
 namespace Quasi::Graphics {
-    IndexBuffer::IndexBuffer(GraphicsID id, u32 size) : GLObject(id), bufferSize(size) {}
+    namespace {
+        // uploads data narrowed to u16, a chunk at a time
+        void UploadShort(u32 byteOffset, Span<const u32> data) {
+            u16 narrow[1024];
+            for (usize begin = 0; begin < data.Length(); begin += std::size(narrow)) {
+                const usize count = std::min(data.Length() - begin, std::size(narrow));
+                for (usize i = 0; i < count; ++i) narrow[i] = (u16)data[begin + i];
+                QGLCall$(GL::BufferSubData(GL::ELEMENT_ARRAY_BUFFER, byteOffset + begin * sizeof(u16), count * sizeof(u16), narrow));
+            }
+        }
+    }
+
+    IndexBuffer::IndexBuffer(GraphicsID id, u32 size, GLTypeID type) : GLObject(id), bufferSize(size), indexType(type) {}
 
-    IndexBuffer IndexBuffer::New(u32 size) {
+    IndexBuffer IndexBuffer::New(u32 size, GLTypeID type) {
         GraphicsID id;
         QGLCall$(GL::GenBuffers(1, &id));
         BindObject(id);
-        QGLCall$(GL::BufferData(GL::ELEMENT_ARRAY_BUFFER, sizeof(u32) * size, nullptr, GL::DYNAMIC_DRAW));
-        return IndexBuffer { id, size };
+        QGLCall$(GL::BufferData(GL::ELEMENT_ARRAY_BUFFER, type->typeSize * size, nullptr, GL::DYNAMIC_DRAW));
+        return IndexBuffer { id, size, type };
     }
 
     void IndexBuffer::DestroyObject(GraphicsID id) {
         QGLCall$(GL::DeleteBuffers(1, &id));
+        GLStateCache::ForgetBuffer(id);
     }
 
     void IndexBuffer::BindObject(GraphicsID id) {
-        QGLCall$(GL::BindBuffer(GL::ELEMENT_ARRAY_BUFFER, id));
+        GLStateCache::BindBuffer(GL::ELEMENT_ARRAY_BUFFER, id);
     }
 
     void IndexBuffer::UnbindObject() {
-        QGLCall$(GL::BindBuffer(GL::ELEMENT_ARRAY_BUFFER, 0));
+        GLStateCache::BindBuffer(GL::ELEMENT_ARRAY_BUFFER, 0);
     }
 
     void IndexBuffer::SetData(Span<const u32> data, u32 dOffset) {
         Bind();
+        if (IsShort()) return UploadShort(dOffset, data);
         QGLCall$(GL::BufferSubData(GL::ELEMENT_ARRAY_BUFFER, dOffset, data.ByteSize(), data.Data()));
     }
 
@@ -40,7 +55,49 @@ namespace Quasi::Graphics {
 
     void IndexBuffer::AddData(Span<const u32> data) {
         Bind();
-        QGLCall$(GL::BufferSubData(GL::ELEMENT_ARRAY_BUFFER, dataOffset * sizeof(u32), data.ByteSize(), data.Data()));
+        if (IsShort()) UploadShort(dataOffset * sizeof(u16), data);
+        else QGLCall$(GL::BufferSubData(GL::ELEMENT_ARRAY_BUFFER, dataOffset * sizeof(u32), data.ByteSize(), data.Data()));
         dataOffset += (u32)data.Length();
     }
+
+    u32* IndexBuffer::MapRange(u32 offset, u32 count, bool invalidate) {
+        Bind();
+        if (IsShort()) {
+            GLLogger().Error("Tried to map a USHORT index buffer as u32.");
+            return nullptr;
+        }
+        void* ptr = QGLCall$(GL::MapBufferRange(GL::ELEMENT_ARRAY_BUFFER, offset * sizeof(u32), count * sizeof(u32),
+            GL::MAP_WRITE_BIT | GL::MAP_UNSYNCHRONIZED_BIT | (invalidate ? GL::MAP_INVALIDATE_RANGE_BIT : 0)));
+        return (u32*)ptr;
+    }
+
+    void IndexBuffer::Unmap() {
+        Bind();
+        QGLCall$(GL::UnmapBuffer(GL::ELEMENT_ARRAY_BUFFER));
+    }
+
+    void IndexBuffer::Resize(u32 size, u32 keepOffset, u32 keepCount) {
+        Bind();
+        const u32 isize = IndexSize();
+        if (keepCount == 0) {
+            QGLCall$(GL::BufferData(GL::ELEMENT_ARRAY_BUFFER, size * isize, nullptr, GL::DYNAMIC_DRAW));
+        } else {
+            GraphicsID temp;
+            QGLCall$(GL::GenBuffers(1, &temp));
+            GLStateCache::BindBuffer(GL::COPY_WRITE_BUFFER, temp);
+            QGLCall$(GL::BufferData(GL::COPY_WRITE_BUFFER, keepCount * isize, nullptr, GL::STREAM_COPY));
+            QGLCall$(GL::CopyBufferSubData(GL::ELEMENT_ARRAY_BUFFER, GL::COPY_WRITE_BUFFER, keepOffset * isize, 0, keepCount * isize));
+            QGLCall$(GL::BufferData(GL::ELEMENT_ARRAY_BUFFER, size * isize, nullptr, GL::DYNAMIC_DRAW));
+            QGLCall$(GL::CopyBufferSubData(GL::COPY_WRITE_BUFFER, GL::ELEMENT_ARRAY_BUFFER, 0, 0, keepCount * isize));
+            QGLCall$(GL::DeleteBuffers(1, &temp));
+            GLStateCache::ForgetBuffer(temp);
+        }
+        bufferSize = size;
+        dataOffset = 0;
+    }
+
+    void IndexBuffer::Reformat(u32 size, GLTypeID type) {
+        indexType = type;
+        Resize(size);
+    }
 }
@@ -2,20 +2,27 @@
 #include "Span.h"
 
 #include "GLObject.h"
+#include "GLTypeID.h"
 #include "TriIndices.h"
 
 namespace Quasi::Graphics {
     struct TriIndices;
 
+    // indices are always given as u32, a USHORT buffer narrows them on upload and takes half the memory.
+    // only buffers for at most SHORT_LIMIT vertices (counted from the base vertex) can be USHORT
     class IndexBuffer : public GLObject<IndexBuffer> {
     private:
         u32 bufferSize = 0;
         u32 dataOffset = 0;
+        GLTypeID indexType = GLTypeID::UINT;
 
-        explicit IndexBuffer(GraphicsID id, u32 size);
+        explicit IndexBuffer(GraphicsID id, u32 size, GLTypeID type);
     public:
+        static constexpr u32 SHORT_LIMIT = 1 << 16;
+
         IndexBuffer() = default;
-        static IndexBuffer New(u32 size);
+        static IndexBuffer New(u32 size, GLTypeID type = GLTypeID::UINT);
+        static GLTypeID TypeFor(usize vertexCount) { return vertexCount <= SHORT_LIMIT ? GLTypeID::USHORT : GLTypeID::UINT; }
         static void DestroyObject(GraphicsID id);
         static void BindObject(GraphicsID id);
         static void UnbindObject();
@@ -28,8 +35,18 @@ namespace Quasi::Graphics {
         void AddData(Span<const u32> data);
         void AddData(Span<const TriIndices> data) { AddData(data.Transmute<u32>()); }
 
+        // same as the VertexBuffer versions, but counted in indices. mapping is only for UINT buffers
+        u32* MapRange(u32 offset, u32 count, bool invalidate = true);
+        void Unmap();
+        void Resize(u32 size, u32 keepOffset = 0, u32 keepCount = 0);
+        // drops the contents, the buffer object stays the same so vertex arrays still point at it
+        void Reformat(u32 size, GLTypeID type);
+
         u32 GetLength() const { return bufferSize; }
         u32 GetUsedLength() const { return dataOffset; }
+        GLTypeID GetIndexType() const { return indexType; }
+        u32 IndexSize() const { return indexType->typeSize; }
+        bool IsShort() const { return indexType == GLTypeID::USHORT; }
 
         friend class GraphicsDevice;
     };
@@ -0,0 +1,174 @@
+#include "ProgramCache.h"
+
+#include <cstring>
+#include <filesystem>
+#include <glp.h>
+
+#include "Utils/CStr.h"
+#include "Utils/Text.h"
+#include "GLDebug.h"
+
+namespace Quasi::Graphics {
+    namespace {
+        constexpr char MAGIC[4] = { 'Q', 'P', 'R', 'G' };
+        // magic, version, key, format, length
+        constexpr usize HEADER_SIZE = 4 + 4 + 8 + 4 + 4;
+
+        // fnv-1a, the length goes in first so moving text between stages changes the key
+        u64 HashInto(u64 hash, Str text) {
+            const u64 length = text.Length();
+            for (usize i = 0; i < sizeof(length); ++i) {
+                hash ^= (byte)(length >> (8 * i));
+                hash *= 0x100000001B3;
+            }
+            for (const char c : text) {
+                hash ^= (byte)c;
+                hash *= 0x100000001B3;
+            }
+            return hash;
+        }
+
+        template <class T>
+        void Append(String& out, const T& x) {
+            out += Str::Slice((const char*)&x, sizeof(T));
+        }
+
+        template <class T>
+        T Read(Str file, usize offset) {
+            T x;
+            std::memcpy(&x, file.Data() + offset, sizeof(T));
+            return x;
+        }
+    }
+
+    bool ProgramCache::Enable(Str dir) {
+        int formats = 0;
+        QGLCall$(GL::GetIntegerv(GL::NUM_PROGRAM_BINARY_FORMATS, &formats));
+        if (formats <= 0) {
+            GLLogger().QInfo$("driver has no program binary formats, shaders are compiled from source");
+            return false;
+        }
+
+        String driver;
+        for (const u32 name : { GL::VENDOR, GL::RENDERER, GL::VERSION }) {
+            const char* s = (const char*)QGLCall$(GL::GetString(name));
+            driver += Str::Slice(s, std::strlen(s));
+            driver += '|';
+        }
+        EnableWith(dir, driver);
+        return true;
+    }
+
+    void ProgramCache::EnableWith(Str dir, Str driver) {
+        std::error_code err;
+        std::filesystem::create_directories(std::string_view { dir.Data(), dir.Length() }, err);
+        GLLogger().Assert(!err, "couldn't create the shader cache directory '{}'", dir);
+
+        enabled = true;
+        directory = String { dir };
+        driverHash = HashInto(0xCBF29CE484222325, driver);
+    }
+
+    u64 ProgramCache::KeyOf(Str vert, Str frag, Str geom) const {
+        u64 key = driverHash;
+        key = HashInto(key, vert);
+        key = HashInto(key, frag);
+        key = HashInto(key, geom);
+        return key;
+    }
+
+    String ProgramCache::PathOf(u64 key) const {
+        String path = directory;
+        if (!path.IsEmpty() && !Str { path }.EndsWith("/"_str) && !Str { path }.EndsWith("\\"_str)) path += '/';
+        for (int shift = 60; shift >= 0; shift -= 4)
+            path += "0123456789abcdef"[(key >> shift) & 0xF];
+        path += ".glbin"_str;
+        return path;
+    }
+
+    String ProgramCache::Encode(u64 key, const Binary& binary) {
+        String out = String::WithCap(HEADER_SIZE + binary.data.Length());
+        out += Str::Slice(MAGIC, sizeof(MAGIC));
+        Append(out, FILE_VERSION);
+        Append(out, key);
+        Append(out, binary.format);
+        Append(out, (u32)binary.data.Length());
+        out += Str { binary.data };
+        return out;
+    }
+
+    Option<ProgramCache::Binary> ProgramCache::Decode(Str file, u64 key) {
+        if (file.Length() < HEADER_SIZE || std::memcmp(file.Data(), MAGIC, sizeof(MAGIC)) != 0)
+            return nullptr;
+        if (Read<u32>(file, 4) != FILE_VERSION || Read<u64>(file, 8) != key)
+            return nullptr;
+        const u32 length = Read<u32>(file, 20);
+        if (file.Length() - HEADER_SIZE != length)
+            return nullptr;
+        return Options::Some(Binary {
+            .format = Read<u32>(file, 16),
+            .data = String { file.Substr(HEADER_SIZE, length) },
+        });
+    }
+
+    Option<ProgramCache::Binary> ProgramCache::Load(u64 key) const {
+        if (!enabled) return nullptr;
+        String path = PathOf(key);
+        path += '\0';
+        const Option<String> file = Text::ReadFileBinary(CStr::SliceUnchecked(path.Data(), path.Length() - 1));
+        if (!file) return nullptr;
+        return Decode(file.Unwrap(), key);
+    }
+
+    bool ProgramCache::Store(u64 key, const Binary& binary) {
+        if (!enabled) return false;
+        String path = PathOf(key);
+        path += '\0';
+        if (!Text::WriteFileBinary(CStr::SliceUnchecked(path.Data(), path.Length() - 1), Encode(key, binary)))
+            return false;
+        ++stats.stores;
+        return true;
+    }
+
+    void ProgramCache::PrepareForBinary(GraphicsID program) const {
+        if (!enabled) return;
+        QGLCall$(GL::ProgramParameteri(program, GL::PROGRAM_BINARY_RETRIEVABLE_HINT, 1));
+    }
+
+    GraphicsID ProgramCache::LoadProgram(u64 key) {
+        const Option<Binary> binary = Load(key);
+        if (!binary) {
+            ++stats.misses;
+            return 0;
+        }
+
+        // not through QGLCall$, a binary from an older driver is expected to fail here
+        const GraphicsID program = GL::CreateProgram();
+        GL::ProgramBinary(program, binary->format, binary->data.Data(), (int)binary->data.Length());
+        GLClearErr();
+
+        int linked = 0;
+        GL::GetProgramiv(program, GL::LINK_STATUS, &linked);
+        if (!linked) {
+            QGLCall$(GL::DeleteProgram(program));
+            ++stats.rejected;
+            return 0;
+        }
+        ++stats.hits;
+        return program;
+    }
+
+    void ProgramCache::StoreProgram(u64 key, GraphicsID program) {
+        if (!enabled || !program) return;
+        int length = 0;
+        QGLCall$(GL::GetProgramiv(program, GL::PROGRAM_BINARY_LENGTH, &length));
+        if (length <= 0) return;
+
+        // ownership is transfered to the string
+        char* raw = (char*)Memory::AllocateRaw(length);
+        int written = 0;
+        u32 format = 0;
+        QGLCall$(GL::GetProgramBinary(program, length, &written, &format, raw));
+        Store(key, { .format = format, .data = String::Compose(raw, written, length) });
+    }
+}
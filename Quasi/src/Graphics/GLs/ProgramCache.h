@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Utils/Option.h"
+#include "Utils/String.h"
+#include "GLObject.h"
+
+namespace Quasi::Graphics {
+    // keeps linked program binaries on disk, so a shader that was built once is
+    // loaded with glProgramBinary instead of being compiled from source again.
+    // entries are keyed by the sources and the driver, so a driver update makes
+    // the old ones miss instead of failing. Encode, Decode, Load and Store never
+    // touch gl, only LoadProgram and StoreProgram do. the graphics device owns one
+    class ProgramCache {
+    public:
+        struct Binary {
+            u32 format = 0;
+            String data;
+        };
+        struct Stats {
+            u32 hits = 0, misses = 0, rejected = 0, stores = 0;
+        };
+        static constexpr u32 FILE_VERSION = 1;
+    private:
+        bool enabled = false;
+        String directory;
+        u64 driverHash = 0;
+        Stats stats;
+    public:
+        ProgramCache() = default;
+
+        // needs a context, without binary support from the driver it stays off and
+        // every shader is compiled from source like before
+        bool Enable(Str dir);
+        void Disable() { enabled = false; }
+        bool IsEnabled() const { return enabled; }
+        // for running without a context, the driver part of every key is taken from here
+        void EnableWith(Str dir, Str driver);
+
+        u64 KeyOf(Str vert, Str frag, Str geom) const;
+        String PathOf(u64 key) const;
+
+        static String Encode(u64 key, const Binary& binary);
+        // none if the file is truncated, from another version or for another key
+        static Option<Binary> Decode(Str file, u64 key);
+        Option<Binary> Load(u64 key) const;
+        bool Store(u64 key, const Binary& binary);
+
+        // set before linking, some drivers only keep the binary around if asked to
+        void PrepareForBinary(GraphicsID program) const;
+        // 0 if there is no entry or the driver refused it, the caller compiles instead
+        GraphicsID LoadProgram(u64 key);
+        void StoreProgram(u64 key, GraphicsID program);
+
+        const Stats& GetStats() const { return stats; }
+        void ResetStats() { stats = {}; }
+    };
+}
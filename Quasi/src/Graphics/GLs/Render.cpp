@@ -1,20 +1,37 @@
 ﻿#include "Render.h"
 #include <glp.h>
 #include "GLDebug.h"
+#include "GLStateCache.h"
 
 namespace Quasi::Graphics::Render {
     void Draw(const VertexArray& vertexArr, const IndexBuffer& indexBuff, const Shader& shader) {
         vertexArr.Bind();
         indexBuff.Bind();
         shader.Bind();
-        QGLCall$(GL::DrawElements(GL::TRIANGLES, (int)indexBuff.GetUsedLength(), GL::UNSIGNED_INT, nullptr));
+        QGLCall$(GL::DrawElements(GL::TRIANGLES, (int)indexBuff.GetUsedLength(), indexBuff.GetIndexType()->glID, nullptr));
     }
 
     void DrawInstanced(const VertexArray& vertexArr, const IndexBuffer& indexBuff, const Shader& shader, int instances) {
         vertexArr.Bind();
         indexBuff.Bind();
         shader.Bind();
-        QGLCall$(GL::DrawElementsInstanced(GL::TRIANGLES, (int)indexBuff.GetUsedLength(), GL::UNSIGNED_INT, nullptr, instances));
+        QGLCall$(GL::DrawElementsInstanced(GL::TRIANGLES, (int)indexBuff.GetUsedLength(), indexBuff.GetIndexType()->glID, nullptr, instances));
+    }
+
+    void Draw(const VertexArray& vertexArr, const IndexBuffer& indexBuff, const Shader& shader, const RenderData::DrawRange& range) {
+        vertexArr.Bind();
+        indexBuff.Bind();
+        shader.Bind();
+        QGLCall$(GL::DrawElementsBaseVertex(GL::TRIANGLES, (int)range.indexCount, indexBuff.GetIndexType()->glID,
+            (void*)(usize)(range.firstIndex * indexBuff.IndexSize()), (int)range.baseVertex));
+    }
+
+    void DrawInstanced(const VertexArray& vertexArr, const IndexBuffer& indexBuff, const Shader& shader, const RenderData::DrawRange& range, int instances) {
+        vertexArr.Bind();
+        indexBuff.Bind();
+        shader.Bind();
+        QGLCall$(GL::DrawElementsInstancedBaseVertex(GL::TRIANGLES, (int)range.indexCount, indexBuff.GetIndexType()->glID,
+            (const void*)(usize)(range.firstIndex * indexBuff.IndexSize()), instances, (int)range.baseVertex));
     }
 
     void Clear(const BufferBit bit) {
@@ -34,11 +51,11 @@ namespace Quasi::Graphics::Render {
     }
 
     void Enable(const Capability cap) {
-        QGLCall$(GL::Enable((int)cap));
+        GLStateCache::SetCapability((u32)cap, true);
     }
 
     void Disable(const Capability cap) {
-        QGLCall$(GL::Disable((int)cap));
+        GLStateCache::SetCapability((u32)cap, false);
     }
 
     void UseDepthFunc(const CmpOperation op) {
@@ -80,4 +97,9 @@ namespace Quasi::Graphics::Render {
     void SetColorWrite(BufferMode mode) {
         QGLCall$(GL::DrawBuffer((int)mode));
     }
+
+    void SetViewport(const Math::iRect2D& viewport) {
+        const Math::iVector2 size = viewport.size();
+        QGLCall$(GL::Viewport(viewport.min.x, viewport.min.y, size.x, size.y));
+    }
 }
@@ -103,14 +103,16 @@ namespace Quasi::Graphics {
 namespace Quasi::Graphics::Render {
     void Draw(const VertexArray& vertexArr, const IndexBuffer& indexBuff, const Shader& shader);
     void DrawInstanced(const VertexArray& vertexArr, const IndexBuffer& indexBuff, const Shader& shader, int instances);
+    void Draw(const VertexArray& vertexArr, const IndexBuffer& indexBuff, const Shader& shader, const RenderData::DrawRange& range);
+    void DrawInstanced(const VertexArray& vertexArr, const IndexBuffer& indexBuff, const Shader& shader, const RenderData::DrawRange& range, int instances);
     inline void Draw(const RenderData& dat, const Shader& s) {
-        Draw(dat.varray, dat.ibo, s);
+        Draw(dat.varray, dat.ibo, s, dat.GetDrawRange());
     }
     inline void Draw(const RenderData& dat) {
         Draw(dat, dat.shader);
     }
     inline void DrawInstanced(const RenderData& dat, const Shader& s, int instances) {
-        DrawInstanced(dat.varray, dat.ibo, s, instances);
+        DrawInstanced(dat.varray, dat.ibo, s, dat.GetDrawRange(), instances);
     }
     inline void DrawInstanced(const RenderData& dat, int instances) {
         DrawInstanced(dat, dat.shader, instances);
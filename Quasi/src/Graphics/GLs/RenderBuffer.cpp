@@ -1,6 +1,7 @@
 #include "RenderBuffer.h"
 #include <glp.h>
 #include "GLDebug.h"
+#include "GLStateCache.h"
 
 namespace Quasi::Graphics {
     RenderBuffer::RenderBuffer(GraphicsID id) : GLObject(id) {}
@@ -19,10 +20,10 @@ namespace Quasi::Graphics {
     }
 
     void RenderBuffer::BindObject(GraphicsID id) {
-        QGLCall$(GL::BindRenderbuffer(GL::RENDERBUFFER, id));
+        GLStateCache::BindRenderbuffer(id);
     }
 
     void RenderBuffer::UnbindObject() {
-        QGLCall$(GL::BindRenderbuffer(GL::RENDERBUFFER, 0));
+        GLStateCache::BindRenderbuffer(0);
     }
 }
@@ -0,0 +1,145 @@
+#include "RenderTargetPool.h"
+
+#include "GLDebug.h"
+#include "Render.h"
+
+namespace Quasi::Graphics {
+    bool RenderTargetDesc::IsDepth() const {
+        switch (format) {
+            case TextureIFormat::DEPTH_32F: case TextureIFormat::DEPTH_32: case TextureIFormat::DEPTH_24:
+            case TextureIFormat::DEPTH_16:  case TextureIFormat::DEPTH:
+            case TextureIFormat::DEPTH_32F_STENCIL_8: case TextureIFormat::DEPTH_24_STENCIL_8:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    bool RenderTargetDesc::HasStencil() const {
+        return format == TextureIFormat::DEPTH_32F_STENCIL_8 || format == TextureIFormat::DEPTH_24_STENCIL_8;
+    }
+
+    TextureLoadParams RenderTargetDesc::LoadParams() const {
+        using enum TextureIFormat;
+        if (IsDepth()) return { .format = TextureFormat::DEPTH, .internalformat = format, .type = GLTypeID::FLOAT };
+
+        switch (format) {
+            case R_8: case R8_SNORM: case R_16: case R16_SNORM:
+                return { .format = TextureFormat::RED,       .internalformat = format };
+            case R_16F: case R_32F:
+                return { .format = TextureFormat::RED,       .internalformat = format, .type = GLTypeID::FLOAT };
+            case RG_8: case RG8_SNORM: case RG_16: case RG16_SNORM:
+                return { .format = TextureFormat::RED_GREEN, .internalformat = format };
+            case RG_16F: case RG_32F:
+                return { .format = TextureFormat::RED_GREEN, .internalformat = format, .type = GLTypeID::FLOAT };
+            case RGB_8: case RGB8_SNORM: case RGB_16: case RGB16_SNORM: case SRGB_8:
+                return { .format = TextureFormat::RGB,       .internalformat = format };
+            case RGB_16F: case RGB_32F: case RGB_11_11_10F: case RGB_9E5:
+                return { .format = TextureFormat::RGB,       .internalformat = format, .type = GLTypeID::FLOAT };
+            case RGBA_16F: case RGBA_32F:
+                return { .format = TextureFormat::RGBA,      .internalformat = format, .type = GLTypeID::FLOAT };
+            default:
+                return { .format = TextureFormat::RGBA,      .internalformat = format };
+        }
+    }
+
+    usize RenderTargetDesc::ByteSize() const {
+        using enum TextureIFormat;
+        usize pixel;
+        switch (format) {
+            case R_8: case R8_SNORM: pixel = 1; break;
+            case R_16: case R16_SNORM: case R_16F: case RG_8: case RG8_SNORM: case DEPTH_16: pixel = 2; break;
+            case RGB_8: case RGB8_SNORM: case SRGB_8: case DEPTH_24: pixel = 3; break;
+            case RGB_16: case RGB16_SNORM: case RGB_16F: pixel = 6; break;
+            case RGB_32F: pixel = 12; break;
+            case RGBA_16: case RGBA16_SNORM: case RGBA_16F: case RG_32F: case DEPTH_32F_STENCIL_8: pixel = 8; break;
+            case RGBA_32F: pixel = 16; break;
+            default: pixel = 4; break;
+        }
+        return pixel * size.x * size.y;
+    }
+
+    u32 RenderTargetPool::Acquire(const RenderTargetDesc& desc) {
+        for (u32 i = 0; i < targets.Length(); ++i) {
+            Target& t = *targets[i];
+            if (t.inUse || t.desc != desc) continue;
+            t.inUse = true;
+            t.lastUsed = frame;
+            ++stats.reuses;
+            return i;
+        }
+
+        Box<Target> t = Box<Target>::Build();
+        t->desc = desc;
+        t->inUse = true;
+        t->lastUsed = frame;
+        if (desc.sampled) {
+            t->texture = Texture::New(nullptr, desc.size, {
+                .load = desc.LoadParams(),
+                .params = {
+                    { TextureParamName::XT_SAMPLE_FILTER, desc.sample },
+                    { TextureParamName::XT_WRAPPING, desc.border },
+                    { TextureParamName::BORDER_COLOR, desc.borderColor.cbegin() },
+                }
+            });
+        } else {
+            t->renderBuffer = RenderBuffer::New(desc.format, desc.size.as<int>());
+        }
+        ++stats.allocations;
+        targets.Push(std::move(t));
+        return targets.Length() - 1;
+    }
+
+    const FrameBuffer& RenderTargetPool::FrameBufferFor(Span<const Attachment> colors, Attachment depth, AttachmentType depthType) {
+        Array<GraphicsID, MAX_COLOR_ATTACHMENTS + 1> key;
+        for (u32 i = 0; i < colors.Length(); ++i) key[i] = colors[i].ID();
+        key[MAX_COLOR_ATTACHMENTS] = depth.ID();
+
+        for (CachedFrameBuffer& cached : frameBuffers) {
+            if (!cached.attachments.AsSpan().Equals(key.AsSpan())) continue;
+            cached.lastUsed = frame;
+            return cached.fbo;
+        }
+
+        CachedFrameBuffer& cached = frameBuffers.Push({ key, FrameBuffer::New(), frame });
+        cached.fbo.Bind();
+        for (u32 i = 0; i < colors.Length(); ++i) {
+            const AttachmentType type = (AttachmentType)((int)AttachmentType::COLOR_0 + i);
+            if (colors[i].texture) cached.fbo.Attach(*colors[i].texture, type);
+            else                   cached.fbo.Attach(*colors[i].renderBuffer, type);
+        }
+        if (depth.texture)           cached.fbo.Attach(*depth.texture, depthType);
+        else if (depth.renderBuffer) cached.fbo.Attach(*depth.renderBuffer, depthType);
+        cached.fbo.DrawTo(colors.Length());
+        cached.fbo.Complete();
+        cached.fbo.Unbind();
+        return cached.fbo;
+    }
+
+    void RenderTargetPool::EndFrame() {
+        for (usize i = targets.Length(); i --> 0;) {
+            const Target& t = *targets[i];
+            if (t.inUse || frame - t.lastUsed < MAX_IDLE_FRAMES) continue;
+            // a framebuffer cant outlive what its attached to, the id could be handed out again
+            const GraphicsID id = t.ID();
+            for (usize f = frameBuffers.Length(); f --> 0;)
+                if (frameBuffers[f].attachments.Contains(id)) frameBuffers.PopUnordered(f);
+            targets.PopUnordered(i);
+            ++stats.evictions;
+        }
+        for (usize f = frameBuffers.Length(); f --> 0;)
+            if (frame - frameBuffers[f].lastUsed >= MAX_IDLE_FRAMES) frameBuffers.PopUnordered(f);
+        ++frame;
+    }
+
+    void RenderTargetPool::Clear() {
+        frameBuffers.Clear();
+        targets.Clear();
+    }
+
+    usize RenderTargetPool::ByteSize() const {
+        usize total = 0;
+        for (const Box<Target>& t : targets) total += t->desc.ByteSize();
+        return total;
+    }
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include "FrameBuffer.h"
+#include "RenderBuffer.h"
+#include "Textures/Texture.h"
+#include "Utils/Array.h"
+
+namespace Quasi::Graphics {
+    struct RenderTargetDesc {
+        Math::uVector2 size;
+        TextureIFormat format = TextureIFormat::RGBA_8;
+        TextureSample sample = TextureSample::LINEAR;
+        TextureBorder border = TextureBorder::CLAMP_TO_EDGE;
+        Math::fVector4 borderColor = 0;
+        // false makes a renderbuffer, for depth and stencil thats only drawn into, never read
+        bool sampled = true;
+
+        bool operator==(const RenderTargetDesc&) const = default;
+
+        bool IsDepth() const;
+        bool HasStencil() const;
+        AttachmentType DepthAttachment() const { return HasStencil() ? AttachmentType::DEPTH_STENCIL : AttachmentType::DEPTH; }
+        // the format and type to make the texture with, normalized and float formats only
+        TextureLoadParams LoadParams() const;
+        usize ByteSize() const;
+    };
+
+    // textures and renderbuffers to draw into, kept between frames and handed out again for the same desc.
+    // a target released in a frame can be acquired again in the same frame, which is what lets
+    // targets that arent alive at the same time share memory. targets not used for MAX_IDLE_FRAMES
+    // are freed, so the ones left behind by a resize dont stay around.
+    // framebuffers are cached by their attachments as well, so nothing is re attached per frame
+    class RenderTargetPool {
+    public:
+        static constexpr u32 MAX_IDLE_FRAMES = 3, MAX_COLOR_ATTACHMENTS = 4;
+
+        struct Target {
+            RenderTargetDesc desc;
+            Texture texture;
+            RenderBuffer renderBuffer;
+            u32 lastUsed = 0;
+            bool inUse = false;
+
+            GraphicsID ID() const { return desc.sampled ? texture.rendererID : renderBuffer.rendererID; }
+        };
+
+        // what to attach, a target or a texture from outside the pool
+        struct Attachment {
+            const Texture* texture = nullptr;
+            const RenderBuffer* renderBuffer = nullptr;
+
+            static Attachment Of(const Target& t) { return t.desc.sampled ? Attachment { &t.texture } : Attachment { nullptr, &t.renderBuffer }; }
+            GraphicsID ID() const { return texture ? texture->rendererID : renderBuffer ? renderBuffer->rendererID : GraphicsNoID; }
+            bool IsNull() const { return ID() == GraphicsNoID; }
+        };
+
+        struct Stats {
+            u32 allocations = 0, reuses = 0, evictions = 0;
+        };
+    private:
+        struct CachedFrameBuffer {
+            Array<GraphicsID, MAX_COLOR_ATTACHMENTS + 1> attachments; // the colors, then depth, 0 if unused
+            FrameBuffer fbo;
+            u32 lastUsed = 0;
+        };
+
+        Vec<Box<Target>> targets; // boxed, texture slots point at the textures
+        Vec<CachedFrameBuffer> frameBuffers;
+        u32 frame = 0;
+        Stats stats;
+    public:
+        RenderTargetPool() = default;
+
+        // an index valid until EndFrame, the target is empty if it was just made
+        u32 Acquire(const RenderTargetDesc& desc);
+        void Release(u32 target) { targets[target]->inUse = false; }
+        const Target& Get(u32 target) const { return *targets[target]; }
+        Target& Get(u32 target) { return *targets[target]; }
+
+        // at most MAX_COLOR_ATTACHMENTS colors, no colors draws only depth
+        const FrameBuffer& FrameBufferFor(Span<const Attachment> colors, Attachment depth, AttachmentType depthType = AttachmentType::DEPTH_STENCIL);
+
+        // frees whatever went unused for too long, indices from Acquire arent valid past this
+        void EndFrame();
+        void Clear();
+
+        u32 TargetCount() const { return targets.Length(); }
+        usize ByteSize() const;
+        const Stats& GetStats() const { return stats; }
+        void ResetStats() { stats = {}; }
+    };
+}
@@ -4,53 +4,156 @@
 #include "Graphics/Utils/Textures/Texture.h"
 #include "Utils/Text.h"
 #include "GLDebug.h"
+#include "GLStateCache.h"
+#include "ProgramCache.h"
+#include "UniformBuffer.h"
+#include "Graphicals/GraphicsDevice.h"
 
 namespace Quasi::Graphics {
-    Shader::Shader(GraphicsID id) : GLObject(id) {}
+    Shader::Shader(GraphicsID id) : GLObject(id) {
+        Reflect();
+    }
 
     Shader Shader::New(Str program) {
         const ShaderProgramSource shadersrc = ParseShader(program);
-        const GraphicsID rendererID = CreateShader(
+        return BeginCreate(
             shadersrc.GetShader(ShaderType::VERTEX),
             shadersrc.GetShader(ShaderType::FRAGMENT),
             shadersrc.GetShader(ShaderType::GEOMETRY)
-        );
-        return Shader { rendererID };
+        ).Finish();
     }
 
     Shader Shader::New(Str vert, Str frag, Str geom) {
-        const GraphicsID rendererID = CreateShader(vert, frag, geom);
-        return Shader { rendererID };
+        return BeginCreate(vert, frag, geom).Finish();
     }
 
     void Shader::DestroyObject(GraphicsID id) {
         QGLCall$(GL::DeleteProgram(id));
+        GLStateCache::ForgetProgram(id);
     }
 
     void Shader::BindObject(GraphicsID id) {
-        QGLCall$(GL::UseProgram(id));
+        GLStateCache::UseProgram(id);
     }
 
     void Shader::UnbindObject() {
-        QGLCall$(GL::UseProgram(0));
+        GLStateCache::UseProgram(0);
     }
 
     int Shader::GetUniformLocation(Str name) {
-        const auto it = uniformCache.find(name);
-        if (it != uniformCache.end())
-            return it->second;
-
-        const int location = QGLCall$(GL::GetUniformLocation(rendererID, name.Data()));
-        GLLogger().Assert(location != -1, "invalid uniform location for '{}'", name);
-        uniformCache[String { name }] = location;
+        name = ShaderReflection::Unterminated(name);
+        if (const auto u = reflection.FindUniform(name))
+            return u->location;
+        // the driver only lists arrays by their first element, so "arr[3]" or
+        // "lights[1].color" have to be asked for once. anything else was optimized out
+        if (!rendererID || !name.Contains('[')) return -1;
+
+        char* cname = Memory::QAlloca$(char, name.Length() + 1);
+        Memory::MemCopyNoOverlap(cname, name.Data(), name.Length());
+        cname[name.Length()] = '\0';
+        const int location = QGLCall$(GL::GetUniformLocation(rendererID, cname));
+        reflection.AddUniform({
+            .nameHash = ShaderReflection::HashName(name),
+            .name = String { name },
+            .location = location,
+            .glType = 0,
+            .arraySize = 1,
+            .blockIndex = -1,
+        });
         return location;
     }
 
+    bool Shader::BindUniformBlock(Str blockName, u32 bindingPoint) {
+        const auto block = reflection.FindBlock(blockName);
+        if (!block) return false;
+        if (block->binding != bindingPoint) {
+            QGLCall$(GL::UniformBlockBinding(rendererID, block->index, bindingPoint));
+            reflection.SetBlockBinding(block->index, bindingPoint);
+        }
+        return true;
+    }
+
+    void Shader::Reflect() {
+        reflection = ShaderReflection::Reflect(rendererID);
+        usesCameraBlock = BindUniformBlock(CameraBlock::BLOCK_NAME, UniformBindings::CAMERA);
+        if (usesCameraBlock) {
+            const u32 size = reflection.FindBlock(CameraBlock::BLOCK_NAME)->dataSize;
+            GLLogger().Assert(size == CameraBlock::Std140Size(),
+                "camera block is {} bytes in the shader but {} in CameraBlock", size, CameraBlock::Std140Size());
+        }
+    }
+
+    namespace {
+        // the ShaderUniformType a gl type is set with, 0 for the types that dont care (bools)
+        u32 ExpectedUniformType(u32 glType) {
+            using enum ShaderUniformType;
+            switch (glType) {
+                case GL::FLOAT:             return UNIF_1F;
+                case GL::FLOAT_VEC2:        return UNIF_2F;
+                case GL::FLOAT_VEC3:        return UNIF_3F;
+                case GL::FLOAT_VEC4:        return UNIF_4F;
+                case GL::INT:               return UNIF_1I;
+                case GL::INT_VEC2:          return UNIF_2I;
+                case GL::INT_VEC3:          return UNIF_3I;
+                case GL::INT_VEC4:          return UNIF_4I;
+                case GL::UNSIGNED_INT:      return UNIF_1UI;
+                case GL::UNSIGNED_INT_VEC2: return UNIF_2UI;
+                case GL::UNSIGNED_INT_VEC3: return UNIF_3UI;
+                case GL::UNSIGNED_INT_VEC4: return UNIF_4UI;
+                case GL::FLOAT_MAT2:        return UNIF_MAT2x2;
+                case GL::FLOAT_MAT3:        return UNIF_MAT3x3;
+                case GL::FLOAT_MAT4:        return UNIF_MAT4x4;
+                case GL::FLOAT_MAT2x3:      return UNIF_MAT2x3;
+                case GL::FLOAT_MAT2x4:      return UNIF_MAT2x4;
+                case GL::FLOAT_MAT3x2:      return UNIF_MAT3x2;
+                case GL::FLOAT_MAT3x4:      return UNIF_MAT3x4;
+                case GL::FLOAT_MAT4x2:      return UNIF_MAT4x2;
+                case GL::FLOAT_MAT4x3:      return UNIF_MAT4x3;
+                case GL::SAMPLER_1D: case GL::SAMPLER_2D: case GL::SAMPLER_3D:
+                case GL::SAMPLER_CUBE: case GL::SAMPLER_2D_SHADOW:
+                                            return UNIF_1I;
+                default:                    return 0;
+            }
+        }
+    }
+
+    void Shader::ValidateUniform(int loc, const ShaderValueVariant& value) {
+        using enum ShaderUniformType;
+        const auto u = reflection.FindUniformAt(loc);
+        if (!u) return;
+        const u32 expected = ExpectedUniformType(u->glType);
+        if (!expected) return;
+
+        // matrices always go through the array path, so only the shape and scalar type matter
+        const u32 shape = ROWS_MASK | COLS_MASK | TYPE_MASK;
+        const u32 elemSize = ((value.type & ROWS_MASK) / VECTOR_FLAG) * ((value.type & COLS_MASK) / SINGLE_FLAG);
+        const bool typeOk  = (value.type & shape) == (expected & shape);
+        const bool countOk = !elemSize || value.size / elemSize <= (u32)u->arraySize;
+        if (typeOk && countOk) return;
+
+        for (const int r : reportedMismatches) if (r == loc) return;
+        reportedMismatches.Push(loc);
+        if (!typeOk)
+            GLLogger().Warn("uniform '{}' is a {} in the shader, but was set with a different type", u->name, ShaderReflection::TypeName(u->glType));
+        else
+            GLLogger().Warn("uniform '{}' holds {} elements, but {} were set", u->name, u->arraySize, value.size / elemSize);
+    }
+
     void Shader::SetUniformDyn(const ShaderParameter& arg) {
+        SetUniformDynAtLoc(GetUniformLocation(arg.name), arg.value);
+    }
+
+    void Shader::SetUniformDyn(UniformHandle handle, const ShaderValueVariant& value) {
+        if (handle.IsValid()) SetUniformDynAtLoc(handle.location, value);
+    }
+
+    void Shader::SetUniformDynAtLoc(int loc, const ShaderValueVariant& value) {
         using enum ShaderUniformType;
-        const int loc = GetUniformLocation(arg.name);
-        #define SWITCH_STATE(I) case UNIF_##I: SetUniformAtLoc<UNIF_##I>(loc, arg.value.as<ShaderUniformArgOf<UNIF_##I>>()); break;
-        switch (arg.value.type) {
+#ifndef NDEBUG
+        ValidateUniform(loc, value);
+#endif
+        #define SWITCH_STATE(I) case UNIF_##I: SetUniformAtLoc<UNIF_##I>(loc, value.as<ShaderUniformArgOf<UNIF_##I>>()); break;
+        switch (value.type) {
             SWITCH_STATE(1I)      SWITCH_STATE(2I)      SWITCH_STATE(3I)      SWITCH_STATE(4I)
             SWITCH_STATE(1UI)     SWITCH_STATE(2UI)     SWITCH_STATE(3UI)     SWITCH_STATE(4UI)
             SWITCH_STATE(1F)      SWITCH_STATE(2F)      SWITCH_STATE(3F)      SWITCH_STATE(4F)
@@ -68,6 +171,13 @@ namespace Quasi::Graphics {
         for (const auto arg : args) {
             SetUniformDyn(arg);
         }
+        SetUniformArgs(args.bound);
+    }
+
+    void Shader::SetUniformArgs(Span<const BoundUniform> args) {
+        for (const BoundUniform& arg : args) {
+            SetUniformDyn(arg.handle, arg.value);
+        }
     }
 
     ShaderProgramSource Shader::ParseShader(Str program) {
@@ -97,8 +207,8 @@ namespace Quasi::Graphics {
 
         String concatedProgram = String::WithCap(ssv.width() + ssf.width() + ssg.width());
         concatedProgram += program.Substr(ssv.min, ssv.width());
-        concatedProgram += program.Substr(ssv.min, ssv.width());
-        concatedProgram += program.Substr(ssv.min, ssv.width());
+        concatedProgram += program.Substr(ssf.min, ssf.width());
+        concatedProgram += program.Substr(ssg.min, ssg.width());
 
         return {
             concatedProgram,
@@ -116,20 +226,16 @@ namespace Quasi::Graphics {
     }
 
     Shader Shader::FromFile(CStr filepath) {
-        Shader s {};
         const ShaderProgramSource shadersrc = ParseFromFile(filepath);
-        s.rendererID = CreateShader(shadersrc.GetShader(ShaderType::VERTEX), shadersrc.GetShader(ShaderType::FRAGMENT), shadersrc.GetShader(ShaderType::GEOMETRY));
-        return s;
+        return BeginCreate(shadersrc.GetShader(ShaderType::VERTEX), shadersrc.GetShader(ShaderType::FRAGMENT), shadersrc.GetShader(ShaderType::GEOMETRY)).Finish();
     }
 
     Shader Shader::FromFile(CStr vert, CStr frag, CStr geom) {
-        Shader s {};
-        s.rendererID = CreateShader(
+        return BeginCreate(
             Text::ReadFile(vert).Assert(),
             Text::ReadFile(frag).Assert(),
             geom.IsEmpty() ? "" : Text::ReadFile(geom).Assert()
-        );
-        return s;
+        ).Finish();
     }
 
     GraphicsID Shader::CompileShader(Str source, ShaderType type) {
@@ -138,7 +244,10 @@ namespace Quasi::Graphics {
         const int length = (int)source.Length();
         GL::ShaderSource(id, 1, &src, &length);
         GL::CompileShader(id);
+        return id;
+    }
 
+    bool Shader::CheckCompiled(GraphicsID id, ShaderType type) {
         int result;
         GL::GetShaderiv(id, GL::COMPILE_STATUS, &result);
     
@@ -148,32 +257,110 @@ namespace Quasi::Graphics {
             char* errbuf = Memory::QAlloca$(char, len);
             GL::GetShaderInfoLog(id, len, &len, errbuf);
             GLLogger().Error("Compiling {} shader yielded compiler errors:\n{}", type->shaderName, errbuf);
+            return false;
+        }
+        return true;
+    }
 
-            GL::DeleteShader(id);
-            return 0;
+    bool Shader::CompilesInParallel() {
+        static const bool supported = [] {
+            const bool khr = GL::Supports("GL_KHR_parallel_shader_compile");
+            // 0xFFFFFFFF lets the driver pick how many threads to use
+            if (khr) QGLCall$(GL::MaxShaderCompilerThreadsKHR(0xFFFFFFFF));
+            return khr;
+        } ();
+        return supported;
+    }
+
+    PendingShader Shader::BeginCreate(Str vtx, Str frg, Str geo) {
+        const OptRef<ProgramCache> cache = GraphicsDevice::HasInstance() ? OptRef { GraphicsDevice::GetDeviceInstance().GetProgramCache() } : nullptr;
+        return BeginCreate(cache, vtx, frg, geo);
+    }
+
+    PendingShader Shader::BeginCreate(OptRef<ProgramCache> cache, Str vtx, Str frg, Str geo) {
+        PendingShader pending;
+        if (cache && cache->IsEnabled()) {
+            pending.cache = cache;
+            pending.cacheKey = cache->KeyOf(vtx, frg, geo);
+            pending.program = cache->LoadProgram(pending.cacheKey);
+            pending.fromCache = pending.program;
+            if (pending.fromCache) return pending;
         }
 
-        return id;
+        CompilesInParallel();
+        pending.program = GL::CreateProgram();
+        pending.stages[0] = CompileShaderVert(vtx);
+        pending.stages[1] = CompileShaderFrag(frg);
+        pending.stages[2] = geo.IsEmpty() ? 0 : CompileShaderGeom(geo);
+
+        for (const GraphicsID stage : pending.stages)
+            if (stage) QGLCall$(GL::AttachShader(pending.program, stage));
+
+        if (pending.cache) pending.cache->PrepareForBinary(pending.program);
+        QGLCall$(GL::LinkProgram(pending.program));
+        return pending;
     }
 
-    GraphicsID Shader::CreateShader(Str vtx, Str frg, Str geo) {
-        const GraphicsID program = GL::CreateProgram();
-        const GraphicsID vs = CompileShaderVert(vtx);
-        const GraphicsID fs = CompileShaderFrag(frg);
-        const GraphicsID gm = geo.IsEmpty() ? 0 : CompileShaderGeom(geo);
+    PendingShader& PendingShader::operator=(PendingShader&& p) noexcept {
+        Discard();
+        program = p.program;
+        for (u32 i = 0; i < 3; ++i) stages[i] = p.stages[i];
+        cache = p.cache;
+        cacheKey = p.cacheKey;
+        fromCache = p.fromCache;
+        p.program = 0;
+        for (GraphicsID& s : p.stages) s = 0;
+        return *this;
+    }
 
-                QGLCall$(GL::AttachShader(program, vs));
-                QGLCall$(GL::AttachShader(program, fs));
-        if (gm) QGLCall$(GL::AttachShader(program, gm));
+    bool PendingShader::IsReady() const {
+        if (!program || fromCache || !Shader::CompilesInParallel()) return true;
+        int done = 0;
+        QGLCall$(GL::GetProgramiv(program, GL::COMPLETION_STATUS_KHR, &done));
+        return done;
+    }
 
-        QGLCall$(GL::LinkProgram(program));
-        QGLCall$(GL::ValidateProgram(program));
-        
-                QGLCall$(GL::DeleteShader(vs));
-                QGLCall$(GL::DeleteShader(fs));
-        if (gm) QGLCall$(GL::DeleteShader(fs));
+    Shader PendingShader::Finish() {
+        const GraphicsID id = program;
+        program = 0;
+        if (!id) return {};
+        if (fromCache) return Shader { id };
+
+        const ShaderType STAGE_TYPES[3] = { ShaderType::VERTEX, ShaderType::FRAGMENT, ShaderType::GEOMETRY };
+        bool compiled = true;
+        for (u32 i = 0; i < 3; ++i) {
+            if (!stages[i]) continue;
+            compiled &= Shader::CheckCompiled(stages[i], STAGE_TYPES[i]);
+            QGLCall$(GL::DeleteShader(stages[i]));
+            stages[i] = 0;
+        }
 
-        return program;
+        int linked = 0;
+        QGLCall$(GL::GetProgramiv(id, GL::LINK_STATUS, &linked));
+        if (compiled && !linked) {
+            int len;
+            GL::GetProgramiv(id, GL::INFO_LOG_LENGTH, &len);
+            char* errbuf = Memory::QAlloca$(char, len + 1);
+            GL::GetProgramInfoLog(id, len + 1, &len, errbuf);
+            GLLogger().Error("Linking shader program yielded errors:\n{}", errbuf);
+        }
+        if (!compiled || !linked) {
+            QGLCall$(GL::DeleteProgram(id));
+            return {};
+        }
+
+        QGLCall$(GL::ValidateProgram(id));
+        if (cache) cache->StoreProgram(cacheKey, id);
+        return Shader { id };
+    }
+
+    void PendingShader::Discard() {
+        for (GraphicsID& s : stages) {
+            if (s) QGLCall$(GL::DeleteShader(s));
+            s = 0;
+        }
+        if (program) QGLCall$(GL::DeleteProgram(program));
+        program = 0;
     }
 
     ShaderArgs::ShaderArgs(IList<ShaderParameter> p) : params(Vec<ShaderValueVariant>::WithCap(p.size())) {
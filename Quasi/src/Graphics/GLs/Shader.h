@@ -7,7 +7,9 @@
 #include "Utils/String.h"
 #include "Utils/StringList.h"
 #include "Utils/CStr.h"
+#include "Debug/Logger.h"
 #include "GLObject.h"
+#include "ShaderReflection.h"
 #include "Math/Matrix.h"
 #include "Math/Color.h"
 
@@ -143,9 +145,24 @@ namespace Quasi::Graphics {
     struct ShaderArgs;
     struct ShaderValueVariant;
     struct ShaderParameter;
+    struct BoundUniform;
+    class PendingShader;
+    class ProgramCache;
+
+    // a uniform location looked up once through Shader::Uniform,
+    // setting through it skips the name lookup entirely
+    struct UniformHandle {
+        int location = -1;
+
+        bool IsValid() const { return location >= 0; }
+    };
 
     class Shader : public GLObject<Shader> {
-        Map<String, int, std::less<>> uniformCache;
+        ShaderReflection reflection;
+        bool usesCameraBlock = false;
+#ifndef NDEBUG
+        Vec<int> reportedMismatches; // so a bad uniform only warns once, not every frame
+#endif
 
         explicit Shader(GraphicsID id);
     public:
@@ -181,11 +198,23 @@ namespace Quasi::Graphics {
 
         UNIF_INSTANTIATE
 
+        // resolve these when the shader is loaded, not every frame
+        UniformHandle Uniform(Str name) { return { GetUniformLocation(name) }; }
+
         void SetUniformDyn(const ShaderParameter& arg);
+        void SetUniformDyn(UniformHandle handle, const ShaderValueVariant& value);
         void SetUniformArgs(const ShaderArgs& args);
+        void SetUniformArgs(Span<const BoundUniform> args);
 
         void SetUniformTex(Str name, const class Texture& texture);
 
+        // assigns a uniform block to a binding point, false if the shader has no such block
+        bool BindUniformBlock(Str blockName, u32 bindingPoint);
+        // if set, u_projection and u_view come from the shared camera ubo instead of plain uniforms
+        bool UsesCameraBlock() const { return usesCameraBlock; }
+        // everything gl reported about the program when it was linked
+        const ShaderReflection& Reflection() const { return reflection; }
+
         template <class N>
         void SetUniform(Str name, N num) {
             using enum ShaderUniformType;
@@ -236,8 +265,7 @@ namespace Quasi::Graphics {
                     layout(location = 0) in vec4 position;
                     layout(location = 1) in vec4 color;
                     out vec4 v_color;
-                    uniform mat4 u_projection;
-                    uniform mat4 u_view;
+                    layout(std140) uniform Camera { mat4 u_projection; mat4 u_view; };
                     void main() {
                         gl_Position = u_projection * u_view * position;
                         v_color = color;
@@ -260,8 +288,7 @@ namespace Quasi::Graphics {
                     layout(location = 2) in vec2 texCoord;
                     out vec2 v_TexCoord;
                     out vec4 v_color;
-                    uniform mat4 u_projection;
-                    uniform mat4 u_view;
+                    layout(std140) uniform Camera { mat4 u_projection; mat4 u_view; };
                     void main() {
                         gl_Position = u_projection * u_view * position;
                         v_color = color;
@@ -284,17 +311,54 @@ namespace Quasi::Graphics {
         static Shader FromFile(CStr filepath);
         static Shader FromFile(CStr vert, CStr frag, CStr geom = {});
 
+        // hands the sources to the driver without waiting for them to compile.
+        // without a cache, the one of the graphics device is used if there is a device
+        static PendingShader BeginCreate(Str vtx, Str frg, Str geo = {});
+        static PendingShader BeginCreate(OptRef<ProgramCache> cache, Str vtx, Str frg, Str geo = {});
+        // true if the driver compiles in the background (KHR_parallel_shader_compile)
+        static bool CompilesInParallel();
+
+        static ShaderProgramSource ParseShader  (Str program);
     private:
         int GetUniformLocation(Str name);
-        static ShaderProgramSource ParseShader  (Str program);
+        void SetUniformDynAtLoc(int loc, const ShaderValueVariant& value);
+        void ValidateUniform(int loc, const ShaderValueVariant& value);
+        void Reflect();
         static ShaderProgramSource ParseFromFile(CStr filepath);
         static GraphicsID CompileShader    (Str source, ShaderType type);
         static GraphicsID CompileShaderVert(Str source) { return CompileShader(source, ShaderType::VERTEX); }
         static GraphicsID CompileShaderFrag(Str source) { return CompileShader(source, ShaderType::FRAGMENT); }
         static GraphicsID CompileShaderGeom(Str source) { return CompileShader(source, ShaderType::GEOMETRY); }
-        static GraphicsID CreateShader(Str vtx, Str frg, Str geo = {});
+        static bool CheckCompiled(GraphicsID id, ShaderType type);
 
         friend class GraphicsDevice;
+        friend class PendingShader;
+    };
+
+    // a program that was submitted but whose compile and link status was never asked for,
+    // asking is what blocks. with parallel compiling IsReady can be polled every frame
+    // and Finish only waits once the driver is already done
+    class PendingShader {
+        GraphicsID program = 0;
+        GraphicsID stages[3] {}; // vertex, fragment, geometry
+        OptRef<ProgramCache> cache;
+        u64 cacheKey = 0;
+        bool fromCache = false;
+
+        friend class Shader;
+    public:
+        PendingShader() = default;
+        PendingShader(const PendingShader&) = delete;
+        PendingShader& operator=(const PendingShader&) = delete;
+        PendingShader(PendingShader&& p) noexcept { *this = std::move(p); }
+        PendingShader& operator=(PendingShader&& p) noexcept;
+        ~PendingShader() { Discard(); }
+
+        bool IsNull() const { return !program; }
+        bool IsReady() const;
+        // logs the compile errors and returns a null shader if it failed
+        Shader Finish();
+        void Discard();
     };
 
 #undef DEFINE_UNIF_FN
@@ -388,14 +452,21 @@ namespace Quasi::Graphics {
         }
     };
 
+    struct BoundUniform {
+        UniformHandle handle;
+        ShaderValueVariant value = 0;
+    };
+
     struct ShaderArgs {
         StringList args;
         Vec<ShaderValueVariant> params;
+        Span<const BoundUniform> bound; // not owned, usually points into a FixedShaderArgs
 
         ShaderArgs() {}
         ShaderArgs(IList<ShaderParameter> p);
+        ShaderArgs(Span<const BoundUniform> b) : bound(b) {}
 
-        usize size() const { return params.Length(); }
+        usize size() const { return params.Length() + bound.Length(); }
 
         ShaderArgs& then(Str name, ShaderValueVariant val) {
             args.Push(name);
@@ -428,4 +499,22 @@ namespace Quasi::Graphics {
     };
 
     inline ShaderArgs::Iter ShaderArgs::begin() const { return { .valIt = params.begin(), .argIt = args.begin() }; }
+
+    // fixed capacity argument list set by handle. lives on the stack, so building
+    // one every frame never allocates. converts to a ShaderArgs that borrows it
+    template <usize N>
+    struct FixedShaderArgs {
+        BoundUniform items[N];
+        u32 count = 0;
+
+        FixedShaderArgs& then(UniformHandle handle, ShaderValueVariant val) {
+            Debug::AssertMsg(count < N, "too many arguments for FixedShaderArgs");
+            items[count++] = { handle, val };
+            return *this;
+        }
+
+        usize size() const { return count; }
+        Span<const BoundUniform> AsSpan() const { return Span<const BoundUniform>::Slice(items, count); }
+        operator ShaderArgs() const { return { AsSpan() }; }
+    };
 }
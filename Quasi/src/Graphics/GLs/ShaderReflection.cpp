@@ -0,0 +1,184 @@
+#include "ShaderReflection.h"
+
+#include <algorithm>
+#include <atomic>
+#include <glp.h>
+
+#include "GLDebug.h"
+
+namespace Quasi::Graphics {
+    namespace {
+        // names come back as "arr[0]" for arrays, the table stores them as "arr"
+        Str TrimArraySuffix(Str name) {
+            return name.EndsWith("[0]"_str) ? name.First(name.Length() - 3) : name;
+        }
+
+        template <class T>
+        void SortByHash(Vec<T>& table) {
+            std::sort(table.Data(), table.Data() + table.Length(), [] (const T& a, const T& b) { return a.nameHash < b.nameHash; });
+        }
+
+        template <class T>
+        OptRef<const T> FindByName(const Vec<T>& table, Str name) {
+            name = ShaderReflection::Unterminated(name);
+            const u64 hash = ShaderReflection::HashName(name);
+            const T* it = std::lower_bound(table.Data(), table.Data() + table.Length(), hash,
+                [] (const T& entry, u64 h) { return entry.nameHash < h; });
+            for (; it != table.Data() + table.Length() && it->nameHash == hash; ++it)
+                if (Str { it->name } == name) return *it;
+            return nullptr;
+        }
+    }
+
+    ShaderReflection ShaderReflection::Reflect(GraphicsID program) {
+        ShaderReflection refl;
+        if (!program) return refl;
+        static std::atomic<u32> nextSerial = 1;
+        refl.serial = nextSerial.fetch_add(1, std::memory_order_relaxed);
+
+        int count = 0, maxLength = 0;
+        QGLCall$(GL::GetProgramiv(program, GL::ACTIVE_UNIFORMS, &count));
+        QGLCall$(GL::GetProgramiv(program, GL::ACTIVE_UNIFORM_MAX_LENGTH, &maxLength));
+        char* nameBuf = Memory::QAlloca$(char, std::max(maxLength, 1));
+        refl.uniforms.Reserve(count);
+        for (int i = 0; i < count; ++i) {
+            int length = 0, size = 0, blockIndex = -1;
+            u32 type = 0;
+            QGLCall$(GL::GetActiveUniform(program, i, std::max(maxLength, 1), &length, &size, &type, nameBuf));
+            const u32 index = i;
+            QGLCall$(GL::GetActiveUniformsiv(program, 1, &index, GL::UNIFORM_BLOCK_INDEX, &blockIndex));
+
+            const Str name = TrimArraySuffix(Str::Slice(nameBuf, length));
+            refl.uniforms.Push({
+                .nameHash = HashName(name),
+                .name = String { name },
+                .location = blockIndex < 0 ? QGLCall$(GL::GetUniformLocation(program, nameBuf)) : -1,
+                .glType = type,
+                .arraySize = size,
+                .blockIndex = blockIndex,
+            });
+        }
+
+        QGLCall$(GL::GetProgramiv(program, GL::ACTIVE_UNIFORM_BLOCKS, &count));
+        QGLCall$(GL::GetProgramiv(program, GL::ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxLength));
+        nameBuf = Memory::QAlloca$(char, std::max(maxLength, 1));
+        refl.blocks.Reserve(count);
+        for (int i = 0; i < count; ++i) {
+            int length = 0, dataSize = 0, binding = 0;
+            QGLCall$(GL::GetActiveUniformBlockName(program, i, std::max(maxLength, 1), &length, nameBuf));
+            QGLCall$(GL::GetActiveUniformBlockiv(program, i, GL::UNIFORM_BLOCK_DATA_SIZE, &dataSize));
+            QGLCall$(GL::GetActiveUniformBlockiv(program, i, GL::UNIFORM_BLOCK_BINDING, &binding));
+
+            const Str name = Str::Slice(nameBuf, length);
+            refl.blocks.Push({
+                .nameHash = HashName(name),
+                .name = String { name },
+                .index = (u32)i,
+                .dataSize = (u32)dataSize,
+                .binding = (u32)binding,
+            });
+        }
+
+        QGLCall$(GL::GetProgramiv(program, GL::ACTIVE_ATTRIBUTES, &count));
+        QGLCall$(GL::GetProgramiv(program, GL::ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxLength));
+        nameBuf = Memory::QAlloca$(char, std::max(maxLength, 1));
+        refl.attributes.Reserve(count);
+        for (int i = 0; i < count; ++i) {
+            int length = 0, size = 0;
+            u32 type = 0;
+            QGLCall$(GL::GetActiveAttrib(program, i, std::max(maxLength, 1), &length, &size, &type, nameBuf));
+
+            const Str name = TrimArraySuffix(Str::Slice(nameBuf, length));
+            refl.attributes.Push({
+                .nameHash = HashName(name),
+                .name = String { name },
+                .location = QGLCall$(GL::GetAttribLocation(program, nameBuf)),
+                .glType = type,
+                .arraySize = size,
+            });
+        }
+
+        SortByHash(refl.uniforms);
+        SortByHash(refl.blocks);
+        SortByHash(refl.attributes);
+        return refl;
+    }
+
+    u64 ShaderReflection::HashName(Str name) {
+        // fnv-1a
+        u64 hash = 0xCBF29CE484222325;
+        for (const char c : Unterminated(name)) {
+            hash ^= (byte)c;
+            hash *= 0x100000001B3;
+        }
+        return hash;
+    }
+
+    OptRef<const ShaderReflection::Uniform> ShaderReflection::FindUniform(Str name) const {
+        return FindByName(uniforms, name);
+    }
+
+    OptRef<const ShaderReflection::Uniform> ShaderReflection::FindUniformAt(int location) const {
+        // only used for validation, the tables are tiny
+        for (const Uniform& u : uniforms)
+            if (u.location == location) return u;
+        return nullptr;
+    }
+
+    OptRef<const ShaderReflection::Block> ShaderReflection::FindBlock(Str name) const {
+        return FindByName(blocks, name);
+    }
+
+    OptRef<const ShaderReflection::Attribute> ShaderReflection::FindAttribute(Str name) const {
+        return FindByName(attributes, name);
+    }
+
+    const ShaderReflection::Uniform& ShaderReflection::AddUniform(Uniform uniform) {
+        const Uniform* at = std::lower_bound(uniforms.Data(), uniforms.Data() + uniforms.Length(), uniform.nameHash,
+            [] (const Uniform& entry, u64 h) { return entry.nameHash < h; });
+        const usize index = at - uniforms.Data();
+        uniforms.Insert(std::move(uniform), index);
+        return uniforms[index];
+    }
+
+    void ShaderReflection::SetBlockBinding(u32 index, u32 binding) {
+        for (Block& b : blocks)
+            if (b.index == index) b.binding = binding;
+    }
+
+    Str ShaderReflection::TypeName(u32 glType) {
+        switch (glType) {
+            case GL::FLOAT:             return "float";
+            case GL::FLOAT_VEC2:        return "vec2";
+            case GL::FLOAT_VEC3:        return "vec3";
+            case GL::FLOAT_VEC4:        return "vec4";
+            case GL::INT:               return "int";
+            case GL::INT_VEC2:          return "ivec2";
+            case GL::INT_VEC3:          return "ivec3";
+            case GL::INT_VEC4:          return "ivec4";
+            case GL::UNSIGNED_INT:      return "uint";
+            case GL::UNSIGNED_INT_VEC2: return "uvec2";
+            case GL::UNSIGNED_INT_VEC3: return "uvec3";
+            case GL::UNSIGNED_INT_VEC4: return "uvec4";
+            case GL::BOOL:              return "bool";
+            case GL::BOOL_VEC2:         return "bvec2";
+            case GL::BOOL_VEC3:         return "bvec3";
+            case GL::BOOL_VEC4:         return "bvec4";
+            case GL::FLOAT_MAT2:        return "mat2";
+            case GL::FLOAT_MAT3:        return "mat3";
+            case GL::FLOAT_MAT4:        return "mat4";
+            case GL::FLOAT_MAT2x3:      return "mat2x3";
+            case GL::FLOAT_MAT2x4:      return "mat2x4";
+            case GL::FLOAT_MAT3x2:      return "mat3x2";
+            case GL::FLOAT_MAT3x4:      return "mat3x4";
+            case GL::FLOAT_MAT4x2:      return "mat4x2";
+            case GL::FLOAT_MAT4x3:      return "mat4x3";
+            case GL::SAMPLER_1D:        return "sampler1D";
+            case GL::SAMPLER_2D:        return "sampler2D";
+            case GL::SAMPLER_3D:        return "sampler3D";
+            case GL::SAMPLER_CUBE:      return "samplerCube";
+            case GL::SAMPLER_2D_SHADOW: return "sampler2DShadow";
+            default:                    return "?";
+        }
+    }
+}
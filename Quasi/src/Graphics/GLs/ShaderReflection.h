@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Utils/Ref.h"
+#include "Utils/String.h"
+#include "Utils/Vec.h"
+#include "GLObject.h"
+
+namespace Quasi::Graphics {
+    // everything the driver reports about a linked program. it is queried once at
+    // link time, so looking a uniform up afterwards never talks to gl.
+    // every table is sorted by the hash of the name
+    struct ShaderReflection {
+        struct Uniform {
+            u64 nameHash;
+            String name;    // arrays are stored without their [0]
+            int location;   // -1 for members of a uniform block
+            u32 glType;
+            int arraySize;
+            int blockIndex; // -1 if not in a block
+        };
+
+        struct Block {
+            u64 nameHash;
+            String name;
+            u32 index;
+            u32 dataSize;
+            u32 binding;
+        };
+
+        struct Attribute {
+            u64 nameHash;
+            String name;
+            int location;
+            u32 glType;
+            int arraySize;
+        };
+
+        Vec<Uniform> uniforms;
+        Vec<Block> blocks;
+        Vec<Attribute> attributes;
+        // new for every program reflected, gl can give a relinked program the name of the old one,
+        // so whatever is cached per program is keyed on this instead. 0 for no program
+        u32 serial = 0;
+
+        static ShaderReflection Reflect(GraphicsID program);
+        static u64 HashName(Str name);
+        // a Str made from a literal counts its terminator, names are compared without it
+        static Str Unterminated(Str name) { return name && name.Last() == '\0' ? name.First(name.Length() - 1) : name; }
+
+        OptRef<const Uniform> FindUniform(Str name) const;
+        OptRef<const Uniform> FindUniformAt(int location) const;
+        OptRef<const Block> FindBlock(Str name) const;
+        OptRef<const Attribute> FindAttribute(Str name) const;
+
+        // for names the driver doesnt list by themselves, like single elements of an array
+        const Uniform& AddUniform(Uniform uniform);
+        void SetBlockBinding(u32 index, u32 binding);
+
+        static Str TypeName(u32 glType);
+    };
+}
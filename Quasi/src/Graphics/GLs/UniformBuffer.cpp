@@ -0,0 +1,55 @@
+#include "UniformBuffer.h"
+
+#include <cstring>
+#include <glp.h>
+
+#include "GLDebug.h"
+#include "GLStateCache.h"
+
+namespace Quasi::Graphics {
+    UniformBuffer::UniformBuffer(GraphicsID id, u32 size) : GLObject(id), lastUpload(ArrayBox<byte>::Allocate(size)) {}
+
+    UniformBuffer UniformBuffer::New(u32 size) {
+        GraphicsID id;
+        QGLCall$(GL::GenBuffers(1, &id));
+        BindObject(id);
+        UniformBuffer ubo { id, size };
+        // starts out zeroed so the copy of the last upload is right from the beginning
+        QGLCall$(GL::BufferData(GL::UNIFORM_BUFFER, size, ubo.lastUpload.Data(), GL::DYNAMIC_DRAW));
+        return ubo;
+    }
+
+    void UniformBuffer::DestroyObject(GraphicsID id) {
+        QGLCall$(GL::DeleteBuffers(1, &id));
+        GLStateCache::ForgetBuffer(id);
+    }
+
+    void UniformBuffer::BindObject(GraphicsID id) {
+        GLStateCache::BindBuffer(GL::UNIFORM_BUFFER, id);
+    }
+
+    void UniformBuffer::UnbindObject() {
+        GLStateCache::BindBuffer(GL::UNIFORM_BUFFER, 0);
+    }
+
+    void UniformBuffer::SetDataBytes(Span<const byte> data, u32 offset) {
+        GLLogger().Assert(offset + data.Length() <= lastUpload.Length(), "uniform buffer write out of range");
+        Bind();
+        QGLCall$(GL::BufferSubData(GL::UNIFORM_BUFFER, offset, data.ByteSize(), data.Data()));
+        Memory::MemCopyNoOverlap(lastUpload.Data() + offset, data.Data(), data.ByteSize());
+        ++uploads;
+    }
+
+    bool UniformBuffer::UpdateDataBytes(Span<const byte> data) {
+        if (std::memcmp(lastUpload.Data(), data.Data(), data.ByteSize()) == 0) {
+            ++skips;
+            return false;
+        }
+        SetDataBytes(data);
+        return true;
+    }
+
+    void UniformBuffer::BindToPoint(u32 point) const {
+        GLStateCache::BindBufferBase(GL::UNIFORM_BUFFER, point, rendererID);
+    }
+}
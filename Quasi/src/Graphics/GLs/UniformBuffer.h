@@ -0,0 +1,175 @@
+#pragma once
+
+#include "Utils/Macros.h"
+#include "Utils/MacroIteration.h"
+#include "Utils/ArrayBox.h"
+#include "Utils/Array.h"
+#include "Utils/Span.h"
+#include "Utils/Str.h"
+#include "GLObject.h"
+#include "Math/Matrix.h"
+#include "Math/Color.h"
+
+// generates the std140 packing for a struct, members are listed in the order they
+// appear in the glsl block: QuasiDefineUniformBlock$(Light, (position)(color)(strength))
+#define Q_GL_DEFINE_UNIFORM_BLOCK(T, MEMBS) \
+    static constexpr bool IS_GL_UNIFORM_BLOCK = true; \
+    using Self = T; \
+    public: \
+    static constexpr usize Std140Size() { \
+        return Quasi::Graphics::Std140::BlockSize<Q_INVOKE(Q_ARGS_SKIP, Q_ITERATE_SEQUENCE(Q_GL_UBLOCK_TYPE_IT, MEMBS))>(); \
+    } \
+    void Std140Pack(byte* _out) const { \
+        Quasi::Graphics::Std140::Pack(_out Q_ITERATE_SEQUENCE(Q_GL_UBLOCK_MEMB_IT, MEMBS)); \
+    }
+
+#define Q_GL_UBLOCK_TYPE_IT(X_) , decltype(Self:: Q_ARGS_FIRST X_)
+#define Q_GL_UBLOCK_MEMB_IT(X_) , Q_ARGS_FIRST X_
+
+#define QuasiDefineUniformBlock$(...) Q_GL_DEFINE_UNIFORM_BLOCK(__VA_ARGS__)
+
+namespace Quasi::Graphics {
+    // fixed binding points, shaders get their blocks assigned to these at link time
+    namespace UniformBindings {
+        constexpr u32 CAMERA = 0, MATERIAL = 1, FIRST_USER = 2;
+    }
+
+    namespace Std140 {
+        constexpr usize AlignUp(usize x, usize align) { return (x + align - 1) / align * align; }
+
+        // ALIGN and SIZE are the base alignment and the size the member takes up in the block
+        template <class T> struct Rule {};
+
+        template <class T> requires (std::is_same_v<T, int> || std::is_same_v<T, uint> || std::is_same_v<T, float>)
+        struct Rule<T> {
+            static constexpr usize ALIGN = 4, SIZE = 4;
+            static void Write(byte* out, const T& x) { Memory::MemCopyNoOverlap(out, &x, 4); }
+        };
+
+        template <> struct Rule<bool> {
+            static constexpr usize ALIGN = 4, SIZE = 4;
+            static void Write(byte* out, bool x) { const u32 b = x; Memory::MemCopyNoOverlap(out, &b, 4); }
+        };
+
+        // vec3 is aligned like a vec4
+        template <u32 N, class T> struct Rule<Math::VectorN<N, T>> {
+            static constexpr usize ALIGN = (N == 3 ? 4 : N) * 4, SIZE = N * 4;
+            static void Write(byte* out, const Math::VectorN<N, T>& v) { Memory::MemCopyNoOverlap(out, &v, SIZE); }
+        };
+
+        template <> struct Rule<Math::fColor> {
+            static constexpr usize ALIGN = 16, SIZE = 16;
+            static void Write(byte* out, const Math::fColor& c) { Memory::MemCopyNoOverlap(out, &c, SIZE); }
+        };
+
+        template <> struct Rule<Math::fColor3> {
+            static constexpr usize ALIGN = 16, SIZE = 12;
+            static void Write(byte* out, const Math::fColor3& c) { Memory::MemCopyNoOverlap(out, &c, SIZE); }
+        };
+
+        // a column major matrix is an array of its columns, and every array element is padded to a vec4
+        template <u32 N, u32 M> struct Rule<Math::Matrix<N, M>> {
+            static constexpr usize ALIGN = 16, SIZE = 16 * M;
+            static void Write(byte* out, const Math::Matrix<N, M>& mat) {
+                const Span<const float> data = mat.data();
+                for (u32 c = 0; c < M; ++c)
+                    Memory::MemCopyNoOverlap(out + 16 * c, data.Data() + N * c, N * sizeof(float));
+            }
+        };
+
+        template <class T, usize K> struct Rule<Array<T, K>> {
+            static constexpr usize STRIDE = AlignUp(Rule<T>::SIZE, 16);
+            static constexpr usize ALIGN = AlignUp(Rule<T>::ALIGN, 16), SIZE = STRIDE * K;
+            static void Write(byte* out, const Array<T, K>& arr) {
+                for (usize i = 0; i < K; ++i) Rule<T>::Write(out + STRIDE * i, arr[i]);
+            }
+        };
+
+        template <class... Ts>
+        constexpr usize BlockSize() {
+            usize end = 0;
+            ((end = AlignUp(end, Rule<Ts>::ALIGN) + Rule<Ts>::SIZE), ...);
+            return AlignUp(end, 16);
+        }
+
+        // the offsets are all constant, so this folds down to a sequence of copies
+        template <class... Ts>
+        void Pack(byte* out, const Ts&... members) {
+            usize offset = 0;
+            ((offset = AlignUp(offset, Rule<Ts>::ALIGN), Rule<Ts>::Write(out + offset, members), offset += Rule<Ts>::SIZE), ...);
+        }
+    }
+
+    template <class T> concept IUniformBlock = requires { T::IS_GL_UNIFORM_BLOCK; };
+
+    class UniformBuffer : public GLObject<UniformBuffer> {
+    private:
+        ArrayBox<byte> lastUpload; // compared against so identical uploads never reach gl
+        u32 uploads = 0, skips = 0;
+
+        explicit UniformBuffer(GraphicsID id, u32 size);
+    public:
+        UniformBuffer() = default;
+        static UniformBuffer New(u32 size);
+        static void DestroyObject(GraphicsID id);
+        static void BindObject(GraphicsID id);
+        static void UnbindObject();
+
+        void SetDataBytes(Span<const byte> data, u32 offset = 0);
+        // returns false if the contents were already the same
+        bool UpdateDataBytes(Span<const byte> data);
+
+        void BindToPoint(u32 point) const;
+
+        u32 GetLength() const { return (u32)lastUpload.Length(); }
+        u32 UploadCount() const { return uploads; }
+        u32 SkipCount() const { return skips; }
+    };
+
+    // a struct mirrored in a ubo. the struct is packed and uploaded on Upload,
+    // and only if it was touched through Set or Mut
+    template <IUniformBlock T>
+    class UniformBlock {
+        static_assert(T::Std140Size() <= 16384, "gl only guarantees 16kb per uniform block");
+
+        UniformBuffer ubo;
+        T value {};
+        u32 bindingPoint = 0;
+        bool dirty = true;
+    public:
+        UniformBlock() = default;
+        static UniformBlock New(u32 bindingPoint, const T& init = {}) {
+            UniformBlock block;
+            block.ubo = UniformBuffer::New((u32)T::Std140Size());
+            block.value = init;
+            block.bindingPoint = bindingPoint;
+            return block;
+        }
+
+        const T& Get() const { return value; }
+        T& Mut() { dirty = true; return value; }
+        void Set(const T& v) { value = v; dirty = true; }
+
+        bool Upload() {
+            if (!dirty) return false;
+            dirty = false;
+            byte packed[T::Std140Size()] {};
+            value.Std140Pack(packed);
+            return ubo.UpdateDataBytes(Span<const byte>::Slice(packed, T::Std140Size()));
+        }
+
+        void Bind() const { ubo.BindToPoint(bindingPoint); }
+        u32 BindingPoint() const { return bindingPoint; }
+        const UniformBuffer& Buffer() const { return ubo; }
+        bool IsNull() const { return ubo.IsNull(); }
+    };
+
+    // the block every standard shader reads its matrices from:
+    //     layout (std140) uniform Camera { mat4 u_projection; mat4 u_view; };
+    struct CameraBlock {
+        Math::Matrix3D projection, view;
+
+        static constexpr Str BLOCK_NAME = "Camera";
+        QuasiDefineUniformBlock$(CameraBlock, (projection)(view));
+    };
+}
@@ -2,6 +2,7 @@
 
 #include <glp.h>
 #include "GLDebug.h"
+#include "GLStateCache.h"
 
 namespace Quasi::Graphics {
     VertexArray::VertexArray(GraphicsID id) : GLObject(id) {}
@@ -14,33 +15,46 @@ namespace Quasi::Graphics {
 
     void VertexArray::DestroyObject(const GraphicsID id) {
         QGLCall$(GL::DeleteVertexArrays(1, &id));
+        GLStateCache::ForgetVertexArray(id);
     }
 
     void VertexArray::BindObject(const GraphicsID id) {
-        QGLCall$(GL::BindVertexArray(id));
+        GLStateCache::BindVertexArray(id);
     }
 
     void VertexArray::UnbindObject() {
-        QGLCall$(GL::BindVertexArray(0));
+        GLStateCache::BindVertexArray(0);
     }
 
-    void VertexArray::AddBuffer(const VertexBufferLayout& layout) {
+    void VertexArray::SetAttributes(const VertexBufferLayout& layout, u32 firstLocation, u32 divisor) {
         const Vec<VertexBufferComponent>& elements = layout.GetComponents();
         usize offset = 0;
         for (u32 i = 0; i < elements.Length(); i++) {
             const auto& elem = elements[i];
-            QGLCall$(GL::EnableVertexAttribArray(i));
+            const u32 loc = firstLocation + i;
+            QGLCall$(GL::EnableVertexAttribArray(loc));
             if (elem.flags & VertexBufferComponent::INTEGER_FLAG)
-                QGLCall$(GL::VertexAttribIPointer(i, elem.count, elem.type->glID, layout.GetStride(), (const void*)offset));
+                QGLCall$(GL::VertexAttribIPointer(loc, elem.count, elem.type->glID, layout.GetStride(), (const void*)offset));
             else
-                QGLCall$(GL::VertexAttribPointer(i, elem.count, elem.type->glID, elem.flags & elem.NORMALIZED_FLAG, layout.GetStride(), (const void*)offset));
+                QGLCall$(GL::VertexAttribPointer(loc, elem.count, elem.type->glID, elem.flags & elem.NORMALIZED_FLAG, layout.GetStride(), (const void*)offset));
+            if (divisor) QGLCall$(GL::VertexAttribDivisor(loc, divisor));
             offset += elem.count * elem.type->typeSize;
         }
     }
 
+    void VertexArray::AddBuffer(const VertexBufferLayout& layout) {
+        SetAttributes(layout, 0, 0);
+    }
+
     void VertexArray::AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout) {
         Bind();
         vb.Bind();
         AddBuffer(layout);
     }
+
+    void VertexArray::AddInstanceBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout, u32 firstLocation, u32 divisor) {
+        Bind();
+        vb.Bind();
+        SetAttributes(layout, firstLocation, divisor);
+    }
 }
@@ -14,6 +14,11 @@ namespace Quasi::Graphics {
 
         void AddBuffer(const VertexBufferLayout& layout);
         void AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout);
+        // the attributes start at firstLocation and advance once every divisor instances instead of every vertex
+        void AddInstanceBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout, u32 firstLocation, u32 divisor = 1);
+    private:
+        static void SetAttributes(const VertexBufferLayout& layout, u32 firstLocation, u32 divisor);
+    public:
 
         friend class GraphicsDevice;
     };
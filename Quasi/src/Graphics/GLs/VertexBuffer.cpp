@@ -3,6 +3,7 @@
 #include <glp.h>
 
 #include "GLDebug.h"
+#include "GLStateCache.h"
 
 namespace Quasi::Graphics {
     VertexBuffer::VertexBuffer(GraphicsID id, u32 size) : GLObject(id), bufferSize(size) {}
@@ -17,19 +18,20 @@ namespace Quasi::Graphics {
 
     void VertexBuffer::DestroyObject(GraphicsID id) {
         QGLCall$(GL::DeleteBuffers(1, &id));
+        GLStateCache::ForgetBuffer(id);
     }
 
     void VertexBuffer::BindObject(GraphicsID id) {
-        QGLCall$(GL::BindBuffer(GL::ARRAY_BUFFER, id));
+        GLStateCache::BindBuffer(GL::ARRAY_BUFFER, id);
     }
 
     void VertexBuffer::UnbindObject() {
-        QGLCall$(GL::BindBuffer(GL::ARRAY_BUFFER, 0));
+        GLStateCache::BindBuffer(GL::ARRAY_BUFFER, 0);
     }
 
-    void VertexBuffer::SetDataBytes(Span<const byte> data) {
+    void VertexBuffer::SetDataBytes(Span<const byte> data, u32 offset) {
         Bind();
-        QGLCall$(GL::BufferSubData(GL::ARRAY_BUFFER, 0, (int)data.ByteSize(), data.Data()));
+        QGLCall$(GL::BufferSubData(GL::ARRAY_BUFFER, offset, (int)data.ByteSize(), data.Data()));
     }
 
     void VertexBuffer::ClearData() {
@@ -41,4 +43,36 @@ namespace Quasi::Graphics {
         QGLCall$(GL::BufferSubData(GL::ARRAY_BUFFER, (int)dataOffset, (int)data.ByteSize(), data.Data()));
         dataOffset += data.ByteSize();
     }
-}
+
+    byte* VertexBuffer::MapRange(u32 offset, u32 length, bool invalidate) {
+        Bind();
+        void* ptr = QGLCall$(GL::MapBufferRange(GL::ARRAY_BUFFER, offset, length,
+            GL::MAP_WRITE_BIT | GL::MAP_UNSYNCHRONIZED_BIT | (invalidate ? GL::MAP_INVALIDATE_RANGE_BIT : 0)));
+        return (byte*)ptr;
+    }
+
+    void VertexBuffer::Unmap() {
+        Bind();
+        QGLCall$(GL::UnmapBuffer(GL::ARRAY_BUFFER));
+    }
+
+    void VertexBuffer::Resize(u32 size, u32 keepOffset, u32 keepLength) {
+        Bind();
+        if (keepLength == 0) {
+            // orphans the old storage, draws still using it are unaffected
+            QGLCall$(GL::BufferData(GL::ARRAY_BUFFER, size, nullptr, GL::DYNAMIC_DRAW));
+        } else {
+            GraphicsID temp;
+            QGLCall$(GL::GenBuffers(1, &temp));
+            GLStateCache::BindBuffer(GL::COPY_WRITE_BUFFER, temp);
+            QGLCall$(GL::BufferData(GL::COPY_WRITE_BUFFER, keepLength, nullptr, GL::STREAM_COPY));
+            QGLCall$(GL::CopyBufferSubData(GL::ARRAY_BUFFER, GL::COPY_WRITE_BUFFER, keepOffset, 0, keepLength));
+            QGLCall$(GL::BufferData(GL::ARRAY_BUFFER, size, nullptr, GL::DYNAMIC_DRAW));
+            QGLCall$(GL::CopyBufferSubData(GL::COPY_WRITE_BUFFER, GL::ARRAY_BUFFER, 0, 0, keepLength));
+            QGLCall$(GL::DeleteBuffers(1, &temp));
+            GLStateCache::ForgetBuffer(temp);
+        }
+        bufferSize = size;
+        dataOffset = 0;
+    }
+}
\ No newline at end of file
@@ -18,7 +18,7 @@ namespace Quasi::Graphics {
 
         u32 GetLength() const { return bufferSize; }
 
-        void SetDataBytes(Span<const byte> data);
+        void SetDataBytes(Span<const byte> data, u32 offset = 0);
         template <class T> void SetData(Span<const T> data) { SetDataBytes(data.AsBytes()); }
         template <ContinuousCollectionAny T> void SetData(const T& data) { SetData(data.AsSpan()); }
 
@@ -28,6 +28,12 @@ namespace Quasi::Graphics {
         template <class T> void AddData(Span<const T> data) { AddDataBytes(data.AsBytes()); }
         template <ContinuousCollectionAny T> void AddData(const T& data) { AddData(data.AsSpan()); }
 
+        // unsynchronized write only mapping, the caller is responsible for fencing
+        byte* MapRange(u32 offset, u32 length, bool invalidate = true);
+        void Unmap();
+        // reallocates the storage, copying [keepOffset, keepOffset + keepLength) to the start on the gpu
+        void Resize(u32 size, u32 keepOffset = 0, u32 keepLength = 0);
+
         friend class GraphicsDevice;
     };
 }
@@ -2,8 +2,10 @@
 #include <vector>
 
 #include "GLTypeID.h"
+#include "VertexPacking.h"
 #include "Math/Vector.h"
 #include "Math/Color.h"
+#include "Math/Matrix.h"
 
 namespace Quasi::Graphics {
     struct VertexBufferComponent {
@@ -12,6 +14,7 @@ namespace Quasi::Graphics {
         u32 flags : 8;
         static constexpr byte NORMALIZED_FLAG = 1 << 0;
         static constexpr byte INTEGER_FLAG = 1 << 1;
+        static constexpr byte OCTAHEDRAL_FLAG = 1 << 2; // a normal packed by OctNormal, the shader has to unfold it
 
         VertexBufferComponent() = default;
         VertexBufferComponent(GLTypeID type, uint count, bool norm = false, bool integral = false)
@@ -31,6 +34,11 @@ namespace Quasi::Graphics {
         static VertexBufferComponent IVec4()  { return { GLGetTypeID<int>(),    4 }; }
 
         template <class T> static VertexBufferComponent Type() {
+            if constexpr (IPackedComponent<T>) {
+                VertexBufferComponent comp { GLGetTypeID<typename T::scalar>(), T::dimension, true };
+                if constexpr (T::IS_OCTAHEDRAL) comp.flags |= OCTAHEDRAL_FLAG;
+                return comp;
+            }
             if constexpr (std::is_floating_point_v<T>) return { GLGetTypeID<T>(), 1 };
             if constexpr (std::is_integral_v<T>) return { GLGetTypeID<T>(), 1, false, true };
             if constexpr (Math::IVector<T> || Math::ColorLike<T>)
@@ -48,7 +56,15 @@ namespace Quasi::Graphics {
         VertexBufferLayout(IList<VertexBufferComponent> comps);
 
         template <class... Ts> static VertexBufferLayout FromTypes() {
-            return { VertexBufferComponent::Type<Ts>()... };
+            VertexBufferLayout layout;
+            (layout.PushType<Ts>(), ...);
+            return layout;
+        }
+
+        // a matrix takes one attribute per column, like a mat4 input does in glsl
+        template <class T> void PushType() { Push(VertexBufferComponent::Type<T>()); }
+        template <class T> void PushType() requires Math::IMatrix<T> {
+            for (u32 i = 0; i < T::col_count; ++i) Push(VertexBufferComponent::Type<typename T::col>());
         }
 
         template <class T> void Push(u32 count, bool normalized = false, bool integral = false);
@@ -74,6 +90,12 @@ namespace Quasi::Graphics {
 
         const Vec<VertexBufferComponent>& GetComponents() const { return components; }
         u32 GetStride() const { return stride; }
+        // if any component has all of the flags, like OCTAHEDRAL_FLAG for a normal the shader has to unfold
+        bool HasFlags(byte flags) const {
+            for (const VertexBufferComponent& comp : components)
+                if ((comp.flags & flags) == flags) return true;
+            return false;
+        }
     };
 
     template <class T>
@@ -1,7 +1,11 @@
 ﻿#pragma once
+#include <array>
+#include <cstddef>
+
 #include "Math/Transform2D.h"
 #include "Math/Transform3D.h"
 #include "VertexBufferLayout.h"
+#include "VertexTransform.h"
 
 #define Q_GL_DEFINE_VERTEX(T, DIM, MEMBS, ... /* may use 'custom transform' */) \
     static constexpr bool IS_GL_VERTEX = true; \
@@ -16,21 +20,42 @@
         Q_IF_ARGS_ELSE((__VA_ARGS__), (return __VA_ARGS__(_tr);), ( \
             return T { Q_INVOKE(Q_ARGS_SKIP, Q_ITERATE_SEQUENCE(Q_GL_VERTTRANS_IT, MEMBS)) }; \
         ))\
+    } \
+    \
+    static constexpr bool _VCUSTOM = false __VA_OPT__(|| true); \
+    static constexpr auto _VSlots() { \
+        return std::array { Q_INVOKE(Q_ARGS_SKIP, Q_ITERATE_SEQUENCE(Q_GL_VERTSLOT_IT, MEMBS)) }; \
     }
 
 #define Q_GL_VERTTRANS_IT(MX) , .Q_ARGS_FIRST MX = Q_GL_VERTTRANS_WHEN_T MX
 #define Q_GL_VERTTRANS_WHEN_T(M, ...) __VA_OPT__(__VA_ARGS__::transform Q_LPAREN() ) M __VA_OPT__(, _tr Q_RPAREN())
 #define Q_GL_VERTLAYOUT_IT(X_) , decltype(Self:: Q_ARGS_FIRST X_)
+#define Q_GL_VERTSLOT_IT(MX) , Q_GL_VERTSLOT_OF MX
+#define Q_GL_VERTSLOT_OF(M, ...) Quasi::Graphics::VertexSlot { offsetof(Self, M), Quasi::Graphics::VertexSlotKindOf<__VA_ARGS__> }
 
 #define QuasiDefineVertex$(...) Q_GL_DEFINE_VERTEX(__VA_ARGS__)
 
+// per instance data, members are listed like (Model)(Color). matrices take one location per column
+#define Q_GL_DEFINE_INSTANCE(T, MEMBS) \
+    static constexpr bool IS_GL_INSTANCE = true; \
+    using Self = T; \
+    public: \
+    inline static const auto INSTANCE_LAYOUT = Quasi::Graphics::VertexBufferLayout::FromTypes< \
+        Q_INVOKE(Q_ARGS_SKIP, Q_ITERATE_SEQUENCE(Q_GL_VERTLAYOUT_IT, MEMBS)) \
+    >();
+
+#define QuasiDefineInstance$(...) Q_GL_DEFINE_INSTANCE(__VA_ARGS__)
+
 namespace Quasi::Graphics {
     template <class T> concept IVertex = requires { T::IS_GL_VERTEX; };
+    template <class T> concept IInstance = requires { T::IS_GL_INSTANCE; };
 
-    namespace VertexBuilder {
-        struct MeshConstructData2D { Math::fVector2 Position; };
-        struct MeshConstructData3D { Math::fVector3 Position, Normal; };
-    }
+    // what the batched transform does with a vertex member
+    enum class VertexSlotKind { UNTOUCHED, POSITION, NORMAL, CUSTOM };
+    struct VertexSlot { usize offset; VertexSlotKind kind; };
+    // members with a transformer the batch doesnt know make the whole vertex go through _VMul
+    template <class Tf = void> constexpr VertexSlotKind VertexSlotKindOf = VertexSlotKind::CUSTOM;
+    template <> constexpr VertexSlotKind VertexSlotKindOf<void> = VertexSlotKind::UNTOUCHED;
 
     struct PosTf {
         static Math::fVector2 transform(const Math::fVector2& vec, const Math::ITransformer2D auto& transform) {
@@ -51,6 +76,23 @@ namespace Quasi::Graphics {
         }
     };
 
+    template <> constexpr VertexSlotKind VertexSlotKindOf<PosTf>  = VertexSlotKind::POSITION;
+    template <> constexpr VertexSlotKind VertexSlotKindOf<NormTf> = VertexSlotKind::NORMAL;
+
+    namespace VertexBuilder {
+        // vertices too, so the unit geometry of a MeshUtils primitive can be kept as a mesh
+        struct MeshConstructData2D {
+            Math::fVector2 Position;
+
+            QuasiDefineVertex$(MeshConstructData2D, 2D, (Position, PosTf));
+        };
+        struct MeshConstructData3D {
+            Math::fVector3 Position, Normal;
+
+            QuasiDefineVertex$(MeshConstructData3D, 3D, (Position, PosTf)(Normal, NormTf));
+        };
+    }
+
     struct Vertex2D {
         Math::fVector2 Position;
 
@@ -115,6 +157,52 @@ namespace Quasi::Graphics {
         QuasiDefineVertex$(VertexTextureNormal3D, 3D, (Position, PosTf)(TextureCoordinate)(Normal, NormTf));
     };
 
+    // unpacks, transforms and packs again, so vertices with it skip the batched path
+    struct PackedNormTf {
+        static OctNormal transform(const OctNormal& n, const Math::ITransformer3D auto& transform) {
+            return OctNormal::Pack(transform.TransformNormal(n.Unpack()));
+        }
+    };
+
+    // smaller versions of the vertices above, positions stay as floats. convert a whole mesh with
+    // mesh.GeometryMap<VertexCompactNormal3D>([] (Ref<const VertexNormal3D> v) { return VertexCompactNormal3D::From(*v); })
+    struct VertexCompactNormal3D {
+        Math::fVector3 Position;
+        OctNormal      Normal;
+
+        static VertexCompactNormal3D From(const VertexNormal3D& v) { return { v.Position, OctNormal::Pack(v.Normal) }; }
+        VertexNormal3D Unpacked() const { return { Position, Normal.Unpack() }; }
+
+        QuasiDefineVertex$(VertexCompactNormal3D, 3D, (Position, PosTf)(Normal, PackedNormTf));
+    };
+
+    struct VertexCompactColorNormal3D {
+        Math::fVector3 Position;
+        unorm8x4       Color;
+        OctNormal      Normal;
+
+        static VertexCompactColorNormal3D From(const VertexColorNormal3D& v) {
+            return { v.Position, unorm8x4::Pack(v.Color), OctNormal::Pack(v.Normal) };
+        }
+        VertexColorNormal3D Unpacked() const { return { Position, Color.UnpackColor(), Normal.Unpack() }; }
+
+        QuasiDefineVertex$(VertexCompactColorNormal3D, 3D, (Position, PosTf)(Color)(Normal, PackedNormTf));
+    };
+
+    // texture coordinates are clamped to [0, 1], repeating ones need the full VertexTextureNormal3D
+    struct VertexCompactTextureNormal3D {
+        Math::fVector3 Position;
+        unorm16x2      TextureCoordinate;
+        OctNormal      Normal;
+
+        static VertexCompactTextureNormal3D From(const VertexTextureNormal3D& v) {
+            return { v.Position, unorm16x2::Pack(v.TextureCoordinate), OctNormal::Pack(v.Normal) };
+        }
+        VertexTextureNormal3D Unpacked() const { return { Position, TextureCoordinate.Unpack(), Normal.Unpack() }; }
+
+        QuasiDefineVertex$(VertexCompactTextureNormal3D, 3D, (Position, PosTf)(TextureCoordinate)(Normal, PackedNormTf));
+    };
+
     template <IVertex T>
     const VertexBufferLayout& VertexLayoutOf() { return T::VERTEX_LAYOUT; }
 
@@ -127,4 +215,36 @@ namespace Quasi::Graphics {
     T VertexMul(const T& v, const Math::ITransformer3D auto& transform) {
         return v._VMul(transform);
     }
+
+    template <IVertex T, class Tf>
+    constexpr bool CanVertexMulBatch() {
+        using Plain = IfElse<T::DIMENSION == 2, Math::Transform2D, Math::Transform3D>;
+        if constexpr (T::_VCUSTOM || !std::is_same_v<Tf, Plain>) return false;
+        else {
+            for (const VertexSlot& slot : T::_VSlots())
+                if (slot.kind == VertexSlotKind::CUSTOM) return false;
+            return true;
+        }
+    }
+
+    // VertexMul over count vertices, written as raw bytes to dst (which can be src itself).
+    // plain Transform2D/3D go through VertexTransform per member, everything else one vertex at a time
+    template <IVertex T, class Tf>
+    void VertexMulBatch(const T* src, byte* dst, usize count, const Tf& transform) {
+        if constexpr (CanVertexMulBatch<T, Tf>()) {
+            if ((const byte*)src != dst)
+                Memory::MemCopyNoOverlap(dst, Memory::TransmutePtr<const byte>(src), count * sizeof(T));
+            for (const VertexSlot& slot : T::_VSlots()) {
+                if (slot.kind == VertexSlotKind::POSITION)
+                    VertexTransform::Points (dst + slot.offset, count, sizeof(T), transform);
+                else if (slot.kind == VertexSlotKind::NORMAL)
+                    VertexTransform::Normals(dst + slot.offset, count, sizeof(T), transform);
+            }
+        } else {
+            for (usize i = 0; i < count; ++i) {
+                const T v = VertexMul(src[i], transform);
+                Memory::MemCopyNoOverlap(dst + i * sizeof(T), Memory::TransmutePtr<const byte>(&v), sizeof(T));
+            }
+        }
+    }
 }
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Math/Vector.h"
+#include "Math/Color.h"
+
+namespace Quasi::Graphics {
+    // N integers the shader reads as floats, signed ones map to [-1, 1] and unsigned ones to [0, 1].
+    // the attribute stays a vecN in glsl, only the buffer gets smaller
+    template <class T, u32 N>
+    struct NormalizedVec {
+        static constexpr bool IS_PACKED = true, IS_OCTAHEDRAL = false;
+        using scalar = T;
+        static constexpr u32 dimension = N;
+        static constexpr float MAX = (float)std::numeric_limits<T>::max();
+        static constexpr float LOWEST = std::is_signed_v<T> ? -1.0f : 0.0f;
+
+        T data[N] {};
+
+        static NormalizedVec Pack(const Math::VectorN<N, float>& v) {
+            NormalizedVec p;
+            for (u32 i = 0; i < N; ++i) p.data[i] = (T)std::lround(std::clamp(v[i], LOWEST, 1.0f) * MAX);
+            return p;
+        }
+        static NormalizedVec Pack(const Math::fColor& c) requires (N == 4) { return Pack(Math::fVector4 { c.r, c.g, c.b, c.a }); }
+
+        Math::VectorN<N, float> Unpack() const {
+            Math::VectorN<N, float> v;
+            // snorm has one more negative value than positive, both ends are -1
+            for (u32 i = 0; i < N; ++i) v[i] = std::max((float)data[i] / MAX, LOWEST);
+            return v;
+        }
+        Math::fColor UnpackColor() const requires (N == 4) {
+            const Math::fVector4 v = Unpack();
+            return { v.x, v.y, v.z, v.w };
+        }
+    };
+
+    using snorm16x2 = NormalizedVec<i16, 2>;
+    using snorm16x4 = NormalizedVec<i16, 4>;
+    using unorm16x2 = NormalizedVec<u16, 2>;
+    using snorm8x4  = NormalizedVec<i8,  4>;
+    using unorm8x4  = NormalizedVec<u8,  4>;
+
+    // a unit vector folded onto an octahedron, then stored as 2 snorm16: 4 bytes instead of 12.
+    // the attribute comes in as a vec2, and the shader unfolds it with
+    //     vec3 n = vec3(p, 1.0 - abs(p.x) - abs(p.y));
+    //     if (n.z < 0.0) n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    //     n = normalize(n);
+    struct OctNormal {
+        static constexpr bool IS_PACKED = true, IS_OCTAHEDRAL = true;
+        using scalar = i16;
+        static constexpr u32 dimension = 2;
+
+        snorm16x2 folded;
+
+        static OctNormal Pack(const Math::fVector3& n) {
+            const float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+            Math::fVector2 p = l1 > 0 ? Math::fVector2 { n.x / l1, n.y / l1 } : Math::fVector2 { 0, 0 };
+            if (n.z < 0) p = { (1 - std::abs(p.y)) * SignOf(p.x), (1 - std::abs(p.x)) * SignOf(p.y) };
+            return { snorm16x2::Pack(p) };
+        }
+
+        Math::fVector3 Unpack() const {
+            const Math::fVector2 p = folded.Unpack();
+            Math::fVector3 n = { p.x, p.y, 1 - std::abs(p.x) - std::abs(p.y) };
+            if (n.z < 0) {
+                const float x = n.x;
+                n.x = (1 - std::abs(n.y)) * SignOf(x);
+                n.y = (1 - std::abs(x))   * SignOf(n.y);
+            }
+            return n.norm();
+        }
+    private:
+        static float SignOf(float x) { return x >= 0 ? 1.0f : -1.0f; }
+    };
+
+    template <class T> concept IPackedComponent = requires { T::IS_PACKED; };
+}
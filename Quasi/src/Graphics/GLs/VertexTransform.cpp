@@ -0,0 +1,128 @@
+#include "VertexTransform.h"
+
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define QUASI_VERTEX_SSE 1
+#include <xmmintrin.h>
+#else
+#define QUASI_VERTEX_SSE 0
+#endif
+
+namespace Quasi::Graphics::VertexTransform {
+    namespace {
+        // v maps to v[0] * cols[0] + v[1] * cols[1] (+ v[2] * cols[2]) + offset
+        template <u32 N>
+        struct Affine {
+            float cols[N][N] {};
+            float offset[N] {};
+            bool normalize = false;
+        };
+
+        // the columns are the rotated axes, so this matches rotating the scaled vector
+        Affine<2> MatrixOf(const Math::Transform2D& t, bool normal) {
+            Affine<2> a;
+            const Math::fVector2 x = Math::fVector2 { 1, 0 }.rotated_by(t.rotation),
+                                 y = Math::fVector2 { 0, 1 }.rotated_by(t.rotation);
+            const Math::fVector2 s = normal ? 1.0f / t.scale : t.scale;
+            a.cols[0][0] = x.x * s.x; a.cols[0][1] = x.y * s.x;
+            a.cols[1][0] = y.x * s.y; a.cols[1][1] = y.y * s.y;
+            if (!normal) { a.offset[0] = t.position.x; a.offset[1] = t.position.y; }
+            a.normalize = normal;
+            return a;
+        }
+
+        Affine<3> MatrixOf(const Math::Transform3D& t, bool normal) {
+            Affine<3> a;
+            const Math::fVector3 axes[3] = {
+                Math::fVector3 { 1, 0, 0 }.rotated_by(t.rotation),
+                Math::fVector3 { 0, 1, 0 }.rotated_by(t.rotation),
+                Math::fVector3 { 0, 0, 1 }.rotated_by(t.rotation),
+            };
+            const Math::fVector3 s = normal ? 1.0f / t.scale : t.scale;
+            const float sc[3] = { s.x, s.y, s.z };
+            for (u32 c = 0; c < 3; ++c) {
+                a.cols[c][0] = axes[c].x * sc[c];
+                a.cols[c][1] = axes[c].y * sc[c];
+                a.cols[c][2] = axes[c].z * sc[c];
+            }
+            if (!normal) { a.offset[0] = t.position.x; a.offset[1] = t.position.y; a.offset[2] = t.position.z; }
+            a.normalize = normal;
+            return a;
+        }
+
+        template <u32 N>
+        void Apply(byte* data, usize count, usize stride, const Affine<N>& a) {
+            usize i = 0;
+#if QUASI_VERTEX_SSE
+            __m128 cols[N][N], offset[N];
+            for (u32 c = 0; c < N; ++c) {
+                offset[c] = _mm_set1_ps(a.offset[c]);
+                for (u32 r = 0; r < N; ++r) cols[c][r] = _mm_set1_ps(a.cols[c][r]);
+            }
+
+            // the vertices are interleaved, so four of them are gathered into one register per component
+            for (; i + 4 <= count; i += 4) {
+                float lanes[N][4];
+                for (u32 k = 0; k < 4; ++k) {
+                    float v[N];
+                    std::memcpy(v, data + (i + k) * stride, sizeof(v));
+                    for (u32 c = 0; c < N; ++c) lanes[c][k] = v[c];
+                }
+
+                __m128 in[N], out[N];
+                for (u32 c = 0; c < N; ++c) in[c] = _mm_loadu_ps(lanes[c]);
+                for (u32 r = 0; r < N; ++r) {
+                    out[r] = offset[r];
+                    for (u32 c = 0; c < N; ++c) out[r] = _mm_add_ps(out[r], _mm_mul_ps(in[c], cols[c][r]));
+                }
+                if (a.normalize) {
+                    __m128 len2 = _mm_mul_ps(out[0], out[0]);
+                    for (u32 r = 1; r < N; ++r) len2 = _mm_add_ps(len2, _mm_mul_ps(out[r], out[r]));
+                    const __m128 len = _mm_sqrt_ps(len2);
+                    for (u32 r = 0; r < N; ++r) out[r] = _mm_div_ps(out[r], len);
+                }
+
+                for (u32 r = 0; r < N; ++r) _mm_storeu_ps(lanes[r], out[r]);
+                for (u32 k = 0; k < 4; ++k) {
+                    float v[N];
+                    for (u32 c = 0; c < N; ++c) v[c] = lanes[c][k];
+                    std::memcpy(data + (i + k) * stride, v, sizeof(v));
+                }
+            }
+#endif
+            for (; i < count; ++i) {
+                float v[N], out[N];
+                std::memcpy(v, data + i * stride, sizeof(v));
+                for (u32 r = 0; r < N; ++r) {
+                    out[r] = a.offset[r];
+                    for (u32 c = 0; c < N; ++c) out[r] += v[c] * a.cols[c][r];
+                }
+                if (a.normalize) {
+                    float len2 = 0;
+                    for (u32 r = 0; r < N; ++r) len2 += out[r] * out[r];
+                    const float len = std::sqrt(len2);
+                    for (u32 r = 0; r < N; ++r) out[r] /= len;
+                }
+                std::memcpy(data + i * stride, out, sizeof(out));
+            }
+        }
+    }
+
+    void Points(byte* data, usize count, usize stride, const Math::Transform2D& transform) {
+        Apply(data, count, stride, MatrixOf(transform, false));
+    }
+
+    void Normals(byte* data, usize count, usize stride, const Math::Transform2D& transform) {
+        Apply(data, count, stride, MatrixOf(transform, true));
+    }
+
+    void Points(byte* data, usize count, usize stride, const Math::Transform3D& transform) {
+        Apply(data, count, stride, MatrixOf(transform, false));
+    }
+
+    void Normals(byte* data, usize count, usize stride, const Math::Transform3D& transform) {
+        Apply(data, count, stride, MatrixOf(transform, true));
+    }
+}
@@ -0,0 +1,13 @@
+#pragma once
+#include "Math/Transform2D.h"
+#include "Math/Transform3D.h"
+
+namespace Quasi::Graphics::VertexTransform {
+    // transforms count vectors in place, each one stride bytes after the last. the transform is
+    // turned into a matrix once, and the vectors go through it four at a time with sse.
+    // normals come out normalized, the same as Transform2D/3D::TransformNormal
+    void Points (byte* data, usize count, usize stride, const Math::Transform2D& transform);
+    void Normals(byte* data, usize count, usize stride, const Math::Transform2D& transform);
+    void Points (byte* data, usize count, usize stride, const Math::Transform3D& transform);
+    void Normals(byte* data, usize count, usize stride, const Math::Transform3D& transform);
+}
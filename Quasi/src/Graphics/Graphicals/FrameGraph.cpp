@@ -0,0 +1,185 @@
+#include "FrameGraph.h"
+
+#include <cmath>
+
+#include "GLDebug.h"
+#include "Render.h"
+
+namespace Quasi::Graphics {
+    Texture& FrameGraph::PassContext::GetTexture(Resource r) {
+        return graph.TextureOf(pool, r.id);
+    }
+
+    FrameGraph::PassBuilder& FrameGraph::PassBuilder::Read(Resource r) {
+        graph.passes[pass].reads.Push(r.id);
+        return *this;
+    }
+
+    FrameGraph::PassBuilder& FrameGraph::PassBuilder::Write(Resource r) {
+        graph.passes[pass].colors.Push(r.id);
+        return *this;
+    }
+
+    FrameGraph::PassBuilder& FrameGraph::PassBuilder::WriteDepth(Resource r) {
+        graph.passes[pass].depth = r.id;
+        return *this;
+    }
+
+    FrameGraph::PassBuilder& FrameGraph::PassBuilder::KeepAlive() {
+        graph.passes[pass].keepAlive = true;
+        return *this;
+    }
+
+    void FrameGraph::Reset() {
+        resources.Clear();
+        passes.Clear();
+        resources.Push({ .name = "Backbuffer", .backbuffer = true });
+        compiled = false;
+    }
+
+    FrameGraph::Resource FrameGraph::Create(Str name, const RenderTargetDesc& desc) {
+        compiled = false;
+        resources.Push({ .name = name, .desc = desc });
+        return { (u32)resources.Length() - 1 };
+    }
+
+    FrameGraph::Resource FrameGraph::CreateRelative(Str name, const RenderTargetDesc& desc, float scale) {
+        compiled = false;
+        resources.Push({ .name = name, .desc = desc, .scale = scale });
+        return { (u32)resources.Length() - 1 };
+    }
+
+    FrameGraph::Resource FrameGraph::Import(Str name, Texture& texture) {
+        compiled = false;
+        resources.Push({ .name = name, .imported = &texture });
+        return { (u32)resources.Length() - 1 };
+    }
+
+    void FrameGraph::Compile() {
+        compiled = true;
+        stats = { .passes = (u32)passes.Length() };
+
+        // backwards, a pass is needed if something after it reads what it writes. what it writes is
+        // then spoken for, what it reads is needed from the passes before
+        Vec<u8> needed;
+        needed.Resize(resources.Length(), false);
+        for (usize p = passes.Length(); p --> 0;) {
+            PassNode& pass = passes[p];
+            bool keep = pass.keepAlive;
+            for (const u32 r : pass.colors) keep |= !resources[r].IsTransient() || needed[r];
+            if (pass.depth != NONE) keep |= !resources[pass.depth].IsTransient() || needed[pass.depth];
+
+            pass.culled = !keep;
+            if (!keep) { ++stats.culled; continue; }
+            for (const u32 r : pass.colors) needed[r] = false;
+            if (pass.depth != NONE) needed[pass.depth] = false;
+            for (const u32 r : pass.reads) needed[r] = true;
+        }
+
+        for (ResourceNode& res : resources) res.first = res.last = NONE;
+        for (u32 p = 0; p < passes.Length(); ++p) {
+            if (passes[p].culled) continue;
+            ForEachUse(passes[p], [&] (u32 r) {
+                ResourceNode& res = resources[r];
+                if (res.first == NONE) {
+                    res.first = p;
+                    stats.transients += res.IsTransient();
+                }
+                res.last = p;
+            });
+        }
+
+        for (u32 r = 0; r < resources.Length(); ++r) {
+            const ResourceNode& res = resources[r];
+            if (!res.IsTransient() || res.first == NONE) continue;
+            const PassNode& first = passes[res.first];
+            if (!first.colors.Contains(r) && first.depth != r)
+                GLLogger().Warn("frame graph target {} is read before anything draws to it.", res.name);
+        }
+    }
+
+    void FrameGraph::Execute(RenderTargetPool& pool, Math::uVector2 backbuffer) {
+        backbufferSize = backbuffer;
+        if (!compiled) Compile();
+
+        Vec<RenderTargetPool::Attachment> colors;
+        Vec<Ref<Texture>> activated;
+        for (u32 p = 0; p < passes.Length(); ++p) {
+            PassNode& pass = passes[p];
+            if (pass.culled) continue;
+
+            ForEachUse(pass, [&] (u32 r) {
+                ResourceNode& res = resources[r];
+                if (res.IsTransient() && res.first == p && res.target == NONE) {
+                    RenderTargetDesc desc = res.desc;
+                    desc.size = SizeOf(r);
+                    res.target = pool.Acquire(desc);
+                }
+            });
+
+            // the backbuffer doesnt mix with other targets, so if its written to its all thats written to
+            const bool toBackbuffer = pass.colors.Contains(0) || pass.depth == 0;
+            Math::uVector2 viewport = backbufferSize;
+            if (toBackbuffer) {
+                FrameBuffer::UnbindObject();
+            } else if (pass.colors.Length() || pass.depth != NONE) {
+                colors.Clear();
+                for (const u32 r : pass.colors) colors.Push(AttachmentOf(pool, r));
+                const RenderTargetPool::Attachment depth = pass.depth == NONE ? RenderTargetPool::Attachment {} : AttachmentOf(pool, pass.depth);
+                // imported textures dont say their format, so theyre taken as depth only
+                const AttachmentType depthType = pass.depth != NONE && resources[pass.depth].IsTransient() ?
+                    resources[pass.depth].desc.DepthAttachment() : AttachmentType::DEPTH;
+                pool.FrameBufferFor(colors.AsSpan(), depth, depthType).Bind();
+                viewport = SizeOf(pass.colors.Length() ? pass.colors[0] : pass.depth);
+            }
+            Render::SetViewport({ 0, viewport.as<int>() });
+
+            activated.Clear();
+            for (const u32 r : pass.reads) {
+                Texture& tex = TextureOf(pool, r);
+                if (tex.Slot() >= 0) continue;
+                tex.Activate();
+                activated.Push(tex);
+            }
+
+            PassContext ctx { *this, pool, viewport };
+            pass.execute->Run(ctx);
+
+            for (Ref<Texture> tex : activated) tex->Deactivate();
+            ForEachUse(pass, [&] (u32 r) {
+                ResourceNode& res = resources[r];
+                if (res.target != NONE && res.last == p) {
+                    pool.Release(res.target);
+                    res.target = NONE;
+                }
+            });
+        }
+
+        FrameBuffer::UnbindObject();
+        Render::SetViewport({ 0, backbufferSize.as<int>() });
+        pool.EndFrame();
+    }
+
+    Math::uVector2 FrameGraph::SizeOf(u32 res) const {
+        const ResourceNode& node = resources[res];
+        if (node.backbuffer) return backbufferSize;
+        if (node.imported)   return node.imported->Size2D();
+        if (node.scale <= 0) return node.desc.size;
+        return {
+            std::max(1u, (u32)std::lround((float)backbufferSize.x * node.scale)),
+            std::max(1u, (u32)std::lround((float)backbufferSize.y * node.scale)),
+        };
+    }
+
+    RenderTargetPool::Attachment FrameGraph::AttachmentOf(RenderTargetPool& pool, u32 res) const {
+        const ResourceNode& node = resources[res];
+        if (node.imported) return { node.imported };
+        return RenderTargetPool::Attachment::Of(pool.Get(node.target));
+    }
+
+    Texture& FrameGraph::TextureOf(RenderTargetPool& pool, u32 res) const {
+        const ResourceNode& node = resources[res];
+        if (node.imported) return *node.imported;
+        return pool.Get(node.target).texture;
+    }
+}
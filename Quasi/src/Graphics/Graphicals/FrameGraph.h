@@ -0,0 +1,128 @@
+#pragma once
+#include "RenderTargetPool.h"
+
+namespace Quasi::Graphics {
+    // the passes of a frame and what they draw into and read from. each pass says up front which targets
+    // it reads and writes, Compile then drops the passes whose results nothing ends up using and works out
+    // the first and last pass that needs each transient target. Execute takes a target from the pool right
+    // before its first pass and gives it back after its last, so targets that arent needed at the same time
+    // share one texture. the graph is made again every frame (Reset keeps the memory), the pool stays
+    class FrameGraph {
+    public:
+        struct Resource {
+            u32 id = ~0u;
+            bool IsNull() const { return id == ~0u; }
+        };
+
+        struct Stats {
+            u32 passes = 0, culled = 0, transients = 0;
+        };
+
+        class PassContext {
+            FrameGraph& graph;
+            RenderTargetPool& pool;
+            Math::uVector2 viewport;
+            PassContext(FrameGraph& graph, RenderTargetPool& pool, Math::uVector2 viewport) : graph(graph), pool(pool), viewport(viewport) {}
+        public:
+            // already in a texture slot for the pass, for Shader::SetUniformTex
+            Texture& GetTexture(Resource r);
+            Math::uVector2 Size(Resource r) const { return graph.SizeOf(r.id); }
+            // the size of what the pass draws into
+            Math::uVector2 ViewportSize() const { return viewport; }
+
+            friend class FrameGraph;
+        };
+
+        class PassBuilder {
+            FrameGraph& graph;
+            u32 pass;
+            PassBuilder(FrameGraph& graph, u32 pass) : graph(graph), pass(pass) {}
+        public:
+            PassBuilder& Read(Resource r);
+            // color attachments, in order. a pass drawing to the backbuffer draws only to it
+            PassBuilder& Write(Resource r);
+            PassBuilder& WriteDepth(Resource r);
+            // runs even if nothing reads what it writes
+            PassBuilder& KeepAlive();
+
+            friend class FrameGraph;
+        };
+    private:
+        static constexpr u32 NONE = ~0u;
+
+        struct ResourceNode {
+            Str name;
+            RenderTargetDesc desc;
+            float scale = 0; // of the backbuffer, 0 keeps the size in desc
+            Texture* imported = nullptr;
+            bool backbuffer = false;
+            u32 first = NONE, last = NONE; // the passes that use it, while compiled
+            u32 target = NONE; // in the pool, while executing
+
+            bool IsTransient() const { return !imported && !backbuffer; }
+        };
+
+        struct PassExecutor {
+            virtual ~PassExecutor() = default;
+            virtual void Run(PassContext& ctx) = 0;
+        };
+
+        template <class F>
+        struct PassExecutorOf : PassExecutor {
+            F func;
+            explicit PassExecutorOf(auto&& f) : func((decltype(f))f) {}
+            void Run(PassContext& ctx) override { func(ctx); }
+        };
+
+        struct PassNode {
+            Str name;
+            Vec<u32> reads, colors;
+            u32 depth = NONE;
+            bool keepAlive = false, culled = false;
+            Box<PassExecutor> execute;
+        };
+
+        Vec<ResourceNode> resources;
+        Vec<PassNode> passes;
+        Math::uVector2 backbufferSize;
+        bool compiled = false;
+        Stats stats;
+    public:
+        FrameGraph() { Reset(); }
+
+        void Reset();
+
+        Resource Create(Str name, const RenderTargetDesc& desc);
+        // sized by the backbuffer, times scale
+        Resource CreateRelative(Str name, const RenderTargetDesc& desc, float scale = 1);
+        // a texture from outside, passes writing to it always run
+        Resource Import(Str name, Texture& texture);
+        Resource Backbuffer() const { return { 0 }; }
+
+        // execute is called as execute(PassContext&) while the pass's targets are bound
+        template <class F>
+        PassBuilder AddPass(Str name, F&& execute) {
+            compiled = false;
+            passes.Push({ .name = name, .execute = Box<PassExecutor>::Own(new PassExecutorOf<std::decay_t<F>>((F&&)execute)) });
+            return { *this, (u32)passes.Length() - 1 };
+        }
+
+        void Compile();
+        // leaves the backbuffer bound, with the viewport over all of it
+        void Execute(RenderTargetPool& pool, Math::uVector2 backbuffer);
+
+        bool IsCulled(u32 pass) const { return passes[pass].culled; }
+        u32 PassCount() const { return passes.Length(); }
+        Str PassName(u32 pass) const { return passes[pass].name; }
+        const Stats& GetStats() const { return stats; }
+    private:
+        Math::uVector2 SizeOf(u32 res) const;
+        RenderTargetPool::Attachment AttachmentOf(RenderTargetPool& pool, u32 res) const;
+        Texture& TextureOf(RenderTargetPool& pool, u32 res) const;
+        void ForEachUse(const PassNode& pass, auto&& f) const {
+            for (const u32 r : pass.reads) f(r);
+            for (const u32 r : pass.colors) f(r);
+            if (pass.depth != NONE) f(pass.depth);
+        }
+    };
+}
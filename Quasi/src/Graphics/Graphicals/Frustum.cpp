@@ -0,0 +1,81 @@
+#include "Frustum.h"
+
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define QUASI_FRUSTUM_SSE 1
+#include <xmmintrin.h>
+#else
+#define QUASI_FRUSTUM_SSE 0
+#endif
+
+namespace Quasi::Graphics {
+    Frustum Frustum::FromMatrix(const Math::Matrix3D& viewProj) {
+        // row r of the matrix, the matrix is column major
+        const auto rowOf = [&] (u32 r, float out[4]) {
+            for (u32 c = 0; c < 4; ++c) out[c] = viewProj[c][r];
+        };
+        float rows[4][4];
+        for (u32 r = 0; r < 4; ++r) rowOf(r, rows[r]);
+
+        Frustum f;
+        // left right, bottom top, near far: w + x, w - x ...
+        for (u32 p = 0; p < 6; ++p) {
+            const float sign = p % 2 ? -1.0f : 1.0f;
+            const float* axis = rows[p / 2];
+            float plane[4];
+            for (u32 i = 0; i < 4; ++i) plane[i] = rows[3][i] + sign * axis[i];
+
+            const float len = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+            const float inv = len > 0 ? 1.0f / len : 0.0f;
+            f.nx[p] = plane[0] * inv; f.ny[p] = plane[1] * inv; f.nz[p] = plane[2] * inv; f.d[p] = plane[3] * inv;
+        }
+        for (u32 p = 6; p < 8; ++p) {
+            f.nx[p] = f.ny[p] = f.nz[p] = 0;
+            f.d[p] = 1;
+        }
+        return f;
+    }
+
+    CullResult Frustum::Test(const Math::fRect3D& box) const {
+        return TestCentered(box.center(), box.size() * 0.5f);
+    }
+
+    CullResult Frustum::TestCentered(const Math::fVector3& center, const Math::fVector3& extent) const {
+        // distance of the center to each plane, against how far the box reaches along the normal
+#if QUASI_FRUSTUM_SSE
+        const __m128 cx = _mm_set1_ps(center.x), cy = _mm_set1_ps(center.y), cz = _mm_set1_ps(center.z),
+                     ex = _mm_set1_ps(extent.x), ey = _mm_set1_ps(extent.y), ez = _mm_set1_ps(extent.z);
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        int outside = 0, crossing = 0;
+        for (u32 p = 0; p < 8; p += 4) {
+            const __m128 px = _mm_load_ps(nx + p), py = _mm_load_ps(ny + p), pz = _mm_load_ps(nz + p);
+            const __m128 dist = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(px, cx), _mm_mul_ps(py, cy)),
+                _mm_add_ps(_mm_mul_ps(pz, cz), _mm_load_ps(d + p)));
+            const __m128 reach = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(_mm_andnot_ps(signMask, px), ex), _mm_mul_ps(_mm_andnot_ps(signMask, py), ey)),
+                _mm_mul_ps(_mm_andnot_ps(signMask, pz), ez));
+            outside  |= _mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(dist, reach), _mm_setzero_ps()));
+            crossing |= _mm_movemask_ps(_mm_cmplt_ps(_mm_sub_ps(dist, reach), _mm_setzero_ps()));
+        }
+        if (outside) return CullResult::OUTSIDE;
+        return crossing ? CullResult::INTERSECTS : CullResult::INSIDE;
+#else
+        bool crossing = false;
+        for (u32 p = 0; p < 6; ++p) {
+            const float dist  = nx[p] * center.x + ny[p] * center.y + nz[p] * center.z + d[p];
+            const float reach = std::abs(nx[p]) * extent.x + std::abs(ny[p]) * extent.y + std::abs(nz[p]) * extent.z;
+            if (dist + reach < 0) return CullResult::OUTSIDE;
+            crossing |= dist - reach < 0;
+        }
+        return crossing ? CullResult::INTERSECTS : CullResult::INSIDE;
+#endif
+    }
+
+    bool Frustum::IsVisible(const Math::fVector3& center, float radius) const {
+        for (u32 p = 0; p < 6; ++p)
+            if (nx[p] * center.x + ny[p] * center.y + nz[p] * center.z + d[p] < -radius) return false;
+        return true;
+    }
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include "Matrix.h"
+#include "Rect.h"
+
+namespace Quasi::Graphics {
+    enum class CullResult { OUTSIDE, INTERSECTS, INSIDE };
+
+    // the 6 planes of a view projection, pointing inwards. kept as 8 planes in columns
+    // (all x, then all y ...) so boxes are tested against 4 planes at once with sse.
+    // the last 2 planes always pass
+    class Frustum {
+        alignas(16) float nx[8], ny[8], nz[8], d[8];
+    public:
+        Frustum() = default;
+        // the planes of clip space, -w <= x, y, z <= w, taken back to world space through viewProj
+        static Frustum FromMatrix(const Math::Matrix3D& viewProj);
+        static Frustum FromCamera(const Math::Matrix3D& proj, const Math::Matrix3D& view) { return FromMatrix(proj * view); }
+
+        CullResult Test(const Math::fRect3D& box) const;
+        bool IsVisible(const Math::fRect3D& box) const { return Test(box) != CullResult::OUTSIDE; }
+        bool IsVisible(const Math::fVector3& center, float radius) const;
+
+        // for boxes given as center and half size, skips the conversion
+        CullResult TestCentered(const Math::fVector3& center, const Math::fVector3& extent) const;
+    };
+}
@@ -13,6 +13,8 @@
 #include "Keyboard.h"
 
 #include "GLDebug.h"
+#include "GLStateCache.h"
+#include "ProgramCache.h"
 #include "imgui.h"
 #include "imgui_impl_glfw.h"
 #include "imgui_impl_opengl3.h"
@@ -23,6 +25,7 @@ namespace Quasi::Graphics {
         windowSize(winSize), mainWindow{ window }, ioDevice(*this) {
         Instance = *this;
         Texture::Init();
+        cameraBlock = UniformBlock<CameraBlock>::New(UniformBindings::CAMERA);
     }
 
     void GraphicsDevice::Quit() {
@@ -58,6 +61,10 @@ namespace Quasi::Graphics {
         from.mainWindow = nullptr;
 
         dest.renderOptions = from.renderOptions;
+        dest.renderQueue = std::move(from.renderQueue);
+        dest.cameraBlock = std::move(from.cameraBlock);
+        dest.shaderReloader = std::move(from.shaderReloader);
+        dest.programCache = std::move(from.programCache);
 
         dest.fontDevice = std::move(from.fontDevice);
         dest.ioDevice = std::move(from.ioDevice);
@@ -78,6 +85,8 @@ namespace Quasi::Graphics {
         ImGui::NewFrame();
 
         RenderInMode(renderOptions.renderMode);
+        cameraBlock.Bind();
+        shaderReloader.Update();
 
         ioDevice.Update();
 
@@ -91,11 +100,14 @@ namespace Quasi::Graphics {
         frameDurationTime = end - frameBeginTime;
         frameBeginTime = end;
 
+        renderQueue.Flush(*this);
         ImGui::Render();
         
         glfwPollEvents();
             
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        // imgui binds its own objects through raw gl calls
+        GLStateCache::Invalidate();
             
         glfwSwapBuffers(mainWindow);
     }
@@ -107,14 +119,17 @@ namespace Quasi::Graphics {
 
     void GraphicsDevice::DeleteRender(u32 index) {
         renders[index]->device = nullptr;
+        shaderReloader.Unwatch(renders[index]->shader);
         renders.Pop(index);
         for (u32 i = index; i < renders.Length(); ++i)
             renders[i]->deviceIndex = i;
     }
 
     void GraphicsDevice::DeleteAllRenders() {
-        for (auto& r : renders)
+        for (auto& r : renders) {
             r->device = nullptr;
+            shaderReloader.Unwatch(r->shader);
+        }
         renders.Clear();
     }
 
@@ -123,27 +138,34 @@ namespace Quasi::Graphics {
     }
 
     void GraphicsDevice::Render(RenderData& r, Shader& s, const ShaderArgs& args, bool setDefaultShaderArgs) {
+        if (s.IsNull()) return; // still being built by the shader reloader
         s.Bind();
         s.SetUniformArgs(args);
-        if (setDefaultShaderArgs) {
-            s.SetUniformMat4x4("u_projection", r.projection);
-            s.SetUniformMat4x4("u_view", r.camera);
-        }
+        if (setDefaultShaderArgs) SetCameraUniforms(r, s);
         Render::Draw(r, s);
         ++renderOptions.drawCalls;
     }
 
     void GraphicsDevice::RenderInstanced(RenderData& r, int instances, Shader& s, const ShaderArgs& args, bool setDefaultShaderArgs) {
+        if (s.IsNull()) return;
         s.Bind();
         s.SetUniformArgs(args);
-        if (setDefaultShaderArgs) {
-            s.SetUniformMat4x4("u_projection", r.projection);
-            s.SetUniformMat4x4("u_view", r.camera);
-        }
+        if (setDefaultShaderArgs) SetCameraUniforms(r, s);
         Render::DrawInstanced(r, s, instances);
         ++renderOptions.drawCalls;
     }
 
+    void GraphicsDevice::SetCameraUniforms(RenderData& r, Shader& s) {
+        if (s.UsesCameraBlock()) {
+            // renders sharing a camera pack to the same bytes, so this only reaches gl when the camera moves
+            cameraBlock.Set({ r.projection, r.camera });
+            cameraBlock.Upload();
+            return;
+        }
+        s.SetUniformMat4x4("u_projection", r.projection);
+        s.SetUniformMat4x4("u_view", r.camera);
+    }
+
     void GraphicsDevice::ClearColor(const Math::fColor& color) {
         Render::SetClearColor(color);
     }
@@ -259,10 +281,13 @@ namespace Quasi::Graphics {
             u32 vCount = 0, tCount = 0;
             for (u32 i = 0; i < renders.Length(); ++i) {
                 const RenderHandle& data = renders[i];
-                vCount += data->vbo.dataOffset;
-                tCount += data->ibo.dataOffset / 3;
+                const RenderData::DrawRange& range = data->GetDrawRange();
+                vCount += range.vertexCount;
+                tCount += range.indexCount / 3;
                 if (ImGui::TreeNode((const void*)(intptr_t)i, "Render #%d", i)) {
-                    ImGui::Text("%d Vertices, %d Triangles", data->vbo.dataOffset, data->ibo.dataOffset / 3);
+                    ImGui::Text("%d Vertices, %d Triangles", range.vertexCount, range.indexCount / 3);
+                    if (data->IsStreaming())
+                        ImGui::Text("Streaming: %d stalls, %d grows", data->StreamStalls(), data->StreamGrows());
                     ImGui::Unindent();
 
                     ImGui::TreePop();
@@ -270,6 +295,29 @@ namespace Quasi::Graphics {
             }
             ImGui::Text("Total: %d Vertices, %d Triangles", vCount, tCount);
             ImGui::Text("Draw Calls: %d", renderOptions.drawCalls);
+            const RenderQueue::Stats& queueStats = renderQueue.GetLastStats();
+            ImGui::Text("Render Queue: %d items in %d draws, %d shader binds, %d texture binds, %d vao binds",
+                queueStats.submitted, queueStats.drawCalls, queueStats.shaderBinds, queueStats.textureBinds, queueStats.vaoBinds);
+            ImGui::Text("Camera Block: %d uploads, %d skipped",
+                cameraBlock.Buffer().UploadCount(), cameraBlock.Buffer().SkipCount());
+            ImGui::Text("Shader Reloader: %zu watched, %d building, %d failed",
+                shaderReloader.WatchCount(), shaderReloader.InFlightCount(), shaderReloader.FailureCount());
+            if (programCache.IsEnabled()) {
+                const ProgramCache::Stats& cacheStats = programCache.GetStats();
+                ImGui::Text("Program Cache: %d hits, %d misses, %d rejected, %d stored",
+                    cacheStats.hits, cacheStats.misses, cacheStats.rejected, cacheStats.stores);
+            }
+
+            if (ImGui::TreeNode("State Cache")) {
+                for (int c = 0; c < GLStateCache::CATEGORY_COUNT; ++c) {
+                    const auto category = (GLStateCache::Category)c;
+                    const GLStateCache::Counter& counter = GLStateCache::GetCounter(category);
+                    ImGui::Text("%s: %llu hits, %llu misses", GLStateCache::CategoryName(category).Data(),
+                        (unsigned long long)counter.hits, (unsigned long long)counter.misses);
+                }
+                if (ImGui::Button("Reset Counters")) GLStateCache::ResetCounters();
+                ImGui::TreePop();
+            }
             ImGui::EndTabItem();
         }
 
@@ -1,6 +1,10 @@
 ﻿#pragma once
 
 #include "Render.h"
+#include "RenderQueue.h"
+#include "ProgramCache.h"
+#include "ShaderReloader.h"
+#include "UniformBuffer.h"
 
 #include "IO.h"
 #include "Timer.h"
@@ -26,6 +30,10 @@ namespace Quasi::Graphics {
             u32 drawCalls;
         } renderOptions;
 
+        RenderQueue renderQueue;
+        UniformBlock<CameraBlock> cameraBlock;
+        ShaderReloader shaderReloader;
+        ProgramCache programCache;
         FontDevice fontDevice = {};
         IO::IO ioDevice { *this };
         Math::RandomGenerator randDevice {};
@@ -78,6 +86,14 @@ namespace Quasi::Graphics {
         GLFWwindow* GetWindow() { return mainWindow; }
         const GLFWwindow* GetWindow() const { return mainWindow; }
 
+        // anything submitted here is sorted, batched and drawn at End
+        RenderQueue& GetRenderQueue() { return renderQueue; }
+        // async shader loading and hot reload, polled at the start of every frame
+        ShaderReloader& GetShaderReloader() { return shaderReloader; }
+        // linked programs kept on disk, off until enabled
+        ProgramCache& GetProgramCache() { return programCache; }
+        const ProgramCache& GetProgramCache() const { return programCache; }
+
         FontDevice& GetFontDevice() { return fontDevice; }
         const FontDevice& GetFontDevice() const { return fontDevice; }
 
@@ -87,8 +103,11 @@ namespace Quasi::Graphics {
         void DebugMenu();
     private:
         void ShowDebugWindow();
+        // uploads the camera of the render, either into the camera block or as plain uniforms
+        void SetCameraUniforms(RenderData& r, Shader& s);
     public:
 
+        static bool HasInstance() { return Instance.HasValue(); }
         static GraphicsDevice& GetDeviceInstance() { return *Instance; }
         static GLFWwindow* GetMainWindow() { return Instance->mainWindow; }
 
@@ -100,6 +119,7 @@ namespace Quasi::Graphics {
         static GraphicsDevice Initialize(Math::iVector2 winSize = { 640, 480 });
 
         friend class Texture;
+        friend class RenderQueue;
     };
 
     template <class T>
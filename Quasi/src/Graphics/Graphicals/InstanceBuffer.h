@@ -0,0 +1,70 @@
+#pragma once
+#include "RenderData.h"
+
+namespace Quasi::Graphics {
+    // per instance attributes, read by the shader as plain inputs placed after the vertex ones.
+    // every write orphans the buffer first, so the driver hands out fresh storage instead of
+    // waiting on draws that still read last frame's data. there is no limit like a uniform array has
+    template <IInstance I>
+    class InstanceBuffer {
+        VertexBuffer vbo;
+        u32 capacity = 0, count = 0;
+        bool mapped = false;
+
+        InstanceBuffer(VertexBuffer buffer, u32 cap) : vbo(std::move(buffer)), capacity(cap) {}
+    public:
+        InstanceBuffer() = default;
+        // attaches to the vertex array of rd, at the first location after its vertex attributes
+        static InstanceBuffer New(RenderData& rd, u32 capacity = 1024);
+
+        // one buffer write for the whole frame
+        void Upload(Span<const I> instances);
+        void Upload(const ContinuousCollection<I> auto& instances) { Upload(instances.AsSpan()); }
+        // writes straight into the buffer instead, the span is only valid until Unmap
+        Span<I> Map(u32 instanceCount);
+        void Unmap();
+
+        u32 Count() const { return count; }
+        u32 Capacity() const { return capacity; }
+        bool IsMapped() const { return mapped; }
+    private:
+        void Orphan(u32 instanceCount);
+    };
+
+    template <IInstance I>
+    InstanceBuffer<I> InstanceBuffer<I>::New(RenderData& rd, u32 capacity) {
+        InstanceBuffer ib { VertexBuffer::New(capacity * sizeof(I)), capacity };
+        rd.varray.AddInstanceBuffer(ib.vbo, I::INSTANCE_LAYOUT, rd.AttributeCount());
+        return ib;
+    }
+
+    template <IInstance I>
+    void InstanceBuffer<I>::Orphan(u32 instanceCount) {
+        if (instanceCount > capacity) capacity = std::max(instanceCount, capacity * 2);
+        // same buffer object, so the vertex array still points at it
+        vbo.Resize(capacity * sizeof(I));
+        count = instanceCount;
+    }
+
+    template <IInstance I>
+    void InstanceBuffer<I>::Upload(Span<const I> instances) {
+        Orphan(instances.Length());
+        if (count) vbo.SetDataBytes(instances.AsBytes());
+    }
+
+    template <IInstance I>
+    Span<I> InstanceBuffer<I>::Map(u32 instanceCount) {
+        Orphan(instanceCount);
+        if (!count) return {};
+        // the storage was just orphaned, nothing in flight can be reading it
+        mapped = true;
+        return Span<I>::Slice(Memory::TransmutePtr<I>(vbo.MapRange(0, count * sizeof(I))), count);
+    }
+
+    template <IInstance I>
+    void InstanceBuffer<I>::Unmap() {
+        if (!mapped) return;
+        vbo.Unmap();
+        mapped = false;
+    }
+}
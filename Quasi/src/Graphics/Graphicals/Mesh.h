@@ -35,7 +35,16 @@ namespace Quasi::Graphics {
         Mesh& Rotate(RotationAngles rot)   { modelTransform.Rotate(rot);       return *this; }
         Mesh& Rotate(const Rotation& rot)  { modelTransform.Rotate(rot);       return *this; }
 
+        // boxes around the vertex positions, 2d meshes lie flat at z = 0.
+        // the world one is the local box put through the model transform, so it can be a bit loose
+        Math::fRect3D LocalBounds() const;
+        Math::fRect3D WorldBounds() const;
+        // a box put through a model transform, for when the local one is kept around
+        static Math::fRect3D TransformBounds(const Math::fRect3D& local, const Transform& modelTransform);
+
         void AddTo(RenderData& rd) const;
+        // writes the transformed vertices and the indices offset by baseVertex, enough space is expected
+        void WriteTo(byte* vertexOut, u32* indexOut, u32 baseVertex) const;
 
         void PushVertex(const Vtx& v) { vertices.Push(v); }
         void PushIndex(TriIndices i) { indices.Push(i); }
@@ -1,31 +1,123 @@
 #pragma once
 #include <ranges>
 
+#include "Utils/WorkerPool.h"
+
 namespace Quasi::Graphics {
     template <IVertex Vtx> Mesh<Vtx>& Mesh<Vtx>::EmbedTransform() {
-        for (auto& v : vertices) {
-            v = VertexMul(v, modelTransform);
-        }
+        VertexMulBatch(vertices.Data(), Memory::TransmutePtr<byte>(vertices.Data()), vertices.Length(), modelTransform);
         modelTransform = {};
         return *this;
     }
 
 
+    template <IVertex Vtx>
+    Math::fRect3D Mesh<Vtx>::LocalBounds() const {
+        Math::fRect3D box = Math::fRect3D::unrange();
+        for (const Vtx& v : vertices) {
+            if constexpr (Vtx::DIMENSION == 2) box = box.expand_until(v.Position.with_z(0));
+            else                               box = box.expand_until(v.Position);
+        }
+        return vertices.IsEmpty() ? Math::fRect3D::empty() : box;
+    }
+
+    template <IVertex Vtx>
+    Math::fRect3D Mesh<Vtx>::TransformBounds(const Math::fRect3D& local, const Transform& modelTransform) {
+        Math::Matrix3D model;
+        if constexpr (Vtx::DIMENSION == 2) model = modelTransform.As3D().TransformMatrix();
+        else                               model = modelTransform.TransformMatrix();
+
+        // each column adds its smallest and largest contribution (arvo's method), the same as the 8 corners
+        Math::fVector3 min = model.translation(), max = min;
+        for (u32 c = 0; c < 3; ++c) {
+            for (u32 r = 0; r < 3; ++r) {
+                const float a = model[c][r] * local.min[c], b = model[c][r] * local.max[c];
+                min[r] += std::min(a, b);
+                max[r] += std::max(a, b);
+            }
+        }
+        return { min, max };
+    }
+
+    template <IVertex Vtx>
+    Math::fRect3D Mesh<Vtx>::WorldBounds() const {
+        return TransformBounds(LocalBounds(), modelTransform);
+    }
+
     template <IVertex Vtx>
     void Mesh<Vtx>::AddTo(RenderData& rd) const {
-        rd.PushIndicesOffseted(indices, sizeof(Vtx));
+        rd.Reserve(vertices.Length() * sizeof(Vtx), indices.Length() * 3);
+        WriteTo(rd.vertexWrite + rd.vertexOffset, rd.indexWrite + rd.indexOffset, rd.vertexOffset / sizeof(Vtx));
+        rd.vertexOffset += vertices.Length() * sizeof(Vtx);
+        rd.indexOffset  += indices.Length() * 3;
+    }
 
-        for (const Vtx& v : vertices) {
-            rd.PushVertex(VertexMul(v, modelTransform));
+    template <IVertex Vtx>
+    void Mesh<Vtx>::WriteTo(byte* vertexOut, u32* indexOut, u32 baseVertex) const {
+        VertexMulBatch(vertices.Data(), vertexOut, vertices.Length(), modelTransform);
+        for (const TriIndices& t : indices) {
+            *indexOut++ = t.i + baseVertex;
+            *indexOut++ = t.j + baseVertex;
+            *indexOut++ = t.k + baseVertex;
         }
     }
 
+    template <IVertex T, class MeshAt>
+    void RenderData::AddParallelWith(usize count, MeshAt meshAt) {
+        // prefix sums, mesh m owns vertices [starts[2m], starts[2m + 2]) and indices [starts[2m + 1], starts[2m + 3]).
+        // kept between calls, so drawing the same batch every frame doesnt allocate
+        Vec<u32>& starts = parallelStarts;
+        starts.Clear();
+        starts.Reserve(count * 2 + 2);
+        u32 vertexCount = 0, indexCount = 0;
+        for (usize m = 0; m < count; ++m) {
+            starts.Push(vertexCount);
+            starts.Push(indexCount);
+            vertexCount += meshAt(m).vertices.Length();
+            indexCount  += meshAt(m).indices.Length() * 3;
+        }
+
+        // growing can move the buffers (or remap them when streaming), so it all happens before the pointers are taken
+        Reserve(vertexCount * sizeof(T), indexCount);
+        byte* const vertexOut = vertexWrite + vertexOffset;
+        u32*  const indexOut  = indexWrite  + indexOffset;
+        const u32 baseVertex = vertexOffset / sizeof(T);
+
+        auto build = [&] (usize begin, usize end) {
+            for (usize m = begin; m < end; ++m)
+                meshAt(m).WriteTo(vertexOut + starts[m * 2] * sizeof(T), indexOut + starts[m * 2 + 1], baseVertex + starts[m * 2]);
+        };
+        if (vertexCount < PARALLEL_MIN_VERTICES) {
+            build(0, count);
+        } else {
+            // roughly a thousand vertices per chunk
+            const usize minChunk = std::max<usize>(1, count * 1024 / vertexCount);
+            WorkerPool::Global().ParallelFor(count, minChunk, build);
+        }
+
+        vertexOffset += vertexCount * sizeof(T);
+        indexOffset  += indexCount;
+    }
+
+    template <IVertex T>
+    void RenderData::AddParallel(Span<const Mesh<T>> meshes) {
+        AddParallelWith<T>(meshes.Length(), [&] (usize m) -> const Mesh<T>& { return meshes[m]; });
+    }
+
+    template <IVertex T>
+    void RenderData::AddParallel(Span<const Mesh<T>* const> meshes) {
+        AddParallelWith<T>(meshes.Length(), [&] (usize m) -> const Mesh<T>& { return *meshes[m]; });
+    }
+
     template <IVertex Vtx>
     Mesh<Vtx>& Mesh<Vtx>::Add(const Mesh& m) {
+        const u32 begin = vertices.Length();
         auto batch = NewBatch();
-        batch.PushSpan(m.vertices.Iter().Map([&] (const Vtx& v) {
-            return VertexMul(VertexMul(v, m.modelTransform), modelTransform.Inverse());
-        }), m.indices);
+        batch.PushSpan(m.vertices, m.indices);
+        // into world space as one batch, then back into this mesh's space
+        byte* added = Memory::TransmutePtr<byte>(vertices.Data() + begin);
+        VertexMulBatch(vertices.Data() + begin, added, m.vertices.Length(), m.modelTransform);
+        VertexMulBatch(vertices.Data() + begin, added, m.vertices.Length(), modelTransform.Inverse());
         return *this;
     }
 
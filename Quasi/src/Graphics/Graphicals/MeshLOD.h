@@ -0,0 +1,105 @@
+#pragma once
+#include <cmath>
+
+#include "CameraController.h"
+#include "Mesh.h"
+#include "Meshes/MeshOptimizer.h"
+
+namespace Quasi::Graphics {
+    // what the camera sees, for turning the error of a level into pixels on screen
+    struct LODSelector {
+        Math::fVector3 eye;
+        float pixelsPerUnit = 0; // how many pixels one unit covers at a distance of one unit
+        float maxPixelError = 1.0f;
+
+        static LODSelector Perspective(const Math::fVector3& eye, float fovDeg, float screenHeight, float maxPixelError = 1.0f) {
+            return { eye, screenHeight / (2 * std::tan(fovDeg * Math::DEG2RAD * 0.5f)), maxPixelError };
+        }
+        static LODSelector FromCamera(const CameraController& camera, float screenHeight, float maxPixelError = 1.0f) {
+            return Perspective(camera.position, camera.viewFov, screenHeight, maxPixelError);
+        }
+
+        float Distance(const Math::fRect3D& worldBounds) const { return (worldBounds.clamp(eye) - eye).len(); }
+        // the eye inside the box counts as right up against it, so the finest level is used
+        float ProjectedError(float worldError, const Math::fRect3D& worldBounds) const {
+            return worldError * pixelsPerUnit / std::max(Distance(worldBounds), 1e-4f);
+        }
+    };
+
+    // a mesh and simpler versions of it, each one about half the triangles of the one before, made by
+    // MeshOptimizer::Simplify. every level knows how far it strays from the full mesh (in model units),
+    // Select picks the coarsest one that strays less than maxPixelError pixels where the mesh is on screen
+    template <IVertex T> requires (T::DIMENSION == 3)
+    class MeshLOD {
+    public:
+        struct Level {
+            Mesh<T> mesh;
+            float error = 0;
+        };
+
+        struct Options {
+            u32 maxLevels = 5;
+            float reduction = 0.5f;  // triangles of a level compared to the one before
+            u32 minTriangles = 32;
+            float maxError = 0.1f;   // of the mesh size, levels past this arent made
+        };
+    private:
+        Vec<Level> levels;
+        Math::fRect3D localBounds;
+    public:
+        MeshLOD() = default;
+        static MeshLOD Build(const Mesh<T>& mesh, const Options& options = {});
+
+        u32 SelectLevel(const LODSelector& selector) const;
+        const Mesh<T>& Select(const LODSelector& selector) const { return levels[SelectLevel(selector)].mesh; }
+        // the chosen level of each, appended to out for RenderObject::Draw
+        static void SelectAll(Span<const MeshLOD> lods, const LODSelector& selector, Vec<const Mesh<T>*>& out) {
+            for (const MeshLOD& lod : lods) out.Push(&lod.Select(selector));
+        }
+
+        // moves every level together
+        void SetTransform(const Math::Transform3D& model) { for (Level& l : levels) l.mesh.SetTransform(model); }
+        const Math::Transform3D& GetTransform() const { return levels[0].mesh.modelTransform; }
+        Math::fRect3D WorldBounds() const { return Mesh<T>::TransformBounds(localBounds, GetTransform()); }
+
+        u32 LevelCount() const { return levels.Length(); }
+        const Level& GetLevel(u32 i) const { return levels[i]; }
+        const Mesh<T>& GetMesh(u32 i) const { return levels[i].mesh; }
+        const Mesh<T>& Full() const { return levels[0].mesh; }
+    };
+
+    template <IVertex T> requires (T::DIMENSION == 3)
+    MeshLOD<T> MeshLOD<T>::Build(const Mesh<T>& mesh, const Options& options) {
+        MeshLOD lod;
+        lod.localBounds = mesh.LocalBounds();
+        const Math::fVector3 size = lod.localBounds.size();
+        const float extent = std::max({ size.x, size.y, size.z });
+        lod.levels.Push({ mesh, 0 });
+
+        // each level is made from the one before, their errors add up to a bound from the full mesh
+        float relativeError = 0;
+        while (lod.levels.Length() < options.maxLevels) {
+            const Mesh<T>& last = lod.levels.Last().mesh;
+            const u32 target = (u32)((float)last.indices.Length() * options.reduction);
+            if (target < options.minTriangles) break;
+
+            float stepError = 0;
+            Mesh<T> next = MeshOptimizer::Simplified(last, target, options.maxError - relativeError, stepError);
+            // stuck on seams and borders, or out of error, the level wouldnt save much
+            if ((float)next.indices.Length() > (float)last.indices.Length() * (1 + options.reduction) * 0.5f) break;
+            relativeError += stepError;
+            lod.levels.Push({ std::move(next), relativeError * extent });
+        }
+        return lod;
+    }
+
+    template <IVertex T> requires (T::DIMENSION == 3)
+    u32 MeshLOD<T>::SelectLevel(const LODSelector& selector) const {
+        const Math::Transform3D& model = GetTransform();
+        const float scale = std::max({ std::abs(model.scale.x), std::abs(model.scale.y), std::abs(model.scale.z) });
+        const Math::fRect3D bounds = WorldBounds();
+        for (u32 i = levels.Length(); i --> 1;)
+            if (selector.ProjectedError(levels[i].error * scale, bounds) <= selector.maxPixelError) return i;
+        return 0;
+    }
+}
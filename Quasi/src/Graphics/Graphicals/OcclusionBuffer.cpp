@@ -0,0 +1,121 @@
+#include "OcclusionBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define QUASI_OCCLUSION_SSE 1
+#include <xmmintrin.h>
+#else
+#define QUASI_OCCLUSION_SSE 0
+#endif
+
+namespace Quasi::Graphics {
+    namespace {
+        // anything this close to the eye counts as crossing the near plane
+        constexpr float MIN_W = 1e-5f;
+    }
+
+    OcclusionBuffer OcclusionBuffer::New(u32 width, u32 height) {
+        return { std::max(width, 1u), std::max(height, 1u) };
+    }
+
+    void OcclusionBuffer::Clear(const Math::Matrix3D& viewProjection) {
+        viewProj = viewProjection;
+        for (float& z : depth) z = 1.0f;
+        stats = {};
+    }
+
+    Math::fVector3 OcclusionBuffer::ToScreen(const Math::fVector4& clip) const {
+        const float invW = 1.0f / clip.w;
+        return {
+            (clip.x * invW * 0.5f + 0.5f) * (float)width,
+            (clip.y * invW * 0.5f + 0.5f) * (float)height,
+            clip.z * invW * 0.5f + 0.5f,
+        };
+    }
+
+    void OcclusionBuffer::AddOccluder(Span<const Math::fVector3> worldPositions, Span<const TriIndices> triangles) {
+        AddOccluder(Memory::TransmutePtr<const byte>(worldPositions.Data()), worldPositions.Length(),
+                    sizeof(Math::fVector3), triangles, Math::Matrix3D::identity());
+    }
+
+    void OcclusionBuffer::AddOccluder(const byte* positions, usize count, usize stride, Span<const TriIndices> triangles, const Math::Matrix3D& model) {
+        const Math::Matrix3D mvp = viewProj * model;
+        const auto clipOf = [&] (u32 i) {
+            Math::fVector3 p;
+            Memory::MemCopyNoOverlap(Memory::TransmutePtr<byte>(&p), positions + i * stride, sizeof(p));
+            return mvp * p.extend(1.0f);
+        };
+
+        for (const TriIndices& tri : triangles) {
+            if (tri.i >= count || tri.j >= count || tri.k >= count) continue;
+            const Math::fVector4 a = clipOf(tri.i), b = clipOf(tri.j), c = clipOf(tri.k);
+            if (a.w < MIN_W || b.w < MIN_W || c.w < MIN_W) continue;
+            RasterizeTriangle(ToScreen(a), ToScreen(b), ToScreen(c));
+            ++stats.occluderTris;
+        }
+    }
+
+    void OcclusionBuffer::RasterizeTriangle(const Math::fVector3& a, const Math::fVector3& b, const Math::fVector3& c) {
+        const float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+        if (std::abs(area) < 1e-8f) return;
+        const float invArea = 1.0f / area;
+
+        const i32 x0 = std::max((i32)std::floor(std::min({ a.x, b.x, c.x })), 0),
+                  x1 = std::min((i32)std::ceil (std::max({ a.x, b.x, c.x })), (i32)width),
+                  y0 = std::max((i32)std::floor(std::min({ a.y, b.y, c.y })), 0),
+                  y1 = std::min((i32)std::ceil (std::max({ a.y, b.y, c.y })), (i32)height);
+
+        // edge functions at pixel centers, either winding is an occluder
+        for (i32 y = y0; y < y1; ++y) {
+            const float py = (float)y + 0.5f;
+            float* row = depth.Data() + (usize)y * width;
+            for (i32 x = x0; x < x1; ++x) {
+                const float px = (float)x + 0.5f;
+                const float wa = ((b.x - px) * (c.y - py) - (b.y - py) * (c.x - px)) * invArea,
+                            wb = ((c.x - px) * (a.y - py) - (c.y - py) * (a.x - px)) * invArea,
+                            wc = 1.0f - wa - wb;
+                if (wa < 0 || wb < 0 || wc < 0) continue;
+                // z over w is linear on screen, so the plain weights work
+                const float z = wa * a.z + wb * b.z + wc * c.z;
+                if (z >= 0 && z < row[x]) row[x] = z;
+            }
+        }
+    }
+
+    bool OcclusionBuffer::IsVisible(const Math::fRect3D& box) {
+        ++stats.tested;
+        Math::fVector2 lo = { (float)width, (float)height }, hi = { 0, 0 };
+        float nearest = 1.0f;
+        for (usize i = 0; i < 8; ++i) {
+            const Math::fVector4 clip = viewProj * box.corner(i).extend(1.0f);
+            // the box reaches behind the eye, nothing in front of it can cover all of it
+            if (clip.w < MIN_W) return true;
+            const Math::fVector3 s = ToScreen(clip);
+            lo = { std::min(lo.x, s.x), std::min(lo.y, s.y) };
+            hi = { std::max(hi.x, s.x), std::max(hi.y, s.y) };
+            nearest = std::min(nearest, s.z);
+        }
+        if (nearest < 0) return true;
+
+        const i32 x0 = std::max((i32)std::floor(lo.x), 0), x1 = std::min((i32)std::ceil(hi.x), (i32)width),
+                  y0 = std::max((i32)std::floor(lo.y), 0), y1 = std::min((i32)std::ceil(hi.y), (i32)height);
+        // offscreen, the frustum test deals with that
+        if (x0 >= x1 || y0 >= y1) return true;
+
+        for (i32 y = y0; y < y1; ++y) {
+            const float* row = depth.Data() + (usize)y * width;
+            i32 x = x0;
+#if QUASI_OCCLUSION_SSE
+            const __m128 near4 = _mm_set1_ps(nearest);
+            for (; x + 4 <= x1; x += 4)
+                if (_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(row + x), near4))) return true;
+#endif
+            for (; x < x1; ++x)
+                if (row[x] >= nearest) return true;
+        }
+        ++stats.occluded;
+        return false;
+    }
+}
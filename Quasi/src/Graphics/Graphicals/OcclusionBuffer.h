@@ -0,0 +1,51 @@
+#pragma once
+#include "Matrix.h"
+#include "Mesh.h"
+
+namespace Quasi::Graphics {
+    // a small depth buffer drawn on the cpu from a few big occluders (walls, terrain), so boxes
+    // hidden behind them can be skipped before anything is sent to the gpu.
+    // depth is the ndc z mapped to [0, 1], each pixel keeps the nearest occluder
+    class OcclusionBuffer {
+        Vec<float> depth;
+        u32 width = 0, height = 0;
+        Math::Matrix3D viewProj;
+    public:
+        struct Stats {
+            u32 occluderTris = 0, tested = 0, occluded = 0;
+        };
+    private:
+        Stats stats;
+
+        OcclusionBuffer(u32 w, u32 h) : width(w), height(h) { depth.Resize(w * h, 1.0f); }
+    public:
+        OcclusionBuffer() = default;
+        // a few hundred pixels across is plenty, the test only needs to be conservative
+        static OcclusionBuffer New(u32 width = 256, u32 height = 128);
+
+        // starts a frame, every pixel is as far as it can be
+        void Clear(const Math::Matrix3D& viewProjection);
+
+        // triangles crossing the near plane are left out, leaving out occluders can only keep more visible
+        void AddOccluder(Span<const Math::fVector3> worldPositions, Span<const TriIndices> triangles);
+        // positions are read stride bytes apart and go through model first
+        void AddOccluder(const byte* positions, usize count, usize stride, Span<const TriIndices> triangles, const Math::Matrix3D& model);
+        template <IVertex T> void AddOccluder(const Mesh<T>& mesh) requires (T::DIMENSION == 3) {
+            if (mesh.vertices.IsEmpty()) return;
+            AddOccluder(Memory::TransmutePtr<const byte>(&mesh.vertices[0].Position), mesh.vertices.Length(), sizeof(T),
+                        mesh.indices.AsSpan(), mesh.modelTransform.TransformMatrix());
+        }
+
+        // false if every pixel the box covers has an occluder nearer than the box
+        bool IsVisible(const Math::fRect3D& box);
+
+        u32 Width() const { return width; }
+        u32 Height() const { return height; }
+        Span<const float> Depths() const { return depth.AsSpan(); }
+        const Stats& GetStats() const { return stats; }
+    private:
+        void RasterizeTriangle(const Math::fVector3& a, const Math::fVector3& b, const Math::fVector3& c);
+        // clip space to pixel x, pixel y and depth
+        Math::fVector3 ToScreen(const Math::fVector4& clip) const;
+    };
+}
@@ -1,15 +1,40 @@
 #include "RenderData.h"
+
+#include <algorithm>
+#include <bit>
+#include <glp.h>
+
 #include "GraphicsDevice.h"
+#include "GLDebug.h"
 
 namespace Quasi::Graphics {
 	void RenderData::Transfer(RenderData& dest, RenderData&& from) {
+		if (&dest == &from) return;
+		// the stream of dest goes away with its buffers
+		if (dest.stream.mapped) { dest.vbo.Unmap(); dest.ibo.Unmap(); }
+		dest.ReleaseFences();
+
 		dest.varray = std::move(from.varray);
 		dest.vbo = std::move(from.vbo);
 		dest.ibo = std::move(from.ibo);
 		dest.vertexData = std::move(from.vertexData);
 		dest.indexData = std::move(from.indexData);
+		dest.vertexWrite = from.vertexWrite;
 		dest.vertexOffset = from.vertexOffset;
+		dest.vertexCapacity = from.vertexCapacity;
+		dest.indexWrite = from.indexWrite;
 		dest.indexOffset = from.indexOffset;
+		dest.indexCapacity = from.indexCapacity;
+		dest.vertexSize = from.vertexSize;
+		dest.attributeCount = from.attributeCount;
+		dest.drawRange = from.drawRange;
+		dest.fills = from.fills;
+		dest.queuedFill = from.queuedFill;
+		dest.parallelStarts = std::move(from.parallelStarts);
+
+		// the fences now belong to dest
+		dest.stream = from.stream;
+		from.stream = {};
 
 		dest.device = from.device;
 		from.device = nullptr;
@@ -18,22 +43,187 @@ namespace Quasi::Graphics {
 	}
 
 	RenderData::~RenderData() {
+		ReleaseFences();
 		Destroy();
 	}
 
 	void RenderData::PushIndex(TriIndices index) {
-		indexData[indexOffset + 0] = index.i;
-		indexData[indexOffset + 1] = index.j;
-		indexData[indexOffset + 2] = index.k;
+		if (indexOffset + 3 > indexCapacity) [[unlikely]] GrowIndices(indexOffset + 3);
+		indexWrite[indexOffset + 0] = index.i;
+		indexWrite[indexOffset + 1] = index.j;
+		indexWrite[indexOffset + 2] = index.k;
 		indexOffset += 3;
 	}
 
 	void RenderData::PushIndicesOffseted(Span<const TriIndices> indices, usize objectSize) {
+		Reserve(0, indices.Length() * 3);
 		const u32 iOff = vertexOffset / objectSize;
 		for (const auto& i : indices)
 			PushIndex(i + iOff);
 	}
 
+	void RenderData::GrowVertices(usize minBytes) {
+		if (IsStreaming()) {
+			if (!stream.mapped) BeginStreamFrame();
+			if (minBytes <= vertexCapacity) return;
+
+			// the old storage is orphaned, so the ring restarts at region 0 with nothing in flight
+			const u32 region = (u32)std::max<usize>(minBytes, 2 * stream.vertexRegion);
+			const u32 vstart = stream.current * stream.vertexRegion, istart = stream.current * stream.indexRegion;
+			vbo.Unmap(); ibo.Unmap();
+			// only the region being written survives the resize
+			FlushQueued();
+			ReleaseFences();
+			stream.vertexRegion = (region + vertexSize - 1) / vertexSize * vertexSize;
+			vbo.Resize(stream.vertexRegion * stream.frames, vstart, (u32)vertexOffset);
+			ibo.Resize(stream.indexRegion  * stream.frames, istart, (u32)indexOffset);
+			stream.current = 0;
+			++stream.grows;
+
+			vertexWrite = vbo.MapRange(0, stream.vertexRegion, false);
+			indexWrite  = ibo.MapRange(0, stream.indexRegion,  false);
+			vertexCapacity = stream.vertexRegion;
+			return;
+		}
+
+		const usize capacity = std::max(minBytes, 2 * vertexCapacity);
+		ArrayBox<byte> grown = ArrayBox<byte>::AllocateUninit(capacity);
+		Memory::MemCopyNoOverlap(grown.Data(), vertexData.Data(), vertexOffset);
+		vertexData = std::move(grown);
+		vertexWrite = vertexData.Data();
+		vertexCapacity = capacity;
+	}
+
+	void RenderData::GrowIndices(usize minCount) {
+		if (IsStreaming()) {
+			if (!stream.mapped) BeginStreamFrame();
+			if (minCount <= indexCapacity) return;
+
+			const u32 region = (u32)std::max<usize>(minCount, 2 * stream.indexRegion);
+			const u32 vstart = stream.current * stream.vertexRegion, istart = stream.current * stream.indexRegion;
+			vbo.Unmap(); ibo.Unmap();
+			FlushQueued();
+			ReleaseFences();
+			stream.indexRegion = region;
+			vbo.Resize(stream.vertexRegion * stream.frames, vstart, (u32)vertexOffset);
+			ibo.Resize(stream.indexRegion  * stream.frames, istart, (u32)indexOffset);
+			stream.current = 0;
+			++stream.grows;
+
+			vertexWrite = vbo.MapRange(0, stream.vertexRegion, false);
+			indexWrite  = ibo.MapRange(0, stream.indexRegion,  false);
+			indexCapacity = stream.indexRegion;
+			return;
+		}
+
+		const usize capacity = std::max(minCount, 2 * indexCapacity);
+		ArrayBox<u32> grown = ArrayBox<u32>::AllocateUninit(capacity);
+		Memory::MemCopyNoOverlap(grown.Data(), indexData.Data(), indexOffset * sizeof(u32));
+		indexData = std::move(grown);
+		indexWrite = indexData.Data();
+		indexCapacity = capacity;
+	}
+
+	void RenderData::EnableStreaming(u32 frames) {
+		FlushQueued();
+		if (IsStreaming()) DisableStreaming();
+		frames = std::clamp(frames, 2u, MAX_STREAM_FRAMES);
+
+		stream = { .frames = frames, .current = frames - 1 };
+		stream.vertexRegion = (u32)vertexCapacity;
+		stream.indexRegion  = (u32)indexCapacity;
+		vbo.Resize(stream.vertexRegion * frames);
+		ibo.Reformat(stream.indexRegion * frames, GLTypeID::UINT);
+
+		// nothing is writable until the first BufferUnload maps a region
+		vertexWrite = nullptr; vertexCapacity = 0; vertexOffset = 0;
+		indexWrite  = nullptr; indexCapacity  = 0; indexOffset  = 0;
+		drawRange = {};
+	}
+
+	void RenderData::DisableStreaming() {
+		if (!IsStreaming()) return;
+		FlushQueued();
+		if (stream.mapped) { vbo.Unmap(); ibo.Unmap(); }
+		ReleaseFences();
+
+		if (vertexData.Length() < stream.vertexRegion) vertexData = ArrayBox<byte>::AllocateUninit(stream.vertexRegion);
+		if (indexData .Length() < stream.indexRegion)  indexData  = ArrayBox<u32> ::AllocateUninit(stream.indexRegion);
+		vbo.Resize((u32)vertexData.Length());
+		ibo.Reformat((u32)indexData.Length(), IndexBuffer::TypeFor(vertexData.Length() / vertexSize));
+
+		vertexWrite = vertexData.Data(); vertexCapacity = vertexData.Length(); vertexOffset = 0;
+		indexWrite  = indexData.Data();  indexCapacity  = indexData.Length();  indexOffset  = 0;
+		stream = {};
+		drawRange = {};
+	}
+
+	void RenderData::BeginStreamFrame() {
+		if (stream.mapped) return;
+
+		// everything drawn right away from the current region has been issued by now,
+		// if some of its draws are still queued the queue fences it once it issued them
+		if (!(stream.queuedRegions & 1u << stream.current)) FenceRegion(stream.current);
+		stream.current = (stream.current + 1) % stream.frames;
+
+		// the ring came back around to a region the queue still has to draw from
+		if (stream.queuedRegions & 1u << stream.current) FlushQueued();
+		if (GL::Sync fence = (GL::Sync)stream.fences[stream.current]) {
+			GL::Enum status = QGLCall$(GL::ClientWaitSync(fence, GL::SYNC_FLUSH_COMMANDS_BIT, 0));
+			if (status == GL::TIMEOUT_EXPIRED) {
+				++stream.stalls;
+				while (status == GL::TIMEOUT_EXPIRED)
+					status = QGLCall$(GL::ClientWaitSync(fence, 0, 1'000'000));
+			}
+			QGLCall$(GL::DeleteSync(fence));
+			stream.fences[stream.current] = nullptr;
+		}
+
+		vertexWrite = vbo.MapRange(stream.current * stream.vertexRegion, stream.vertexRegion);
+		indexWrite  = ibo.MapRange(stream.current * stream.indexRegion,  stream.indexRegion);
+		vertexCapacity = stream.vertexRegion;
+		indexCapacity  = stream.indexRegion;
+		vertexOffset = 0;
+		indexOffset = 0;
+		stream.mapped = true;
+	}
+
+	void RenderData::EndStreamFrame() {
+		if (!stream.mapped) return;
+		vbo.Unmap();
+		ibo.Unmap();
+		vertexWrite = nullptr; vertexCapacity = 0;
+		indexWrite  = nullptr; indexCapacity  = 0;
+		stream.mapped = false;
+
+		drawRange = {
+			.indexCount  = (u32)indexOffset,
+			.firstIndex  = stream.current * stream.indexRegion,
+			.baseVertex  = stream.current * stream.vertexRegion / vertexSize,
+			.vertexCount = (u32)(vertexOffset / vertexSize),
+		};
+	}
+
+	void RenderData::FenceRegion(u32 region) {
+		// a later fence covers everything the earlier one did
+		if (stream.fences[region]) QGLCall$(GL::DeleteSync((GL::Sync)stream.fences[region]));
+		stream.fences[region] = QGLCall$(GL::FenceSync(GL::SYNC_GPU_COMMANDS_COMPLETE, 0));
+	}
+
+	void RenderData::FenceQueuedRegions() {
+		for (u32 regions = stream.queuedRegions; regions; regions &= regions - 1)
+			FenceRegion(std::countr_zero(regions));
+		stream.queuedRegions = 0;
+	}
+
+	void RenderData::ReleaseFences() {
+		for (void*& fence : stream.fences) {
+			if (!fence) continue;
+			QGLCall$(GL::DeleteSync((GL::Sync)fence));
+			fence = nullptr;
+		}
+	}
+
 	void RenderData::Bind() const {
 		varray.Bind();
 		vbo.Bind();
@@ -46,14 +236,31 @@ namespace Quasi::Graphics {
 		ibo.Unbind();
 	}
 
+	void RenderData::FlushQueued() {
+		if (queuedFill == NOT_QUEUED || !device) return;
+		device->GetRenderQueue().Flush(*device);
+	}
+
 	void RenderData::BufferUnload() {
+		++fills;
+		// a streamed render only overwrites a queued range once the ring comes back around to it,
+		// BeginStreamFrame flushes then
+		if (queuedFill != NOT_QUEUED && !IsStreaming()) FlushQueued();
+		if (IsStreaming()) return BeginStreamFrame();
 		vbo.ClearData();
 		ibo.ClearData();
 	}
 
 	void RenderData::BufferLoad() {
+		if (IsStreaming()) return EndStreamFrame();
+		if (vertexOffset > vbo.GetLength()) vbo.Resize((u32)vertexCapacity);
+		// u16 indices until the vertices outgrow them, then u32 from there on
+		if (ibo.IsShort() && vertexOffset / vertexSize > IndexBuffer::SHORT_LIMIT)
+			ibo.Reformat((u32)indexCapacity, GLTypeID::UINT);
+		else if (indexOffset > ibo.GetLength()) ibo.Resize((u32)indexCapacity);
 		vbo.AddDataBytes(vertexData.First(vertexOffset));
 		ibo.AddData     (indexData .First(indexOffset));
+		drawRange = { .indexCount = ibo.GetUsedLength(), .vertexCount = (u32)(vertexOffset / vertexSize) };
 	}
 
 	void RenderData::Clear() {
@@ -69,6 +276,18 @@ namespace Quasi::Graphics {
 		device->RenderInstanced(*this, instances, replaceShader, args, setDefaultShaderArgs);
 	}
 
+	void RenderData::Submit(const DrawOptions& options, u32 layer) {
+		device->GetRenderQueue().Submit(*this, options, layer);
+	}
+
+	void RenderData::WatchShaderFiles(Str file) {
+		device->GetShaderReloader().Watch(shader, file);
+	}
+
+	void RenderData::WatchShaderFiles(Str vert, Str frag, Str geom) {
+		device->GetShaderReloader().Watch(shader, vert, frag, geom);
+	}
+
 	void RenderData::Destroy() {
 		if (device) {
 			OptRef prev = device; // prevent infinte loop: deleterender -> erase renderdata -> destructor
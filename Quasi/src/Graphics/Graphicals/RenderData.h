@@ -8,8 +8,11 @@
 
 namespace Quasi::Graphics {
 	class GraphicsDevice;
+	class RenderQueue;
+	struct DrawOptions;
 
 	template <IVertex Vtx> class Mesh;
+	template <IVertex T> class StaticMeshes;
 
     template <class>
 	class RenderObject;
@@ -23,11 +26,46 @@ namespace Quasi::Graphics {
 	    Math::Matrix3D projection = Math::Matrix3D::ortho_projection({ -4, 4, -3, 3, 0.1f, 100 });
 	    Math::Matrix3D camera {};
 	    Shader shader = {}; // shader can be null if renderId is 0
+		static constexpr u32 MAX_STREAM_FRAMES = 4;
+
+		// the subrange of the buffers the last BufferLoad made drawable
+		struct DrawRange {
+			u32 indexCount = 0, firstIndex = 0, baseVertex = 0, vertexCount = 0;
+		};
 	private:
+		// vertices and indices are written through these, they point either into
+		// the cpu staging arrays or straight into the mapped region of the current frame
+		byte* vertexWrite = nullptr;
+		usize vertexOffset = 0, vertexCapacity = 0;
+		u32* indexWrite = nullptr;
+		usize indexOffset = 0, indexCapacity = 0;
+
 		ArrayBox<byte> vertexData;
-		usize vertexOffset = 0;
 		ArrayBox<u32> indexData;
-		usize indexOffset = 0;
+		u32 vertexSize = 1;
+		u32 attributeCount = 0;
+
+		// streaming keeps streamFrames regions in each buffer and rotates through them,
+		// every region is fenced so it is only rewritten once the gpu is done with it.
+		// a fence has to come after the draws, so regions with draws still in the render
+		// queue are fenced by the queue once it issued them
+		struct StreamState {
+			u32 frames = 0, current = 0;
+			u32 vertexRegion = 0, indexRegion = 0; // bytes, indices
+			void* fences[MAX_STREAM_FRAMES] {};
+			u32 queuedRegions = 0; // a bit per region
+			bool mapped = false;
+			u32 stalls = 0, grows = 0;
+		} stream;
+		DrawRange drawRange;
+
+		// draws in the render queue read the ranges they were submitted with, so the data has to
+		// stay until the queue is flushed (streamed renders keep it until the ring comes back around).
+		// fills counts BufferUnloads, queuedFill is the fill the oldest queued draw reads from
+		static constexpr u32 NOT_QUEUED = ~0u;
+		u32 fills = 0, queuedFill = NOT_QUEUED;
+
+		Vec<u32> parallelStarts; // scratch for AddParallel
 
 		OptRef<GraphicsDevice> device;
 		usize deviceIndex = 0;
@@ -35,8 +73,11 @@ namespace Quasi::Graphics {
 		friend class GraphicsDevice;
 	public:
 		explicit RenderData(GraphicsDevice& gd, usize vsize, usize isize, usize vertSize, const VertexBufferLayout& layout) :
-			varray(VertexArray::New()), vbo(VertexBuffer::New(vsize * vertSize)), ibo(IndexBuffer::New(isize)),
-			vertexData(ArrayBox<byte>::AllocateUninit(vsize * vertSize)), indexData(ArrayBox<u32>::AllocateUninit(isize)), device(gd) {
+			varray(VertexArray::New()), vbo(VertexBuffer::New(vsize * vertSize)), ibo(IndexBuffer::New(isize, IndexBuffer::TypeFor(vsize))),
+			vertexData(ArrayBox<byte>::AllocateUninit(vsize * vertSize)), indexData(ArrayBox<u32>::AllocateUninit(isize)),
+			vertexSize((u32)vertSize), attributeCount(layout.GetComponents().Length()), device(gd) {
+			vertexWrite = vertexData.Data(); vertexCapacity = vsize * vertSize;
+			indexWrite  = indexData.Data();  indexCapacity  = isize;
 			varray.Bind();
 			varray.AddBuffer(layout);
 		}
@@ -53,6 +94,24 @@ namespace Quasi::Graphics {
 		template <class T> void PushVertex(const T& vertex);
 		void PushIndex(TriIndices index);
 		void PushIndicesOffseted(Span<const TriIndices> indices, usize objectSize);
+		// makes room for this many more vertex bytes and indices, growing the buffers if needed
+		void Reserve(usize vertexBytes, usize indexCount) {
+			if (vertexOffset + vertexBytes > vertexCapacity) GrowVertices(vertexOffset + vertexBytes);
+			if (indexOffset  + indexCount  > indexCapacity)  GrowIndices (indexOffset  + indexCount);
+		}
+
+		// switches to a ring of frames regions written in place through mapped memory.
+		// this drops the staging copy, and draws of older frames never block the cpu.
+		// streamed indices are always u32, they're written straight into the buffer
+		void EnableStreaming(u32 frames = 3);
+		void DisableStreaming();
+		bool IsStreaming() const { return stream.frames; }
+		u32 StreamStalls() const { return stream.stalls; }
+		u32 StreamGrows() const { return stream.grows; }
+
+		const DrawRange& GetDrawRange() const { return drawRange; }
+		// vertex attribute locations taken by the vertex layout, instance attributes go after these
+		u32 AttributeCount() const { return attributeCount; }
 
 		void Bind() const;
 		void Unbind() const;
@@ -62,15 +121,39 @@ namespace Quasi::Graphics {
 
 		void Clear();
 		template <class T> void Add(const Mesh<T>& mesh) { mesh.AddTo(*this); }
-		void Add(const CollectionAny auto& arr) { for (const auto& m : arr) Add(m); }
+		void Add(const CollectionAny auto& arr) {
+			if constexpr (requires { AddParallel(arr.AsSpan()); }) AddParallel(arr.AsSpan());
+			else for (const auto& m : arr) Add(m);
+		}
+		// same result as adding the meshes one by one, but the vertices are transformed on the
+		// worker pool. every mesh gets its own range of the buffers up front, so the order never changes
+		template <IVertex T> void AddParallel(Span<const Mesh<T>> meshes);
+		template <IVertex T> void AddParallel(Span<const Mesh<T>* const> meshes);
+		// below this many vertices the threads cost more than they save
+		static constexpr usize PARALLEL_MIN_VERTICES = 8192;
 
 		void Destroy();
+	private:
+		void GrowVertices(usize minBytes);
+		void GrowIndices(usize minCount);
+		void BeginStreamFrame();
+		void EndStreamFrame();
+		void FenceRegion(u32 region);
+		void FenceQueuedRegions();
+		u32 RegionOf(const DrawRange& range) const { return stream.indexRegion ? range.firstIndex / stream.indexRegion : 0; }
+		void ReleaseFences();
+		// draws whatever the queue holds before the data it reads is overwritten
+		void FlushQueued();
+		template <IVertex T, class MeshAt> void AddParallelWith(usize count, MeshAt meshAt);
+	public:
 
 		void Render(Shader& replaceShader, const ShaderArgs& args = {}, bool setDefaultShaderArgs = true);
 		void Render(const ShaderArgs& args = {}, bool setDefaultShaderArgs = true) { Render(shader, args, setDefaultShaderArgs); }
 
 		void RenderInstanced(Shader& replaceShader, int instances, const ShaderArgs& args = {}, bool setDefaultShaderArgs = true);
 		void RenderInstanced(int instances, const ShaderArgs& args = {}, bool setDefaultShaderArgs = true) { RenderInstanced(shader, instances, args, setDefaultShaderArgs); }
+		// puts what was last loaded in the render queue of the device, drawn at the end of the frame
+		void Submit(const DrawOptions& options, u32 layer = 0);
 
 	    void SetCamera(const Math::Matrix3D& cam) { camera = cam; }
 	    void SetProjection(const Math::Matrix3D& proj) { projection = proj; }
@@ -78,14 +161,20 @@ namespace Quasi::Graphics {
 	    void UseShader(Str code) { shader = Shader::New(code); }
 	    void UseShaderFromFile(CStr file) { shader = Shader::FromFile(file); }
 	    void UseShaderFromFile(CStr vert, CStr frag, CStr geom = {}) { shader = Shader::FromFile(vert, frag, geom); }
+		// builds without blocking, and rebuilds whenever the files change
+		void WatchShaderFiles(Str file);
+		void WatchShaderFiles(Str vert, Str frag, Str geom = {});
 
 		friend class GraphicsDevice;
+		friend class RenderQueue;
 		template <IVertex T> friend class Mesh;
+		template <IVertex T> friend class StaticMeshes;
 	};
 
 	template <class T> void RenderData::PushVertex(const T& vertex) {
+		if (vertexOffset + sizeof(T) > vertexCapacity) [[unlikely]] GrowVertices(vertexOffset + sizeof(T));
 		const byte* rawbytes = Memory::TransmutePtr<const byte>(&vertex);
-		Memory::MemCopyNoOverlap(&vertexData[vertexOffset], rawbytes, sizeof(T));
+		Memory::MemCopyNoOverlap(vertexWrite + vertexOffset, rawbytes, sizeof(T));
 		vertexOffset += sizeof(T);
 	}
 }
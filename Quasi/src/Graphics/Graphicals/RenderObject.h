@@ -1,5 +1,6 @@
 #pragma once
 #include "RenderData.h"
+#include "Textures/Texture.h"
 
 #include "Utils/Ref.h"
 
@@ -8,6 +9,10 @@ namespace Quasi::Graphics {
 		OptRef<Shader> shader;
 		ShaderArgs arguments = {};
 		bool useDefaultArguments = true;
+		OptRef<Texture> texture; // activated on textureSlot before drawing, the render queue batches by it
+		u32 textureSlot = 0;
+
+		void ActivateTexture() const { if (texture) Memory::AsMut(*texture).Activate((int)textureSlot); }
 	};
 
 	inline DrawOptions UseShader(Shader& shader, bool useDefaultArgs = true) {
@@ -50,17 +55,23 @@ namespace Quasi::Graphics {
 		void DrawInstanced(IList<const Mesh<T>*> meshes, int instances, const DrawOptions& options = {});
     	void DrawInstanced(const Mesh<T>& mesh, int instances, const DrawOptions& options = {}) { DrawInstanced({ &mesh }, instances, options); }
     	void DrawInstanced(const CollectionAny auto& meshes, int instances, const DrawOptions& options = {});
+		// like Draw, but through the render queue, sorted and batched with the rest of the frame
+		void Submit(IList<const Mesh<T>*> meshes, const DrawOptions& options = {}, u32 layer = 0);
+		void Submit(const Mesh<T>& mesh, const DrawOptions& options = {}, u32 layer = 0) { Submit({ &mesh }, options, layer); }
+		void Submit(const CollectionAny auto& meshes, const DrawOptions& options = {}, u32 layer = 0);
 
     	void BeginContext() { rd->BufferUnload(); rd->Clear(); }
     	void AddMesh(const Mesh<T>& mesh) { rd->Add(mesh); }
     	void AddMeshes(const CollectionAny auto& meshes) { rd->Add(meshes); }
-    	void AddMeshes(IList<const Mesh<T>*> meshes) { for (auto* m : meshes) rd->Add(*m); }
+    	void AddMeshes(IList<const Mesh<T>*> meshes) { rd->AddParallel(Spans::FromIList(meshes)); }
     	void EndContext() { rd->BufferLoad(); }
 
      	void DrawContext(const DrawOptions& options = {}) {
+    		options.ActivateTexture();
     		rd->Render(Memory::AsMut(options.shader.UnwrapOr(rd->shader)), options.arguments, options.useDefaultArguments);
     	}
     	void DrawContextInstanced(int instances, const DrawOptions& options = {}) {
+    		options.ActivateTexture();
     		rd->RenderInstanced(Memory::AsMut(options.shader.UnwrapOr(rd->shader)), instances, options.arguments, options.useDefaultArguments);
     	}
 
@@ -73,12 +84,14 @@ namespace Quasi::Graphics {
 	    void UseShaderFromFile(Str file) { rd->UseShaderFromFile(file); }
 	    void UseShaderFromFile(Str vert, Str frag, Str geom = {})
     	{ rd->UseShaderFromFile(vert, frag, geom); }
+	    void WatchShaderFiles(Str file) { rd->WatchShaderFiles(file); }
+	    void WatchShaderFiles(Str vert, Str frag, Str geom = {}) { rd->WatchShaderFiles(vert, frag, geom); }
     };
 
     template <class T>
 	void RenderObject<T>::Draw(IList<const Mesh<T>*> meshes, const DrawOptions& options) {
 	    BeginContext();
-    	for (auto* m : meshes) rd->Add(*m);
+    	AddMeshes(meshes);
     	EndContext();
     	DrawContext(options);
     }
@@ -91,10 +104,26 @@ namespace Quasi::Graphics {
     	DrawContext(options);
     }
 
+    template <class T>
+	void RenderObject<T>::Submit(IList<const Mesh<T>*> meshes, const DrawOptions& options, u32 layer) {
+	    BeginContext();
+    	AddMeshes(meshes);
+    	EndContext();
+    	rd->Submit(options, layer);
+    }
+
+    template <class T>
+	void RenderObject<T>::Submit(const CollectionAny auto& meshes, const DrawOptions& options, u32 layer) {
+	    BeginContext();
+    	AddMeshes(meshes);
+    	EndContext();
+    	rd->Submit(options, layer);
+    }
+
     template <class T>
 	void RenderObject<T>::DrawInstanced(IList<const Mesh<T>*> meshes, int instances, const DrawOptions& options) {
     	BeginContext();
-    	for (auto* m : meshes) rd->Add(*m);
+    	AddMeshes(meshes);
     	EndContext();
     	DrawContextInstanced(instances, options);
     }
@@ -0,0 +1,225 @@
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <glp.h>
+
+#include "GraphicsDevice.h"
+#include "GLDebug.h"
+
+namespace Quasi::Graphics {
+    u32 RenderQueue::PushArgs(ShaderArgs args) {
+        const u32 boundStart = (u32)boundStorage.Length(), boundCount = (u32)args.bound.Length();
+        for (const BoundUniform& b : args.bound) boundStorage.Push(b);
+        args.bound = {};
+        argStorage.Push({ std::move(args), boundStart, boundCount });
+        return (u32)argStorage.Length() - 1;
+    }
+
+    void RenderQueue::Submit(const DrawItem& item) {
+        if (ShaderOf(item).IsNull()) return; // still being built by the shader reloader
+        DrawItem& added = items.Push(item);
+        RenderData& rd = *added.render;
+        if (rd.queuedFill == RenderData::NOT_QUEUED) rd.queuedFill = rd.fills;
+        if (added.useWholeRender) {
+            added.range = added.render->GetDrawRange();
+            added.useWholeRender = false;
+        }
+        if (rd.IsStreaming()) rd.stream.queuedRegions |= 1u << rd.RegionOf(added.range);
+    }
+
+    void RenderQueue::Submit(RenderData& render, const DrawOptions& options, u32 layer) {
+        Submit({
+            .render = render,
+            .shader = options.shader,
+            .texture = options.texture,
+            .textureSlot = options.textureSlot,
+            .argsHandle = options.arguments.size() ? PushArgs(options.arguments) : ~0,
+            .useDefaultArguments = options.useDefaultArguments,
+            .layer = layer,
+        });
+    }
+
+    void RenderQueue::Clear() {
+        for (DrawItem& item : items) {
+            item.render->queuedFill = RenderData::NOT_QUEUED;
+            // after the draws that read them, or they would be rewritten while still being read
+            item.render->FenceQueuedRegions();
+        }
+        items.Clear();
+        argStorage.Clear();
+        boundStorage.Clear();
+    }
+
+    u64 RenderQueue::EncodeKey(const DrawItem& item) {
+        // top 16 bits of a non negative float still sort the same way as the float
+        const u64 depth  = Memory::Transmute<u32>(std::max(item.depth, 0.0f)) >> 16;
+        const u64 layer   = item.layer & 0xF,
+                  state   = item.state.Bits(),
+                  shader  = ShaderOf(item).rendererID & 0xFFF,
+                  texture = item.texture ? item.texture->rendererID & 0xFFF : 0,
+                  vao     = item.render->varray.rendererID & 0xFFF,
+                  args    = item.argsHandle & 0xFFF;
+
+        // opaque: layer:4 0:1 state:2 shader:12 texture:12 vao:12 args:12 depth:9
+        // blended: layer:4 1:1 far-to-near:16 state:2 shader:12 texture:10 vao:10 args:9
+        // ids that share their low bits only sort next to each other, CanMerge still tells them apart
+        if (!item.state.blend)
+            return layer << 60 | state << 57 | shader << 45 | texture << 33 | vao << 21 | args << 9 | depth >> 7;
+        return layer << 60 | 1ull << 59 | (0xFFFF - depth) << 43 | state << 41 | shader << 29 |
+               (texture & 0x3FF) << 19 | (vao & 0x3FF) << 9 | (args & 0x1FF);
+    }
+
+    void RenderQueue::SortKeys() {
+        // lsd radix sort over bytes, stable so equal keys keep their submission order
+        const u32 n = (u32)keys.Length();
+        keysScratch.Resize(n);
+        orderScratch.Resize(n);
+        u64* srcKey = keys.Data(), *dstKey = keysScratch.Data();
+        u32* srcOrd = order.Data(), *dstOrd = orderScratch.Data();
+
+        for (u32 shift = 0; shift < 64; shift += 8) {
+            u32 counts[256] {};
+            for (u32 i = 0; i < n; ++i) ++counts[(srcKey[i] >> shift) & 0xFF];
+            // most bytes are the same for every key, those passes are skipped
+            if (counts[(srcKey[0] >> shift) & 0xFF] == n) continue;
+
+            u32 sum = 0;
+            for (u32& c : counts) { const u32 x = c; c = sum; sum += x; }
+            for (u32 i = 0; i < n; ++i) {
+                const u32 at = counts[(srcKey[i] >> shift) & 0xFF]++;
+                dstKey[at] = srcKey[i];
+                dstOrd[at] = srcOrd[i];
+            }
+            std::swap(srcKey, dstKey);
+            std::swap(srcOrd, dstOrd);
+        }
+
+        if (srcKey != keys.Data()) {
+            Memory::MemCopyNoOverlap(keys.Data(),  srcKey, n * sizeof(u64));
+            Memory::MemCopyNoOverlap(order.Data(), srcOrd, n * sizeof(u32));
+        }
+    }
+
+    bool RenderQueue::CanMerge(const DrawItem& a, const DrawItem& b) {
+        // the buffers and not the render, a range doesnt have to be the whole render to be merged
+        const RenderData& ra = *a.render, &rb = *b.render;
+        const GraphicsID textureA = a.texture ? a.texture->rendererID : GraphicsNoID,
+                         textureB = b.texture ? b.texture->rendererID : GraphicsNoID;
+        return ra.varray.rendererID == rb.varray.rendererID &&
+               ra.vbo.rendererID == rb.vbo.rendererID &&
+               ra.ibo.rendererID == rb.ibo.rendererID &&
+               textureA == textureB && (!textureA || a.textureSlot == b.textureSlot) &&
+               ShaderOf(a).rendererID == ShaderOf(b).rendererID &&
+               a.argsHandle == b.argsHandle &&
+               a.useDefaultArguments == b.useDefaultArguments &&
+               a.state == b.state &&
+               a.layer == b.layer;
+    }
+
+    void RenderQueue::Flush(GraphicsDevice& device) {
+        const u32 n = (u32)items.Length();
+        lastStats = { .submitted = n };
+        if (n == 0) return;
+
+        keys.Clear();
+        order.Clear();
+        keys.Reserve(n);
+        order.Reserve(n);
+        for (u32 i = 0; i < n; ++i) {
+            keys.Push(EncodeKey(items[i]));
+            order.Push(i);
+        }
+        SortKeys();
+
+        GraphicsID currShader = GraphicsNoID, currVao = GraphicsNoID, currTexture = GraphicsNoID;
+        u32 currArgs = ~0, currTextureSlot = 0;
+        const RenderData* defaultsSetFor = nullptr;
+        DrawState currState;
+        bool stateKnown = false;
+
+        for (u32 i = 0; i < n;) {
+            DrawItem& head = items[order[i]];
+            u32 end = i + 1;
+            while (end < n && CanMerge(head, items[order[end]])) ++end;
+
+            RenderData& rd = *head.render;
+            Shader& shader = ShaderOf(head);
+
+            if (!stateKnown || currState.blend != head.state.blend) {
+                head.state.blend ? Render::EnableBlend() : Render::DisableBlend();
+                ++lastStats.stateChanges;
+            }
+            if (!stateKnown || currState.depthTest != head.state.depthTest) {
+                head.state.depthTest ? Render::EnableDepth() : Render::DisableDepth();
+                ++lastStats.stateChanges;
+            }
+            currState = head.state;
+            stateKnown = true;
+
+            if (shader.rendererID != currShader) {
+                shader.Bind();
+                currShader = shader.rendererID;
+                currArgs = ~0;
+                defaultsSetFor = nullptr;
+                ++lastStats.shaderBinds;
+            }
+            if (head.argsHandle != currArgs && head.argsHandle != ~0u) {
+                const StoredArgs& stored = argStorage[head.argsHandle];
+                shader.SetUniformArgs(stored.named);
+                shader.SetUniformArgs(Span<const BoundUniform>::Slice(boundStorage.Data() + stored.boundStart, stored.boundCount));
+                currArgs = head.argsHandle;
+            }
+            if (head.useDefaultArguments && defaultsSetFor != &rd) {
+                device.SetCameraUniforms(rd, shader);
+                defaultsSetFor = &rd;
+            }
+            if (head.texture && (head.texture->rendererID != currTexture || head.textureSlot != currTextureSlot)) {
+                head.texture->Activate((int)head.textureSlot);
+                currTexture = head.texture->rendererID;
+                currTextureSlot = head.textureSlot;
+                ++lastStats.textureBinds;
+            }
+            if (rd.varray.rendererID != currVao) {
+                rd.varray.Bind();
+                rd.ibo.Bind();
+                currVao = rd.varray.rendererID;
+                ++lastStats.vaoBinds;
+            }
+
+            // join ranges that follow each other in the index buffer
+            const usize indexSize = rd.ibo.IndexSize();
+            const u32 indexType = rd.ibo.GetIndexType()->glID;
+            mdCounts.Clear(); mdOffsets.Clear(); mdBaseVertices.Clear();
+            for (u32 k = i; k < end; ++k) {
+                const RenderData::DrawRange& r = items[order[k]].range;
+                if (!r.indexCount) continue;
+                if (!mdCounts.IsEmpty() && mdBaseVertices.Last() == (i32)r.baseVertex &&
+                    (usize)mdOffsets.Last() + mdCounts.Last() * indexSize == r.firstIndex * indexSize) {
+                    mdCounts.LastMut() += (i32)r.indexCount;
+                    continue;
+                }
+                mdCounts.Push((i32)r.indexCount);
+                mdOffsets.Push((void*)(usize)(r.firstIndex * indexSize));
+                mdBaseVertices.Push((i32)r.baseVertex);
+            }
+
+            if (mdCounts.Length() == 1) {
+                QGLCall$(GL::DrawElementsBaseVertex(GL::TRIANGLES, mdCounts[0], indexType, mdOffsets[0], mdBaseVertices[0]));
+                ++lastStats.drawCalls;
+            } else if (mdCounts.Length() > 1) {
+                QGLCall$(GL::MultiDrawElementsBaseVertex(GL::TRIANGLES, mdCounts.Data(), indexType,
+                    mdOffsets.Data(), (int)mdCounts.Length(), mdBaseVertices.Data()));
+                ++lastStats.drawCalls;
+            }
+
+            i = end;
+        }
+
+        // back to what GraphicsDevice::Initialize sets up
+        if (!currState.blend)     Render::EnableBlend();
+        if (!currState.depthTest) Render::EnableDepth();
+
+        device.renderOptions.drawCalls += lastStats.drawCalls;
+        Clear();
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "RenderObject.h"
+
+namespace Quasi::Graphics {
+    class GraphicsDevice;
+
+    struct DrawState {
+        bool blend = true, depthTest = true;
+
+        u32 Bits() const { return (u32)blend << 1 | (u32)depthTest; }
+        bool operator==(const DrawState&) const = default;
+    };
+
+    struct DrawItem {
+        OptRef<RenderData> render;
+        RenderData::DrawRange range;  // ignored if useWholeRender is set
+        bool useWholeRender = true;
+        OptRef<Shader> shader;        // falls back to the shader of the render
+        OptRef<Texture> texture;      // activated on textureSlot first, if set
+        u32 textureSlot = 0;
+        u32 argsHandle = ~0;          // from RenderQueue::PushArgs, items sharing a handle can be batched
+        bool useDefaultArguments = true;
+        DrawState state;
+        u32 layer = 0;                // 0-15, lower layers draw first
+        float depth = 0;              // view distance, translucent items (blend on) are drawn back to front
+    };
+
+    // collects draws for a frame, sorts them by a packed 64 bit key so that
+    // items with the same state end up next to each other, and then issues them
+    // with as few state changes and draw calls as possible.
+    // neighbouring items reading the same buffers with the same shader, texture, arguments and
+    // state are merged into one draw, or one MultiDrawElementsBaseVertex if their ranges arent
+    // contiguous. so separate ranges of one buffer (like the slots of StaticMeshes) are drawn together
+    class RenderQueue {
+        struct StoredArgs {
+            ShaderArgs named;
+            u32 boundStart, boundCount;
+        };
+
+        Vec<DrawItem> items;
+        Vec<StoredArgs> argStorage;
+        Vec<BoundUniform> boundStorage; // handle arguments are borrowed, so they get copied here
+        Vec<u64> keys, keysScratch;
+        Vec<u32> order, orderScratch;
+
+        // scratch for multidraws, reused every flush
+        Vec<i32> mdCounts, mdBaseVertices;
+        Vec<void*> mdOffsets;
+    public:
+        struct Stats {
+            u32 submitted = 0, drawCalls = 0, shaderBinds = 0, vaoBinds = 0, textureBinds = 0, stateChanges = 0;
+        };
+    private:
+        Stats lastStats;
+    public:
+        RenderQueue() = default;
+
+        // stored until the next Clear, the handle can be shared by many items
+        u32 PushArgs(ShaderArgs args);
+        // the draw range is taken at submit. refilling the render flushes the queue first,
+        // unless it streams and the ring still keeps the submitted region around.
+        // streamed regions are fenced once their draws are issued
+        void Submit(const DrawItem& item);
+        void Submit(RenderData& render, const DrawOptions& options = {}, u32 layer = 0);
+
+        // sorts and draws everything submitted, then clears the queue
+        void Flush(GraphicsDevice& device);
+        void Clear();
+
+        usize ItemCount() const { return items.Length(); }
+        const Stats& GetLastStats() const { return lastStats; }
+
+        static u64 EncodeKey(const DrawItem& item);
+    private:
+        void SortKeys();
+        static const Shader& ShaderOf(const DrawItem& item) { return item.shader ? *item.shader : item.render->shader; }
+        static Shader& ShaderOf(DrawItem& item) { return item.shader ? *item.shader : item.render->shader; }
+        static bool CanMerge(const DrawItem& a, const DrawItem& b);
+    };
+}
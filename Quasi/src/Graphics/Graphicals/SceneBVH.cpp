@@ -0,0 +1,175 @@
+#include "SceneBVH.h"
+
+#include <algorithm>
+
+namespace Quasi::Graphics {
+    namespace {
+        // on a node in the cull stack, the node is known to be inside the frustum
+        constexpr u32 INSIDE_BIT = 1u << 31;
+    }
+
+    SceneBVH::Handle SceneBVH::Insert(const Math::fRect3D& bounds, u32 userId) {
+        u32 id;
+        if (freeItems.Length()) {
+            id = freeItems.Last();
+            freeItems.Pop();
+        } else {
+            id = items.Length();
+            items.Push({});
+        }
+        items[id] = { bounds, userId, true };
+        needsRebuild = true;
+        return { id };
+    }
+
+    void SceneBVH::Update(Handle h, const Math::fRect3D& bounds) {
+        if (!Contains(h)) return;
+        items[h.id].bounds = bounds;
+        needsRefit = true;
+    }
+
+    void SceneBVH::Remove(Handle h) {
+        if (!Contains(h)) return;
+        items[h.id].alive = false;
+        freeItems.Push(h.id);
+        needsRebuild = true;
+    }
+
+    void SceneBVH::Clear() {
+        items.Clear();
+        freeItems.Clear();
+        nodes.Clear();
+        order.Clear();
+        needsRebuild = needsRefit = false;
+    }
+
+    float SceneBVH::Area(const Math::fRect3D& box) {
+        const Math::fVector3 s = box.size();
+        return 2 * (s.x * s.y + s.y * s.z + s.z * s.x);
+    }
+
+    void SceneBVH::Rebuild() {
+        order.Clear();
+        for (u32 i = 0; i < items.Length(); ++i)
+            if (items[i].alive) order.Push(i);
+
+        nodes.Clear();
+        if (order.Length()) {
+            nodes.Reserve(order.Length() * 2 / MAX_LEAF_ITEMS + 1);
+            nodes.Push({});
+            Build(0, 0, order.Length());
+            builtArea = Area(nodes[0].bounds);
+        }
+        needsRebuild = needsRefit = false;
+        ++stats.rebuilds;
+    }
+
+    // median split of order[begin, end) along the longest axis of the box centers
+    void SceneBVH::Build(u32 index, u32 begin, u32 end) {
+        Math::fRect3D bounds = Math::fRect3D::unrange(), centers = Math::fRect3D::unrange();
+        for (u32 i = begin; i < end; ++i) {
+            bounds  = bounds.expand(items[order[i]].bounds);
+            centers = centers.expand_until(items[order[i]].bounds.center());
+        }
+        nodes[index].bounds = bounds;
+
+        if (end - begin <= MAX_LEAF_ITEMS) {
+            nodes[index].first = begin;
+            nodes[index].count = end - begin;
+            return;
+        }
+
+        const Math::fVector3 spread = centers.size();
+        const u32 axis = spread.x > spread.y ? (spread.x > spread.z ? 0 : 2) : (spread.y > spread.z ? 1 : 2);
+        const u32 mid = (begin + end) / 2;
+        std::nth_element(order.Data() + begin, order.Data() + mid, order.Data() + end, [&] (u32 a, u32 b) {
+            return items[a].bounds.center()[axis] < items[b].bounds.center()[axis];
+        });
+
+        // the children sit next to each other, after their parent, so refitting can go backwards
+        const u32 left = nodes.Length();
+        nodes[index].first = left;
+        nodes[index].count = 0;
+        nodes.Push({});
+        nodes.Push({});
+        Build(left, begin, mid);
+        Build(left + 1, mid, end);
+    }
+
+    void SceneBVH::Refit() {
+        for (u32 n = nodes.Length(); n --> 0;) {
+            Node& node = nodes[n];
+            if (node.IsLeaf()) {
+                Math::fRect3D bounds = Math::fRect3D::unrange();
+                for (u32 i = node.first; i < node.first + node.count; ++i)
+                    bounds = bounds.expand(items[order[i]].bounds);
+                node.bounds = bounds;
+            } else {
+                node.bounds = nodes[node.first].bounds.expand(nodes[node.first + 1].bounds);
+            }
+        }
+        needsRefit = false;
+        ++stats.refits;
+    }
+
+    void SceneBVH::Prepare() {
+        if (needsRebuild) return Rebuild();
+        if (!needsRefit) return;
+        Refit();
+        if (nodes.Length() && Area(nodes[0].bounds) > builtArea * REBUILD_GROWTH) Rebuild();
+    }
+
+    void SceneBVH::AddItem(u32 itemId, Vec<u32>& visible, OptRef<OcclusionBuffer> occlusion) {
+        const Item& item = items[itemId];
+        if (occlusion && !occlusion->IsVisible(item.bounds)) {
+            ++stats.occluded;
+            return;
+        }
+        visible.Push(item.userId);
+        ++stats.visible;
+    }
+
+    void SceneBVH::Cull(const Frustum& frustum, Vec<u32>& visible, OptRef<OcclusionBuffer> occlusion) {
+        Prepare();
+        if (nodes.IsEmpty()) return;
+
+        stack.Clear();
+        stack.Push(0);
+        while (stack.Length()) {
+            const u32 top = stack.Last();
+            stack.Pop();
+            const Node& node = nodes[top & ~INSIDE_BIT];
+            bool inside = top & INSIDE_BIT;
+            ++stats.nodesVisited;
+
+            if (!inside) {
+                ++stats.boxesTested;
+                const CullResult result = frustum.Test(node.bounds);
+                if (result == CullResult::OUTSIDE) continue;
+                inside = result == CullResult::INSIDE;
+            }
+            if (occlusion && !occlusion->IsVisible(node.bounds)) {
+                ++stats.occluded;
+                continue;
+            }
+
+            if (!node.IsLeaf()) {
+                const u32 flag = inside ? INSIDE_BIT : 0;
+                // the left child is popped first
+                stack.Push((node.first + 1) | flag);
+                stack.Push(node.first | flag);
+                continue;
+            }
+
+            for (u32 i = node.first; i < node.first + node.count; ++i) {
+                const u32 itemId = order[i];
+                if (!inside && node.count > 1) {
+                    ++stats.boxesTested;
+                    if (!frustum.IsVisible(items[itemId].bounds)) continue;
+                }
+                // a single item has the same box as its leaf
+                AddItem(itemId, visible, node.count > 1 ? occlusion : nullptr);
+            }
+        }
+    }
+}
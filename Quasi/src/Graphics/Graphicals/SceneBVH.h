@@ -0,0 +1,75 @@
+#pragma once
+#include "Frustum.h"
+#include "OcclusionBuffer.h"
+
+namespace Quasi::Graphics {
+    // bounding volume hierarchy over the objects of a scene, each one a world space box and
+    // an id of the callers choosing. Cull walks it against a frustum, dropping whole subtrees
+    // at once, and gives back the ids left to draw (in tree order, sort them for the render queue).
+    // moving objects only refits the boxes, adding or removing rebuilds on the next cull
+    class SceneBVH {
+    public:
+        struct Handle {
+            u32 id = ~0u;
+            bool IsNull() const { return id == ~0u; }
+        };
+
+        struct Stats {
+            u32 nodesVisited = 0, boxesTested = 0, visible = 0, occluded = 0, rebuilds = 0, refits = 0;
+        };
+    private:
+        struct Item {
+            Math::fRect3D bounds;
+            u32 userId = 0;
+            bool alive = false;
+        };
+        struct Node {
+            Math::fRect3D bounds;
+            u32 first = 0; // the left child (right is the next one), or the first item for leaves
+            u32 count = 0; // items in a leaf, 0 for inner nodes
+            bool IsLeaf() const { return count; }
+        };
+
+        Vec<Item> items;
+        Vec<u32> freeItems;
+        Vec<Node> nodes;
+        Vec<u32> order; // item ids, leaves hold ranges of this
+        Vec<u32> stack;
+        bool needsRebuild = false, needsRefit = false;
+        float builtArea = 0; // surface area of the root right after building
+        Stats stats;
+    public:
+        static constexpr u32 MAX_LEAF_ITEMS = 4;
+        // refitting loosens the tree as objects drift apart, past this much growth its built again
+        static constexpr float REBUILD_GROWTH = 2.0f;
+
+        SceneBVH() = default;
+
+        Handle Insert(const Math::fRect3D& bounds, u32 userId);
+        void Update(Handle h, const Math::fRect3D& bounds);
+        void Remove(Handle h);
+        void Clear();
+
+        // both happen on their own on the next cull when needed
+        void Rebuild();
+        void Refit();
+
+        // appends to visible, occlusion is optional and has to be filled for this frame already
+        void Cull(const Frustum& frustum, Vec<u32>& visible, OptRef<OcclusionBuffer> occlusion = nullptr);
+        void Cull(const Math::Matrix3D& viewProj, Vec<u32>& visible, OptRef<OcclusionBuffer> occlusion = nullptr) {
+            Cull(Frustum::FromMatrix(viewProj), visible, occlusion);
+        }
+
+        bool Contains(Handle h) const { return h.id < items.Length() && items[h.id].alive; }
+        u32 Count() const { return items.Length() - freeItems.Length(); }
+        u32 NodeCount() const { return nodes.Length(); }
+        const Math::fRect3D& BoundsOf(Handle h) const { return items[h.id].bounds; }
+        const Stats& GetStats() const { return stats; }
+        void ResetStats() { stats = {}; }
+    private:
+        void Prepare();
+        void Build(u32 index, u32 begin, u32 end);
+        void AddItem(u32 itemId, Vec<u32>& visible, OptRef<OcclusionBuffer> occlusion);
+        static float Area(const Math::fRect3D& box);
+    };
+}
@@ -0,0 +1,204 @@
+#include "SceneGraph.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "Utils/WorkerPool.h"
+
+namespace Quasi::Graphics {
+    namespace {
+        template <class T>
+        void Permute(Vec<T>& v, Span<const u32> order) {
+            Vec<T> out = Vec<T>::WithCap(order.Length());
+            for (const u32 s : order) out.Push(v[s]);
+            v = std::move(out);
+        }
+    }
+
+    SceneGraph::Handle SceneGraph::Add(const Math::Transform3D& localTransform, Handle parent) {
+        const u32 parentNode = Contains(parent) ? parent.id : NONE;
+        u32 id;
+        if (freeIds.Length()) {
+            id = freeIds.Last();
+            freeIds.Pop();
+        } else {
+            id = slotOf.Length();
+            slotOf.Push(NONE);
+            generationOf.Push(0);
+        }
+
+        slotOf[id] = ids.Length();
+        local.Push(localTransform);
+        world.Push(localTransform);
+        worldMatrix.Push(localTransform.TransformMatrix());
+        parentSlot.Push(NONE);
+        parentId.Push(parentNode);
+        ids.Push(id);
+        pending.Push(true);
+        updated.Push(false);
+        ++dirtyCount;
+        // the new node is at the end, wherever its depth is
+        needsLayout = true;
+        return HandleOf(id);
+    }
+
+    void SceneGraph::Remove(Handle h) {
+        if (!Contains(h)) return;
+        if (needsLayout) Layout();
+
+        // parents come first, so a node is gone if its parent is
+        Vec<u32> kept = Vec<u32>::WithCap(ids.Length());
+        Vec<u8> gone;
+        gone.Resize(ids.Length(), false);
+        dirtyCount = 0;
+        for (u32 s = 0; s < ids.Length(); ++s) {
+            gone[s] = ids[s] == h.id || (parentSlot[s] != NONE && gone[parentSlot[s]]);
+            if (gone[s]) {
+                FreeId(ids[s]);
+            } else {
+                kept.Push(s);
+                dirtyCount += pending[s];
+            }
+        }
+
+        const Span<const u32> order = kept.AsSpan();
+        Permute(local, order); Permute(world, order); Permute(worldMatrix, order);
+        Permute(parentId, order); Permute(ids, order);
+        Permute(pending, order); Permute(updated, order);
+        parentSlot.Truncate(ids.Length());
+        for (u32 s = 0; s < ids.Length(); ++s) slotOf[ids[s]] = s;
+        Layout();
+    }
+
+    void SceneGraph::Clear() {
+        // the ids are kept with their generations, so handles from before stay stale
+        for (const u32 id : ids) FreeId(id);
+        local.Clear(); world.Clear(); worldMatrix.Clear();
+        parentSlot.Clear(); parentId.Clear(); ids.Clear();
+        pending.Clear(); updated.Clear();
+        levelStart.Clear();
+        needsLayout = false;
+        dirtyCount = lastUpdated = 0;
+    }
+
+    bool SceneGraph::SetParent(Handle h, Handle parent) {
+        if (!Contains(h)) return false;
+        const u32 parentNode = Contains(parent) ? parent.id : NONE;
+        for (u32 p = parentNode; p != NONE; p = parentId[slotOf[p]])
+            if (p == h.id) return false;
+
+        const u32 slot = slotOf[h.id];
+        parentId[slot] = parentNode;
+        MarkDirty(slot);
+        needsLayout = true;
+        return true;
+    }
+
+    SceneGraph::Handle SceneGraph::ParentOf(Handle h) const {
+        return HandleOf(parentId[SlotOf(h)]);
+    }
+
+    Math::Transform2D SceneGraph::GetWorld2D(Handle h) const {
+        const Math::Transform3D& w = GetWorld(h);
+        // a rotation about z keeps only w and z of the quaternion, at half the angle
+        return { w.position.xy(), w.scale.xy(), 2 * std::atan2(w.rotation.z, w.rotation.w) };
+    }
+
+    void SceneGraph::FreeId(u32 id) {
+        slotOf[id] = NONE;
+        ++generationOf[id];
+        freeIds.Push(id);
+    }
+
+    void SceneGraph::MarkDirty(u32 slot) {
+        if (pending[slot]) return;
+        pending[slot] = true;
+        ++dirtyCount;
+    }
+
+    void SceneGraph::Layout() {
+        const u32 count = ids.Length();
+        needsLayout = false;
+        ++stats.layouts;
+        levelStart.Clear();
+        if (!count) return;
+
+        // depths come from the parent ids, after a reparent the old order isnt parents first anymore
+        Vec<u32> depth, chain;
+        depth.Resize(count, NONE);
+        u32 maxDepth = 0;
+        for (u32 s = 0; s < count; ++s) {
+            u32 at = s;
+            while (depth[at] == NONE) {
+                if (parentId[at] == NONE) { depth[at] = 0; break; }
+                chain.Push(at);
+                at = slotOf[parentId[at]];
+            }
+            for (u32 d = depth[at]; chain.Length(); chain.Pop()) depth[chain.Last()] = ++d;
+            maxDepth = std::max(maxDepth, depth[s]);
+        }
+
+        levelStart.Resize(maxDepth + 2, 0);
+        for (u32 s = 0; s < count; ++s) ++levelStart[depth[s] + 1];
+        for (u32 d = 0; d <= maxDepth; ++d) levelStart[d + 1] += levelStart[d];
+
+        // counting sort, the order within a depth stays the same
+        Vec<u32> order, filled = levelStart.Clone();
+        order.Resize(count, 0);
+        for (u32 s = 0; s < count; ++s) order[filled[depth[s]]++] = s;
+
+        const Span<const u32> o = order.AsSpan();
+        Permute(local, o); Permute(world, o); Permute(worldMatrix, o);
+        Permute(parentId, o); Permute(ids, o);
+        Permute(pending, o); Permute(updated, o);
+
+        for (u32 s = 0; s < count; ++s) slotOf[ids[s]] = s;
+        parentSlot.Resize(count, NONE);
+        for (u32 s = 0; s < count; ++s) parentSlot[s] = parentId[s] == NONE ? NONE : slotOf[parentId[s]];
+    }
+
+    void SceneGraph::UpdateRange(u32 begin, u32 end) {
+        for (u32 s = begin; s < end; ++s) {
+            const u32 p = parentSlot[s];
+            // the parent is a level up, so its flag is already this update's
+            updated[s] = pending[s] || (p != NONE && updated[p]);
+            pending[s] = false;
+            if (!updated[s]) continue;
+
+            const Math::Matrix3D localMatrix = local[s].TransformMatrix();
+            if (p == NONE) {
+                world[s] = local[s];
+                worldMatrix[s] = localMatrix;
+            } else {
+                world[s] = local[s].Applied(world[p]);
+                worldMatrix[s] = worldMatrix[p] * localMatrix;
+            }
+        }
+    }
+
+    void SceneGraph::Update(bool parallel) {
+        if (needsLayout) Layout();
+        if (!dirtyCount) {
+            // nothing changed, only last update's flags go
+            if (lastUpdated) std::memset(updated.Data(), 0, updated.Length());
+            lastUpdated = 0;
+            return;
+        }
+
+        for (u32 d = 0; d + 1 < levelStart.Length(); ++d) {
+            const u32 begin = levelStart[d], end = levelStart[d + 1];
+            if (parallel && end - begin >= PARALLEL_MIN) {
+                WorkerPool::Global().ParallelFor(end - begin, PARALLEL_CHUNK, [&] (usize b, usize e) {
+                    UpdateRange(begin + (u32)b, begin + (u32)e);
+                });
+            } else {
+                UpdateRange(begin, end);
+            }
+        }
+
+        lastUpdated = 0;
+        for (const u8 u : updated) lastUpdated += u;
+        stats.updated += lastUpdated;
+        dirtyCount = 0;
+    }
+}
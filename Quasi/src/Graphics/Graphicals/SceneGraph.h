@@ -0,0 +1,94 @@
+#pragma once
+#include "Matrix.h"
+#include "Transform2D.h"
+#include "Transform3D.h"
+#include "Debug/Logger.h"
+
+namespace Quasi::Graphics {
+    // a hierarchy of transforms, each node has a local one and gets a world one from its parents
+    // (give it to a mesh with mesh.SetTransform(graph.GetWorld(node)), only when WasUpdated).
+    // changing a node only marks it, Update then redoes that node and everything under it, nothing else.
+    // nodes are kept by depth, parents before children, in flat arrays (one per field), so Update is
+    // a single pass and each depth can be split over threads. 2d nodes are kept as 3d ones at z = 0
+    class SceneGraph {
+    public:
+        // ids are reused after a remove, the generation tells a stale handle from the new node
+        struct Handle {
+            u32 id = ~0u, generation = 0;
+            bool IsNull() const { return id == ~0u; }
+        };
+
+        struct Stats {
+            u32 updated = 0, layouts = 0;
+        };
+    private:
+        static constexpr u32 NONE = ~0u;
+
+        // by slot, in depth order
+        Vec<Math::Transform3D> local, world;
+        Vec<Math::Matrix3D> worldMatrix;
+        Vec<u32> parentSlot, parentId, ids;
+        Vec<u8> pending, updated; // changed since the last update, and changed by it
+        Vec<u32> levelStart; // the first slot of each depth, and the end
+
+        // by id
+        Vec<u32> slotOf, generationOf;
+        Vec<u32> freeIds;
+
+        bool needsLayout = false;
+        u32 dirtyCount = 0, lastUpdated = 0;
+        Stats stats;
+    public:
+        // levels smaller than this are done on the calling thread
+        static constexpr u32 PARALLEL_MIN = 2048, PARALLEL_CHUNK = 512;
+
+        SceneGraph() = default;
+
+        Handle Add(const Math::Transform3D& localTransform, Handle parent);
+        Handle Add(const Math::Transform2D& localTransform, Handle parent) { return Add(localTransform.As3D(), parent); }
+        Handle Add(const Math::Transform3D& localTransform) { return Add(localTransform, Handle {}); }
+        Handle Add(const Math::Transform2D& localTransform) { return Add(localTransform.As3D(), Handle {}); }
+        // takes everything under it as well
+        void Remove(Handle h);
+        void Clear();
+        // the local transform stays, so the node moves with its new parent. false if it would be its own ancestor
+        bool SetParent(Handle h, Handle parent);
+        Handle ParentOf(Handle h) const;
+
+        void SetLocal(Handle h, const Math::Transform3D& t) { EditLocal(h) = t; }
+        void SetLocal(Handle h, const Math::Transform2D& t) { EditLocal(h) = t.As3D(); }
+        Math::Transform3D& EditLocal(Handle h) { const u32 s = SlotOf(h); MarkDirty(s); return local[s]; }
+        const Math::Transform3D& GetLocal(Handle h) const { return local[SlotOf(h)]; }
+
+        // recomputes the world transforms of the changed nodes and their subtrees
+        void Update(bool parallel = true);
+
+        // as of the last Update. the matrix is exact, the transform loses shearing from
+        // non uniform scales under rotations, but is what a mesh's model transform takes
+        const Math::Matrix3D& GetWorldMatrix(Handle h) const { return worldMatrix[SlotOf(h)]; }
+        const Math::Transform3D& GetWorld(Handle h) const { return world[SlotOf(h)]; }
+        // for 2d meshes, the part of the world transform in the xy plane
+        Math::Transform2D GetWorld2D(Handle h) const;
+        // whether the last Update changed this node's world transform
+        bool WasUpdated(Handle h) const { return updated[SlotOf(h)]; }
+
+        bool Contains(Handle h) const {
+            return h.id < slotOf.Length() && slotOf[h.id] != NONE && generationOf[h.id] == h.generation;
+        }
+        u32 Count() const { return ids.Length(); }
+        u32 Depth() const { return levelStart.IsEmpty() ? 0 : levelStart.Length() - 1; }
+        const Stats& GetStats() const { return stats; }
+        void ResetStats() { stats = {}; }
+    private:
+        // the accessors take live handles only
+        u32 SlotOf(Handle h) const {
+            Debug::QAssertMsg$(Contains(h), "scene graph handle is null or was removed");
+            return slotOf[h.id];
+        }
+        Handle HandleOf(u32 id) const { return id == NONE ? Handle {} : Handle { id, generationOf[id] }; }
+        void FreeId(u32 id);
+        void MarkDirty(u32 slot);
+        void Layout();
+        void UpdateRange(u32 begin, u32 end);
+    };
+}
@@ -0,0 +1,172 @@
+#include "ShaderReloader.h"
+
+#include "Utils/CStr.h"
+#include "Utils/Text.h"
+#include "GLDebug.h"
+
+namespace Quasi::Graphics {
+    namespace {
+        // the paths are stored with their terminator so they can be handed out as CStr
+        String ZeroTerminated(Str path) {
+            String z = String { path };
+            z += '\0';
+            return z;
+        }
+
+        CStr AsCStr(const String& zpath) {
+            return CStr::SliceUnchecked(zpath.Data(), zpath.Length() - 1);
+        }
+
+        Str AsStr(const String& zpath) {
+            return Str::Slice(zpath.Data(), zpath.Length() - 1);
+        }
+
+        bool IsSet(const String& zpath) { return zpath.Length() > 1; }
+
+        std::filesystem::path AsPath(const String& zpath) {
+            return std::string_view { zpath.Data(), zpath.Length() - 1 };
+        }
+    }
+
+    void ShaderReloader::LoadAsync(Shader& target, Str file) { Add(target, file, {}, {}, false); }
+    void ShaderReloader::LoadAsync(Shader& target, Str vert, Str frag, Str geom) { Add(target, vert, frag, geom, false); }
+    void ShaderReloader::Watch(Shader& target, Str file) { Add(target, file, {}, {}, true); }
+    void ShaderReloader::Watch(Shader& target, Str vert, Str frag, Str geom) { Add(target, vert, frag, geom, true); }
+
+    void ShaderReloader::Add(Shader& target, Str vert, Str frag, Str geom, bool watch) {
+        Unwatch(target);
+        Watched& w = watched.Push({});
+        w.target = target;
+        w.files[0] = ZeroTerminated(vert);
+        w.files[1] = ZeroTerminated(frag);
+        w.files[2] = ZeroTerminated(geom);
+        w.keepWatching = watch;
+
+        PollChanged(w); // only to take the current timestamps
+        if (!watch || target.IsNull()) StartReading(w);
+    }
+
+    OptRef<ShaderReloader::Watched> ShaderReloader::Find(const Shader& target) {
+        for (Watched& w : watched)
+            if (&*w.target == &target) return w;
+        return nullptr;
+    }
+
+    void ShaderReloader::Unwatch(const Shader& target) {
+        for (usize i = 0; i < watched.Length(); ++i) {
+            if (&*watched[i].target != &target) continue;
+            // a read in flight is waited on by the future's destructor, it only reads files
+            watched.PopUnordered(i);
+            return;
+        }
+    }
+
+    void ShaderReloader::Reload(const Shader& target) {
+        OptRef<Watched> w = Find(target);
+        if (w && !w->reading.valid() && w->building.IsNull()) StartReading(*w);
+    }
+
+    void ShaderReloader::StartReading(Watched& w) {
+        w.reading = std::async(std::launch::async, [vert = w.files[0], frag = w.files[1], geom = w.files[2]] {
+            return ReadSources(vert, frag, geom);
+        });
+    }
+
+    Option<ShaderProgramSource> ShaderReloader::ReadSources(const String& vert, const String& frag, const String& geom) {
+        // runs on the worker, so it doesnt log. a failed read is reported by Update
+        const String* files[3] = { &vert, &frag, &geom };
+        if (!IsSet(frag)) {
+            const Option<String> program = Text::ReadFile(AsCStr(vert));
+            if (!program) return nullptr;
+            return Options::Some(Shader::ParseShader(program.Unwrap()));
+        }
+
+        Option<String> stages[3];
+        for (u32 i = 0; i < 3; ++i) {
+            if (!IsSet(*files[i])) continue;
+            stages[i] = Text::ReadFile(AsCStr(*files[i]));
+            if (!stages[i]) return nullptr;
+        }
+        const usize vlen = stages[0].Unwrap().Length(), flen = stages[1].Unwrap().Length();
+        String full = String::WithCap(vlen + flen + (stages[2] ? stages[2].Unwrap().Length() : 0));
+        for (const Option<String>& s : stages)
+            if (s) full += Str { s.Unwrap() };
+        return Options::Some(ShaderProgramSource { std::move(full), { vlen, vlen + flen } });
+    }
+
+    bool ShaderReloader::PollChanged(Watched& w) {
+        bool changed = false;
+        for (u32 i = 0; i < 3; ++i) {
+            if (!IsSet(w.files[i])) continue;
+            std::error_code err;
+            const FileTime stamp = std::filesystem::last_write_time(AsPath(w.files[i]), err);
+            // missing for a moment while an editor saves, the next poll will see it
+            if (err || stamp == w.stamps[i]) continue;
+            w.stamps[i] = stamp;
+            changed = true;
+        }
+        return changed;
+    }
+
+    void ShaderReloader::Update() {
+        const bool poll = ++frame % POLL_INTERVAL_FRAMES == 0;
+        for (usize i = 0; i < watched.Length(); ++i) {
+            Watched& w = watched[i];
+            bool done = false;
+
+            if (w.reading.valid()) {
+                if (w.reading.wait_for(std::chrono::seconds(0)) != std::future_status::ready) continue;
+                const Option<ShaderProgramSource> source = w.reading.get();
+                if (source) {
+                    w.building = Shader::BeginCreate(
+                        source->GetShader(ShaderType::VERTEX),
+                        source->GetShader(ShaderType::FRAGMENT),
+                        source->GetShader(ShaderType::GEOMETRY));
+                } else {
+                    ++w.failures;
+                    GLLogger().Warn("couldn't read the sources of '{}', keeping the old shader", AsStr(w.files[0]));
+                    done = true;
+                }
+            } else if (!w.building.IsNull()) {
+                if (!w.building.IsReady()) continue;
+                Shader built = w.building.Finish();
+                if (built) {
+                    // the old program is deleted here, nothing has been drawn with it yet this frame
+                    *w.target = std::move(built);
+                    ++w.reloads;
+                    if (w.onReload) w.onReload->Run(*w.target);
+                } else {
+                    ++w.failures;
+                    GLLogger().Warn("'{}' failed to build, keeping the old shader", AsStr(w.files[0]));
+                }
+                done = true;
+            } else if (poll && w.keepWatching && PollChanged(w)) {
+                StartReading(w);
+            }
+
+            if (done && !w.keepWatching) {
+                watched.PopUnordered(i);
+                --i;
+            }
+        }
+    }
+
+    u32 ShaderReloader::ReloadCount(const Shader& target) const {
+        for (const Watched& w : watched)
+            if (&*w.target == &target) return w.reloads;
+        return 0;
+    }
+
+    u32 ShaderReloader::InFlightCount() const {
+        u32 count = 0;
+        for (const Watched& w : watched)
+            count += w.reading.valid() || !w.building.IsNull();
+        return count;
+    }
+
+    u32 ShaderReloader::FailureCount() const {
+        u32 count = 0;
+        for (const Watched& w : watched) count += w.failures;
+        return count;
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <filesystem>
+#include <future>
+
+#include "Utils/Box.h"
+#include "Utils/Option.h"
+#include "Utils/Ref.h"
+#include "Utils/Vec.h"
+#include "Graphics/GLs/Shader.h"
+
+namespace Quasi::Graphics {
+    // builds shaders from files without stalling the frame, and rebuilds them when the files change.
+    // the files are read and split on a worker thread, compiled by the driver (on its own threads
+    // with KHR_parallel_shader_compile) and the shader is only swapped once the new program linked.
+    // if it fails the old program keeps drawing. the target has to stay where it is while watched.
+    // whatever was set on the old program (uniform blocks, sampler units, handles from Shader::Uniform)
+    // is gone after a swap, OnReload is where its set up again
+    class ShaderReloader {
+        using FileTime = std::filesystem::file_time_type;
+
+        struct ReloadHook {
+            virtual ~ReloadHook() = default;
+            virtual void Run(Shader& shader) = 0;
+        };
+
+        template <class F>
+        struct ReloadHookOf : ReloadHook {
+            F func;
+            explicit ReloadHookOf(auto&& f) : func((decltype(f))f) {}
+            void Run(Shader& shader) override { func(shader); }
+        };
+
+        struct Watched {
+            OptRef<Shader> target;
+            String files[3]; // vertex, fragment, geometry. a single file with #shader sections only has the first
+            FileTime stamps[3] {};
+            bool keepWatching = false;
+            std::future<Option<ShaderProgramSource>> reading;
+            PendingShader building;
+            Box<ReloadHook> onReload;
+            u32 reloads = 0, failures = 0;
+        };
+
+        Vec<Watched> watched;
+        u32 frame = 0;
+    public:
+        // how often the files are checked for changes
+        static constexpr u32 POLL_INTERVAL_FRAMES = 15;
+
+        ShaderReloader() = default;
+        ShaderReloader(const ShaderReloader&) = delete;
+        ShaderReloader& operator=(const ShaderReloader&) = delete;
+        ShaderReloader(ShaderReloader&&) noexcept = default;
+        ShaderReloader& operator=(ShaderReloader&&) noexcept = default;
+
+        // the target keeps what it had, or stays null, until the shader is built
+        void LoadAsync(Shader& target, Str file);
+        void LoadAsync(Shader& target, Str vert, Str frag, Str geom = {});
+        // loads right away if the target is null, then rebuilds on every change
+        void Watch(Shader& target, Str file);
+        void Watch(Shader& target, Str vert, Str frag, Str geom = {});
+        void Unwatch(const Shader& target);
+        // starts a rebuild even if nothing changed
+        void Reload(const Shader& target);
+        // called as f(Shader&) with the target right after every swap. does nothing if the target isnt watched
+        template <class F>
+        void OnReload(const Shader& target, F&& f) {
+            if (OptRef<Watched> w = Find(target))
+                w->onReload = Box<ReloadHook>::Own(new ReloadHookOf<std::decay_t<F>>((F&&)f));
+        }
+
+        // moves everything in flight along, never blocks. the GraphicsDevice calls this every frame
+        void Update();
+
+        u32 ReloadCount(const Shader& target) const;
+        usize WatchCount() const { return watched.Length(); }
+        u32 InFlightCount() const;
+        u32 FailureCount() const;
+    private:
+        void Add(Shader& target, Str vert, Str frag, Str geom, bool watch);
+        OptRef<Watched> Find(const Shader& target);
+        static void StartReading(Watched& w);
+        static bool PollChanged(Watched& w);
+        static Option<ShaderProgramSource> ReadSources(const String& vert, const String& frag, const String& geom);
+    };
+}
@@ -0,0 +1,292 @@
+#pragma once
+#include "GraphicsDevice.h"
+#include "Mesh.h"
+
+namespace Quasi::Graphics {
+    // meshes that are uploaded once and then drawn straight from gpu memory. the vertices stay in
+    // local space and the model transform is given to the shader as u_model (a mat4), so moving a
+    // mesh uploads nothing. a mesh is only uploaded again after MarkDirty, on the next Sync.
+    // shaders without u_model draw the vertices as they were uploaded
+    template <IVertex T>
+    class StaticMeshes {
+    public:
+        struct Handle {
+            u32 id = ~0u;
+            bool IsNull() const { return id == ~0u; }
+        };
+
+        struct Stats {
+            u32 uploads = 0, draws = 0, compactions = 0;
+            usize uploadedBytes = 0;
+        };
+    private:
+        struct Slot {
+            OptRef<const Mesh<T>> source; // null if the slot is free
+            u32 firstVertex = 0, vertexCount = 0, vertexCap = 0;
+            u32 firstIndex  = 0, indexCount  = 0, indexCap  = 0;
+            bool dirty = false;
+        };
+
+        RenderObject<T> render;
+        Vec<Slot> slots;
+        u32 vertexTop = 0, indexTop = 0;
+        u32 vertexCapacity = 0, indexCapacity = 0;
+        u32 dirtyCount = 0;
+        Stats stats;
+        // u_model, looked up again only when drawing with another program. a reloaded program can
+        // keep its gl name, so this is the serial of its reflection
+        u32 modelProgram = 0;
+        UniformHandle modelUniform;
+
+        explicit StaticMeshes(RenderObject<T> ro, u32 vcap, u32 icap)
+            : render(ro), vertexCapacity(vcap), indexCapacity(icap) {}
+    public:
+        StaticMeshes() = default;
+        static StaticMeshes New(GraphicsDevice& gd, u32 maxVertices, u32 maxTriangles) {
+            return StaticMeshes { gd.CreateNewRender<T>(maxVertices, maxTriangles), maxVertices, maxTriangles * 3 };
+        }
+
+        // the mesh is uploaded right away, and read again on Sync whenever it is marked dirty,
+        // so it has to stay where it is until removed
+        Handle Add(const Mesh<T>& mesh);
+        void Remove(Handle h);
+        // the geometry changed, transforms dont need this
+        void MarkDirty(Handle h);
+        // uploads every dirty mesh
+        void Sync();
+        // squeezes out the gaps left by removed or grown meshes, this uploads everything
+        void Compact();
+
+        void Draw(Handle h, const DrawOptions& options = {});
+        void DrawAll(const DrawOptions& options = {});
+        // puts the meshes in the render queue, where they end up in one multi draw. the queue has no
+        // per item u_model, so shaders that read it draw every mesh right away instead
+        void Submit(Span<const Handle> handles, const DrawOptions& options = {}, u32 layer = 0);
+
+        bool Contains(Handle h) const { return h.id < slots.Length() && slots[h.id].source; }
+        u32 Count() const;
+        u32 DirtyCount() const { return dirtyCount; }
+        u32 UsedVertices() const { return vertexTop; }
+        u32 UsedIndices() const { return indexTop; }
+        const Stats& GetStats() const { return stats; }
+        void ResetStats() { stats = {}; }
+
+        RenderObject<T>& GetRender() { return render; }
+        RenderData* operator->() { return &render.GetRenderData(); }
+        void Destroy() { render.Destroy(); slots.Clear(); vertexTop = indexTop = dirtyCount = 0; modelProgram = 0; }
+    private:
+        bool Allocate(Slot& slot, u32 vertexCount, u32 indexCount);
+        void Upload(Slot& slot);
+        void Write(Slot& slot);
+        UniformHandle ModelUniformOf(Shader& shader);
+
+        static Math::Matrix3D ModelMatrix(const Math::Transform2D& t) { return t.As3D().TransformMatrix(); }
+        static Math::Matrix3D ModelMatrix(const Math::Transform3D& t) { return t.TransformMatrix(); }
+    };
+
+    template <IVertex T>
+    typename StaticMeshes<T>::Handle StaticMeshes<T>::Add(const Mesh<T>& mesh) {
+        u32 id = 0;
+        while (id < slots.Length() && slots[id].source) ++id;
+        if (id == slots.Length()) slots.Push({});
+
+        Slot& slot = slots[id];
+        slot.source = mesh;
+        slot.dirty = false;
+        Upload(slot);
+        return { id };
+    }
+
+    template <IVertex T>
+    void StaticMeshes<T>::Remove(Handle h) {
+        if (!Contains(h)) return;
+        Slot& slot = slots[h.id];
+        if (slot.dirty) --dirtyCount;
+        // the range stays with the slot, the next mesh that fits can reuse it
+        slot.source = nullptr;
+        slot.dirty = false;
+        slot.vertexCount = slot.indexCount = 0;
+    }
+
+    template <IVertex T>
+    void StaticMeshes<T>::MarkDirty(Handle h) {
+        if (!Contains(h) || slots[h.id].dirty) return;
+        slots[h.id].dirty = true;
+        ++dirtyCount;
+    }
+
+    template <IVertex T>
+    void StaticMeshes<T>::Sync() {
+        if (!dirtyCount) return;
+        for (Slot& slot : slots) {
+            if (!slot.dirty) continue;
+            slot.dirty = false;
+            Upload(slot);
+        }
+        dirtyCount = 0;
+    }
+
+    template <IVertex T>
+    u32 StaticMeshes<T>::Count() const {
+        u32 count = 0;
+        for (const Slot& slot : slots) count += (bool)slot.source;
+        return count;
+    }
+
+    template <IVertex T>
+    bool StaticMeshes<T>::Allocate(Slot& slot, u32 vertexCount, u32 indexCount) {
+        if (vertexCount <= slot.vertexCap && indexCount <= slot.indexCap) return true;
+        // a free slot with a big enough range gives it up, so ranges get reused before the top grows
+        for (Slot& other : slots) {
+            if (other.source || &other == &slot || other.vertexCap < vertexCount || other.indexCap < indexCount) continue;
+            std::swap(slot.firstVertex, other.firstVertex); std::swap(slot.vertexCap, other.vertexCap);
+            std::swap(slot.firstIndex,  other.firstIndex);  std::swap(slot.indexCap,  other.indexCap);
+            return true;
+        }
+        if (vertexTop + vertexCount > vertexCapacity || indexTop + indexCount > indexCapacity) return false;
+        slot.firstVertex = vertexTop; slot.vertexCap = vertexCount;
+        slot.firstIndex  = indexTop;  slot.indexCap  = indexCount;
+        vertexTop += vertexCount;
+        indexTop  += indexCount;
+        return true;
+    }
+
+    template <IVertex T>
+    void StaticMeshes<T>::Upload(Slot& slot) {
+        const Mesh<T>& mesh = *slot.source;
+        // when nothing fits, compacting lays out and uploads every mesh, this one included.
+        // it also widens the indices when this mesh is too big for u16 ones
+        if (render.GetRenderData().ibo.IsShort() && mesh.vertices.Length() > IndexBuffer::SHORT_LIMIT) return Compact();
+        if (!Allocate(slot, mesh.vertices.Length(), mesh.indices.Length() * 3)) return Compact();
+        Write(slot);
+    }
+
+    template <IVertex T>
+    void StaticMeshes<T>::Write(Slot& slot) {
+        const Mesh<T>& mesh = *slot.source;
+        slot.vertexCount = mesh.vertices.Length();
+        slot.indexCount  = mesh.indices.Length() * 3;
+
+        // indices are kept as they are, the draw offsets them by firstVertex
+        RenderData& rd = render.GetRenderData();
+        rd.FlushQueued();
+        rd.vbo.SetDataBytes(mesh.vertices.AsSpan().AsBytes(), slot.firstVertex * sizeof(T));
+        rd.ibo.SetData(mesh.indices.AsSpan(), slot.firstIndex * rd.ibo.IndexSize());
+        ++stats.uploads;
+        stats.uploadedBytes += slot.vertexCount * sizeof(T) + slot.indexCount * rd.ibo.IndexSize();
+    }
+
+    template <IVertex T>
+    void StaticMeshes<T>::Compact() {
+        // queued draws still point at the old ranges
+        render.GetRenderData().FlushQueued();
+        // laid out by the current size of each mesh, so dirty ones fit too
+        u32 vertexEnd = 0, indexEnd = 0;
+        for (Slot& slot : slots) {
+            slot.vertexCap = slot.source ? slot.source->vertices.Length() : 0;
+            slot.indexCap  = slot.source ? slot.source->indices.Length() * 3 : 0;
+            slot.firstVertex = vertexEnd;
+            slot.firstIndex  = indexEnd;
+            vertexEnd += slot.vertexCap;
+            indexEnd  += slot.indexCap;
+        }
+        vertexTop = vertexEnd;
+        indexTop  = indexEnd;
+
+        // everything is uploaded again right after, so growing doesnt copy anything over
+        RenderData& rd = render.GetRenderData();
+        if (vertexTop > vertexCapacity) {
+            vertexCapacity = std::max(vertexTop, vertexCapacity * 2);
+            rd.vbo.Resize(vertexCapacity * sizeof(T));
+        }
+        // indices are drawn from each mesh's first vertex, so u16 ones only need every mesh to be small enough
+        u32 largestMesh = 0;
+        for (const Slot& slot : slots) largestMesh = std::max(largestMesh, slot.vertexCap);
+        const GLTypeID indexType = rd.ibo.IsShort() ? IndexBuffer::TypeFor(largestMesh) : GLTypeID::UINT;
+        if (indexTop > indexCapacity || indexType != rd.ibo.GetIndexType()) {
+            indexCapacity = std::max(indexTop, indexTop > indexCapacity ? indexCapacity * 2 : indexCapacity);
+            rd.ibo.Reformat(indexCapacity, indexType);
+        }
+
+        for (Slot& slot : slots) {
+            slot.dirty = false;
+            if (slot.source) Write(slot);
+        }
+        dirtyCount = 0;
+        ++stats.compactions;
+    }
+
+    template <IVertex T>
+    void StaticMeshes<T>::Draw(Handle h, const DrawOptions& options) {
+        if (!Contains(h)) return;
+        const Slot& slot = slots[h.id];
+        if (!slot.indexCount) return;
+
+        RenderData& rd = render.GetRenderData();
+        Shader& shader = Memory::AsMut(options.shader.UnwrapOr(rd.shader));
+        if (shader.IsNull()) return;
+        shader.Bind();
+        shader.SetUniformDyn(ModelUniformOf(shader), ModelMatrix(slot.source->modelTransform));
+        options.ActivateTexture();
+
+        rd.drawRange = {
+            .indexCount  = slot.indexCount,
+            .firstIndex  = slot.firstIndex,
+            .baseVertex  = slot.firstVertex,
+            .vertexCount = slot.vertexCount,
+        };
+        rd.Render(shader, options.arguments, options.useDefaultArguments);
+        ++stats.draws;
+    }
+
+    template <IVertex T>
+    void StaticMeshes<T>::Submit(Span<const Handle> handles, const DrawOptions& options, u32 layer) {
+        RenderData& rd = render.GetRenderData();
+        Shader& shader = Memory::AsMut(options.shader.UnwrapOr(rd.shader));
+        if (shader.IsNull() || !rd.device) return;
+        if (ModelUniformOf(shader).IsValid()) {
+            for (const Handle h : handles) Draw(h, options);
+            return;
+        }
+
+        RenderQueue& queue = rd.device->GetRenderQueue();
+        // one handle for every mesh, so they can be merged
+        const u32 args = options.arguments.size() ? queue.PushArgs(options.arguments) : ~0;
+        for (const Handle h : handles) {
+            if (!Contains(h) || !slots[h.id].indexCount) continue;
+            const Slot& slot = slots[h.id];
+            queue.Submit({
+                .render = rd,
+                .range = {
+                    .indexCount  = slot.indexCount,
+                    .firstIndex  = slot.firstIndex,
+                    .baseVertex  = slot.firstVertex,
+                    .vertexCount = slot.vertexCount,
+                },
+                .useWholeRender = false,
+                .shader = options.shader,
+                .texture = options.texture,
+                .textureSlot = options.textureSlot,
+                .argsHandle = args,
+                .useDefaultArguments = options.useDefaultArguments,
+                .layer = layer,
+            });
+            ++stats.draws;
+        }
+    }
+
+    template <IVertex T>
+    UniformHandle StaticMeshes<T>::ModelUniformOf(Shader& shader) {
+        if (shader.Reflection().serial != modelProgram) {
+            modelProgram = shader.Reflection().serial;
+            modelUniform = shader.Uniform("u_model");
+        }
+        return modelUniform;
+    }
+
+    template <IVertex T>
+    void StaticMeshes<T>::DrawAll(const DrawOptions& options) {
+        for (u32 i = 0; i < slots.Length(); ++i)
+            Draw({ i }, options);
+    }
+}
@@ -69,8 +69,8 @@ namespace Quasi::Graphics::MeshUtils {
             // loop cut
             for (u32 x = 1; x <= opt.sections.x; ++x) {
                 const u32 prevX = x == 1 ? opt.sections.x : x - 1;
-                mesh.PushIndex(lastLoopIndex - prevX, 2 * lastLoopIndex - prevX,     lastLoopIndex - x);
-                mesh.PushIndex(lastLoopIndex - x,     2 * lastLoopIndex - prevX, 2 * lastLoopIndex - x);
+                mesh.PushIndex({ lastLoopIndex - prevX, 2 * lastLoopIndex - prevX,     lastLoopIndex - x });
+                mesh.PushIndex({ lastLoopIndex - x,     2 * lastLoopIndex - prevX, 2 * lastLoopIndex - x });
             }
         }
     };
@@ -1,11 +1,43 @@
 #pragma once
+#include <cstring>
+#include <mutex>
+#include <type_traits>
 #include <utility>
 
+#include "Mesh.h"
 #include "VertexElement.h"
+#include "Utils/Box.h"
 
 namespace Quasi::Graphics::MeshUtils {
     template <class T>
     struct OptionsFor {};
+
+    namespace details {
+        // options that can be compared byte by byte: no floats (a size would get its own entry and
+        // -0 isnt 0) and no padding. options without fields are all the same
+        template <class Key> concept CacheKey = std::is_empty_v<Key> || std::has_unique_object_representations_v<Key>;
+
+        // meshes made once per options and kept for the whole program, boxed so they never move
+        template <CacheKey Key, class T>
+        struct MeshCache {
+            struct Entry { Key key; Box<T> value; };
+            Vec<Entry> entries;
+            std::mutex lock;
+
+            const T& GetOrMake(const Key& key, Fn<T> auto&& make) {
+                std::lock_guard guard { lock };
+                for (const Entry& e : entries)
+                    if (SameKey(e.key, key)) return *e.value;
+                entries.Push({ key, Box<T>::New(make()) });
+                return *entries.Last().value;
+            }
+
+            static bool SameKey(const Key& a, const Key& b) {
+                if constexpr (std::is_empty_v<Key>) return true;
+                else return std::memcmp(&a, &b, sizeof(Key)) == 0;
+            }
+        };
+    }
     
     template <class R, class MD> concept MTransformer =
         std::is_same_v<VertexBuilder::MeshConstructData2D, MD> && Math::ITransformer2D<R> ||
@@ -62,6 +94,47 @@ namespace Quasi::Graphics::MeshUtils {
             return Create({}, std::forward<F>(f), transform);
         }
 
+        // the primitive before any blueprint, made the first time these options are asked for and kept
+        // from then on. every different options stays cached, so only primitives whose options are
+        // subdivisions can be cached (not capsules or stadiums, their sizes are options), and sizes
+        // and positions are left to the blueprint or a transform
+        static const Mesh<MData>& Geometry(const Options& options = {}) requires details::CacheKey<Options> {
+            static details::MeshCache<Options, Mesh<MData>> cache;
+            return cache.GetOrMake(options, [&] { return Create(options, [] (const MData& data) { return data; }); });
+        }
+
+        // the same as Merge, but the geometry comes from the cache and only the blueprint runs
+        template <class F> requires details::CacheKey<Options>
+        static void MergeCached(const Options& options, F&& f, Mesh<ResultingV<F>>& out) {
+            const Mesh<MData>& geometry = Geometry(options);
+            auto meshp = out.NewBatch();
+            out.vertices.Reserve(geometry.vertices.Length());
+            for (const MData& data : geometry.vertices) meshp.PushV(f(data));
+            for (const TriIndices& i : geometry.indices) meshp.PushI(i);
+        }
+
+        template <class F> requires details::CacheKey<Options>
+        static auto CreateCached(const Options& options, F&& f) {
+            Mesh<ResultingV<F>> out;
+            MergeCached(options, std::forward<F>(f), out);
+            return out;
+        }
+
+        template <class F> requires details::CacheKey<Options>
+        static auto CreateCached(const Options& options, F&& f, const MTransformer<MData> auto& transform) {
+            Mesh<ResultingV<F>> out = CreateCached(options, std::forward<F>(f));
+            VertexMulBatch(out.vertices.Data(), Memory::TransmutePtr<byte>(out.vertices.Data()), out.vertices.Length(), transform);
+            return out;
+        }
+
+        // a blueprint capturing nothing always makes the same mesh, so the whole mesh is cached, per
+        // blueprint and options. every call gives back the same one, copy it to give it its own transform
+        template <class F> requires std::is_empty_v<RemRef<F>> && details::CacheKey<Options>
+        static const Mesh<ResultingV<F>>& Shared(const Options& options, F&& f) {
+            static details::MeshCache<Options, Mesh<ResultingV<F>>> cache;
+            return cache.GetOrMake(options, [&] { return CreateCached(options, f); });
+        }
+
         template <class F>
         auto operator()(const Options& options, F&& f) const {
             return Create(options, f);
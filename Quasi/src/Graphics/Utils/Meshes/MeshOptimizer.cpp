@@ -0,0 +1,472 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace Quasi::Graphics::MeshOptimizer {
+    namespace {
+        u32 VertexOf(const TriIndices& t, u32 c) { return c == 0 ? t.i : c == 1 ? t.j : t.k; }
+
+        bool IsValid(const TriIndices& t, u32 vertexCount) {
+            return t.i < vertexCount && t.j < vertexCount && t.k < vertexCount;
+        }
+
+        // the cache the scores pretend to have, bigger than any real one so the order works on all of them
+        constexpr u32 SCORE_CACHE = 32, MAX_VALENCE_SCORE = 32;
+
+        struct ScoreTables {
+            float cache[SCORE_CACHE + 3] {}, valence[MAX_VALENCE_SCORE] {};
+
+            ScoreTables() {
+                // the last triangle's vertices all score the same, they're in the cache no matter the order
+                for (u32 i = 0; i < SCORE_CACHE + 3; ++i)
+                    cache[i] = i < 3 ? 0.75f : i < SCORE_CACHE ? std::pow(1.0f - (float)(i - 3) / (SCORE_CACHE - 3), 1.5f) : 0.0f;
+                // vertices with few triangles left get finished first, so they leave the cache for good
+                for (u32 v = 1; v < MAX_VALENCE_SCORE; ++v) valence[v] = 2.0f / std::sqrt((float)v);
+            }
+
+            float Score(i32 cachePos, u32 remaining) const {
+                if (remaining == 0) return -1.0f;
+                const float c = cachePos < 0 ? 0.0f : cache[cachePos];
+                return c + (remaining < MAX_VALENCE_SCORE ? valence[remaining] : 2.0f / std::sqrt((float)remaining));
+            }
+        };
+
+        Math::fVector3 ReadPosition(const byte* positions, usize stride, u32 v) {
+            Math::fVector3 p;
+            std::memcpy(&p, positions + v * stride, sizeof(p));
+            return p;
+        }
+
+        // the squared distance to a set of planes (weighted by their area), as a symmetric 4x4 matrix
+        struct Quadric {
+            float xx = 0, yy = 0, zz = 0, xy = 0, xz = 0, yz = 0, x = 0, y = 0, z = 0, w = 0;
+            float weight = 0;
+
+            static Quadric Plane(const Math::fVector3& n, float d, float weight) {
+                return { n.x * n.x * weight, n.y * n.y * weight, n.z * n.z * weight,
+                         n.x * n.y * weight, n.x * n.z * weight, n.y * n.z * weight,
+                         n.x * d * weight,   n.y * d * weight,   n.z * d * weight, d * d * weight, weight };
+            }
+
+            Quadric& operator+=(const Quadric& q) {
+                xx += q.xx; yy += q.yy; zz += q.zz; xy += q.xy; xz += q.xz; yz += q.yz;
+                x += q.x; y += q.y; z += q.z; w += q.w;
+                weight += q.weight;
+                return *this;
+            }
+
+            // the average squared distance, so big flat areas dont hide how far a vertex moves
+            float Error(const Math::fVector3& p) const {
+                const float ax = xx * p.x + xy * p.y + xz * p.z,
+                            ay = xy * p.x + yy * p.y + yz * p.z,
+                            az = xz * p.x + yz * p.y + zz * p.z;
+                const float e = p.x * ax + p.y * ay + p.z * az + 2 * (x * p.x + y * p.y + z * p.z) + w;
+                return weight > 0 ? std::abs(e) / weight : 0;
+            }
+        };
+
+        u64 EdgeKey(u32 a, u32 b) { return a < b ? (u64)a << 32 | b : (u64)b << 32 | a; }
+    }
+
+    CacheStats AnalyzeVertexCache(Span<const TriIndices> triangles, u32 vertexCount, u32 cacheSize) {
+        CacheStats stats;
+        // a vertex is still cached if fewer than cacheSize misses happened since it was loaded
+        Vec<u32> loadedAt;
+        loadedAt.Resize(vertexCount, 0);
+        u32 time = cacheSize + 1;
+        for (const TriIndices& t : triangles) {
+            if (!IsValid(t, vertexCount)) continue;
+            ++stats.triangles;
+            for (u32 c = 0; c < 3; ++c) {
+                const u32 v = VertexOf(t, c);
+                if (loadedAt[v] == 0) ++stats.vertices;
+                if (time - loadedAt[v] > cacheSize) {
+                    loadedAt[v] = time++;
+                    ++stats.transforms;
+                }
+            }
+        }
+        stats.acmr = stats.triangles ? (float)stats.transforms / (float)stats.triangles : 0;
+        stats.atvr = stats.vertices  ? (float)stats.transforms / (float)stats.vertices  : 0;
+        return stats;
+    }
+
+    void OptimizeVertexCache(Span<TriIndices> triangles, u32 vertexCount) {
+        static const ScoreTables SCORES;
+        const u32 triCount = triangles.Length();
+        if (triCount == 0) return;
+
+        // the triangles of each vertex, the live ones are kept at the front of its range
+        Vec<u32> firstTri, liveTris, triOfVertex;
+        firstTri.Resize(vertexCount + 1, 0);
+        liveTris.Resize(vertexCount, 0);
+        for (const TriIndices& t : triangles) {
+            if (!IsValid(t, vertexCount)) continue;
+            for (u32 c = 0; c < 3; ++c) ++liveTris[VertexOf(t, c)];
+        }
+        for (u32 v = 0; v < vertexCount; ++v) firstTri[v + 1] = firstTri[v] + liveTris[v];
+        triOfVertex.Resize(firstTri[vertexCount], 0);
+        {
+            Vec<u32> filled;
+            filled.Resize(vertexCount, 0);
+            for (u32 t = 0; t < triCount; ++t) {
+                if (!IsValid(triangles[t], vertexCount)) continue;
+                for (u32 c = 0; c < 3; ++c) {
+                    const u32 v = VertexOf(triangles[t], c);
+                    triOfVertex[firstTri[v] + filled[v]++] = t;
+                }
+            }
+        }
+
+        Vec<float> vertexScore, triScore;
+        vertexScore.Resize(vertexCount, 0);
+        triScore.Resize(triCount, 0);
+        for (u32 v = 0; v < vertexCount; ++v) vertexScore[v] = SCORES.Score(-1, liveTris[v]);
+
+        Vec<bool> emitted;
+        emitted.Resize(triCount, false);
+        for (u32 t = 0; t < triCount; ++t) {
+            if (!IsValid(triangles[t], vertexCount)) { emitted[t] = true; continue; }
+            for (u32 c = 0; c < 3; ++c) triScore[t] += vertexScore[VertexOf(triangles[t], c)];
+        }
+
+        Vec<TriIndices> output = Vec<TriIndices>::WithCap(triCount);
+        u32 cache[SCORE_CACHE + 3], cacheLength = 0, nextCache[SCORE_CACHE + 3];
+        u32 cursor = 0;
+        i32 best = -1;
+        for (u32 t = 0; t < triCount; ++t)
+            if (!emitted[t] && (best < 0 || triScore[t] > triScore[best])) best = (i32)t;
+
+        while (best >= 0) {
+            const TriIndices tri = triangles[best];
+            output.Push(tri);
+            emitted[best] = true;
+
+            // the triangle's vertices go to the front, everything else moves back
+            u32 nextLength = 0;
+            for (u32 c = 0; c < 3; ++c) {
+                const u32 v = VertexOf(tri, c);
+                u32* live = triOfVertex.Data() + firstTri[v];
+                for (u32 i = 0; i < liveTris[v]; ++i) {
+                    if (live[i] != (u32)best) continue;
+                    std::swap(live[i], live[liveTris[v] - 1]);
+                    --liveTris[v];
+                    break;
+                }
+                if (std::find(nextCache, nextCache + nextLength, v) == nextCache + nextLength)
+                    nextCache[nextLength++] = v;
+            }
+            const u32 triLength = nextLength;
+            for (u32 i = 0; i < cacheLength; ++i)
+                if (std::find(nextCache, nextCache + triLength, cache[i]) == nextCache + triLength)
+                    nextCache[nextLength++] = cache[i];
+
+            // rescoring every vertex that was or is in the cache covers the evicted ones too
+            for (u32 i = 0; i < nextLength; ++i) {
+                const u32 v = nextCache[i];
+                const float score = SCORES.Score(i < SCORE_CACHE ? (i32)i : -1, liveTris[v]);
+                const float delta = score - vertexScore[v];
+                vertexScore[v] = score;
+                const u32* live = triOfVertex.Data() + firstTri[v];
+                for (u32 j = 0; j < liveTris[v]; ++j) triScore[live[j]] += delta;
+            }
+            // the next triangle is one touching the cache
+            best = -1;
+            float bestScore = -1.0f;
+            for (u32 i = 0; i < std::min(nextLength, SCORE_CACHE); ++i) {
+                const u32 v = nextCache[i];
+                const u32* live = triOfVertex.Data() + firstTri[v];
+                for (u32 j = 0; j < liveTris[v]; ++j)
+                    if (triScore[live[j]] > bestScore) { bestScore = triScore[live[j]]; best = (i32)live[j]; }
+            }
+            cacheLength = std::min(nextLength, SCORE_CACHE);
+            std::memcpy(cache, nextCache, cacheLength * sizeof(u32));
+
+            // nothing left near the cache, carry on from the first triangle not drawn yet
+            if (best < 0) {
+                while (cursor < triCount && emitted[cursor]) ++cursor;
+                if (cursor < triCount) best = (i32)cursor;
+            }
+        }
+
+        // invalid triangles are kept, at the end
+        for (u32 t = 0; t < triCount; ++t)
+            if (!IsValid(triangles[t], vertexCount)) output.Push(triangles[t]);
+        std::memcpy(triangles.Data(), output.Data(), triCount * sizeof(TriIndices));
+    }
+
+    void OptimizeOverdraw(Span<TriIndices> triangles, const byte* positions, u32 vertexCount, usize stride, float threshold) {
+        constexpr u32 CACHE_SIZE = 16;
+        const u32 triCount = triangles.Length();
+        if (triCount == 0) return;
+
+        // cache misses per triangle, in the current order
+        Vec<u8> misses;
+        misses.Resize(triCount, 0);
+        {
+            Vec<u32> loadedAt;
+            loadedAt.Resize(vertexCount, 0);
+            u32 time = CACHE_SIZE + 1;
+            for (u32 t = 0; t < triCount; ++t) {
+                if (!IsValid(triangles[t], vertexCount)) continue;
+                for (u32 c = 0; c < 3; ++c) {
+                    const u32 v = VertexOf(triangles[t], c);
+                    if (time - loadedAt[v] > CACHE_SIZE) { loadedAt[v] = time++; ++misses[t]; }
+                }
+            }
+        }
+
+        // hard boundaries where all 3 vertices miss (the cache is cold there anyway), then softer ones
+        // where a cluster can end early without its acmr getting worse than threshold times the whole
+        Vec<u32> clusterStart;
+        for (u32 t = 0; t < triCount;) {
+            u32 end = t + 1;
+            while (end < triCount && misses[end] < 3) ++end;
+
+            u32 total = 0;
+            for (u32 i = t; i < end; ++i) total += misses[i];
+            const float limit = (float)total / (float)(end - t) * threshold;
+
+            clusterStart.Push(t);
+            u32 clusterMisses = 0, clusterTris = 0;
+            for (u32 i = t; i < end; ++i) {
+                if (threshold > 1.0f && clusterTris && misses[i] >= 2 && (float)clusterMisses / (float)clusterTris <= limit) {
+                    clusterStart.Push(i);
+                    clusterMisses = clusterTris = 0;
+                }
+                clusterMisses += misses[i];
+                ++clusterTris;
+            }
+            t = end;
+        }
+        const u32 clusterCount = clusterStart.Length();
+        clusterStart.Push(triCount);
+
+        // each cluster is sorted by how far out it faces, measured from the middle of the mesh
+        struct Cluster { Math::fVector3 center, normal; float area; u32 index; float key; };
+        Vec<Cluster> clusters = Vec<Cluster>::WithCap(clusterCount);
+        Math::fVector3 meshCenter = Math::fVector3::ZERO();
+        float meshArea = 0;
+        for (u32 c = 0; c < clusterCount; ++c) {
+            Cluster cl { Math::fVector3::ZERO(), Math::fVector3::ZERO(), 0, c, 0 };
+            for (u32 t = clusterStart[c]; t < clusterStart[c + 1]; ++t) {
+                if (!IsValid(triangles[t], vertexCount)) continue;
+                const Math::fVector3 a = ReadPosition(positions, stride, triangles[t].i),
+                                     b = ReadPosition(positions, stride, triangles[t].j),
+                                     d = ReadPosition(positions, stride, triangles[t].k);
+                const Math::fVector3 n = (b - a).cross(d - a);
+                const float area = n.len();
+                cl.center += (a + b + d) * (area / 3.0f);
+                cl.normal += n;
+                cl.area   += area;
+            }
+            meshCenter += cl.center;
+            meshArea   += cl.area;
+            if (cl.area > 0) cl.center /= cl.area;
+            clusters.Push(cl);
+        }
+        if (meshArea > 0) meshCenter /= meshArea;
+
+        for (Cluster& cl : clusters) {
+            const float nlen = cl.normal.len();
+            cl.key = nlen > 0 ? (cl.center - meshCenter).dot(cl.normal) / nlen : 0;
+        }
+        std::stable_sort(clusters.Data(), clusters.Data() + clusterCount,
+                         [] (const Cluster& a, const Cluster& b) { return a.key > b.key; });
+
+        Vec<TriIndices> output = Vec<TriIndices>::WithCap(triCount);
+        for (const Cluster& cl : clusters)
+            for (u32 t = clusterStart[cl.index]; t < clusterStart[cl.index + 1]; ++t)
+                output.Push(triangles[t]);
+        std::memcpy(triangles.Data(), output.Data(), triCount * sizeof(TriIndices));
+    }
+
+    Vec<u32> OptimizeVertexFetch(Span<TriIndices> triangles, u32 vertexCount) {
+        Vec<u32> remap;
+        remap.Resize(vertexCount, ~0u);
+        u32 next = 0;
+        for (TriIndices& t : triangles) {
+            if (!IsValid(t, vertexCount)) continue;
+            for (u32* v : { &t.i, &t.j, &t.k }) {
+                if (remap[*v] == ~0u) remap[*v] = next++;
+                *v = remap[*v];
+            }
+        }
+        for (u32& r : remap)
+            if (r == ~0u) r = next++;
+        return remap;
+    }
+
+    SimplifyResult Simplify(Span<TriIndices> triangles, const byte* positions, u32 vertexCount, usize stride,
+                            u32 targetTriangles, float targetError) {
+        // how much more a border resists being pulled off itself than a surface does
+        constexpr float BORDER_WEIGHT = 10.0f;
+        constexpr u32 PASS_FRACTION = 6;
+
+        Vec<TriIndices> tris = Vec<TriIndices>::WithCap(triangles.Length());
+        for (const TriIndices& t : triangles)
+            if (IsValid(t, vertexCount) && t.i != t.j && t.j != t.k && t.k != t.i) tris.Push(t);
+        if (tris.Length() <= targetTriangles) {
+            std::memcpy(triangles.Data(), tris.Data(), tris.Length() * sizeof(TriIndices));
+            return { (u32)tris.Length(), 0 };
+        }
+
+        // positions are scaled into a unit box, so the errors dont depend on how big the mesh is
+        Math::fRect3D box = Math::fRect3D::unrange();
+        for (const TriIndices& t : tris)
+            for (u32 c = 0; c < 3; ++c) box = box.expand_until(ReadPosition(positions, stride, VertexOf(t, c)));
+        const Math::fVector3 size = box.size();
+        const float extent = std::max({ size.x, size.y, size.z });
+        const float invExtent = extent > 0 ? 1.0f / extent : 0.0f;
+        Vec<Math::fVector3> pos = Vec<Math::fVector3>::WithCap(vertexCount);
+        for (u32 v = 0; v < vertexCount; ++v) pos.Push((ReadPosition(positions, stride, v) - box.min) * invExtent);
+
+        // vertices split on the same position (uv or normal seams) are locked, moving only one of them tears the seam
+        enum Kind : u8 { INTERIOR, BORDER, LOCKED };
+        Vec<u8> kind;
+        kind.Resize(vertexCount, INTERIOR);
+        {
+            Vec<u32> byPosition = Vec<u32>::WithCap(vertexCount);
+            for (u32 v = 0; v < vertexCount; ++v) byPosition.Push(v);
+            const auto compare = [&] (u32 a, u32 b) { return std::memcmp(&pos[a], &pos[b], sizeof(Math::fVector3)); };
+            std::sort(byPosition.Data(), byPosition.Data() + vertexCount, [&] (u32 a, u32 b) { return compare(a, b) < 0; });
+            for (u32 i = 1; i < vertexCount; ++i)
+                if (compare(byPosition[i - 1], byPosition[i]) == 0) kind[byPosition[i - 1]] = kind[byPosition[i]] = LOCKED;
+        }
+
+        // undirected edges, sorted, the ones used by a single triangle are borders
+        Vec<u64> edges = Vec<u64>::WithCap(tris.Length() * 3);
+        const auto buildEdges = [&] {
+            edges.Clear();
+            for (const TriIndices& t : tris)
+                for (u32 c = 0; c < 3; ++c) edges.Push(EdgeKey(VertexOf(t, c), VertexOf(t, (c + 1) % 3)));
+            std::sort(edges.Data(), edges.Data() + edges.Length());
+        };
+        const auto isBorder = [&] (u32 a, u32 b) {
+            const auto [lo, hi] = std::equal_range(edges.Data(), edges.Data() + edges.Length(), EdgeKey(a, b));
+            return hi - lo == 1;
+        };
+        buildEdges();
+
+        Vec<Quadric> quadrics;
+        quadrics.Resize(vertexCount);
+        for (const TriIndices& t : tris) {
+            const Math::fVector3& a = pos[t.i], &b = pos[t.j], &d = pos[t.k];
+            Math::fVector3 n = (b - a).cross(d - a);
+            const float area = n.len();
+            if (area <= 0) continue;
+            n /= area;
+            const Quadric q = Quadric::Plane(n, -n.dot(a), area * 0.5f);
+            quadrics[t.i] += q; quadrics[t.j] += q; quadrics[t.k] += q;
+
+            // borders also get a plane standing up along them, so they dont get pulled inwards
+            for (u32 c = 0; c < 3; ++c) {
+                const u32 u = VertexOf(t, c), v = VertexOf(t, (c + 1) % 3);
+                if (!isBorder(u, v)) continue;
+                const Math::fVector3 edge = pos[v] - pos[u];
+                Math::fVector3 side = edge.cross(n);
+                const float sideLen = side.len();
+                if (sideLen <= 0) continue;
+                side /= sideLen;
+                const Quadric border = Quadric::Plane(side, -side.dot(pos[u]), edge.lensq() * BORDER_WEIGHT);
+                quadrics[u] += border; quadrics[v] += border;
+                if (kind[u] == INTERIOR) kind[u] = BORDER;
+                if (kind[v] == INTERIOR) kind[v] = BORDER;
+            }
+        }
+
+        struct Collapse { u32 from, to; float error; };
+        Vec<Collapse> collapses;
+        Vec<u32> firstTri, triOfVertex, remap;
+        Vec<bool> touched;
+        const float errorLimit = targetError * targetError;
+        float worst = 0;
+
+        // each pass does the cheapest collapses that dont touch each other, then the triangles are redone
+        while (tris.Length() > targetTriangles) {
+            firstTri.Clear();
+            firstTri.Resize(vertexCount + 1, 0);
+            for (const TriIndices& t : tris) { ++firstTri[t.i + 1]; ++firstTri[t.j + 1]; ++firstTri[t.k + 1]; }
+            for (u32 v = 0; v < vertexCount; ++v) firstTri[v + 1] += firstTri[v];
+            triOfVertex.Resize(tris.Length() * 3, 0);
+            {
+                Vec<u32> filled = firstTri.Clone();
+                for (u32 t = 0; t < tris.Length(); ++t)
+                    for (u32 c = 0; c < 3; ++c) triOfVertex[filled[VertexOf(tris[t], c)]++] = t;
+            }
+
+            collapses.Clear();
+            for (const TriIndices& t : tris) {
+                for (u32 c = 0; c < 3; ++c) {
+                    const u32 a = VertexOf(t, c), b = VertexOf(t, (c + 1) % 3);
+                    for (const auto [from, to] : { std::pair { a, b }, std::pair { b, a } }) {
+                        if (kind[from] == LOCKED || (kind[from] == BORDER && !isBorder(from, to))) continue;
+                        collapses.Push({ from, to, quadrics[from].Error(pos[to]) });
+                    }
+                }
+            }
+            std::sort(collapses.Data(), collapses.Data() + collapses.Length(),
+                      [] (const Collapse& x, const Collapse& y) { return x.error < y.error; });
+
+            remap.Clear();
+            for (u32 v = 0; v < vertexCount; ++v) remap.Push(v);
+            touched.Clear();
+            touched.Resize(vertexCount, false);
+
+            // a pass only goes through the cheaper part of the list, otherwise the cheap collapses that
+            // were blocked by touched vertices lose to expensive ones that werent. the rest is only for
+            // when none of the cheap ones could be done
+            float passLimit = std::min(errorLimit, collapses.IsEmpty() ? 0 : collapses[collapses.Length() / PASS_FRACTION].error);
+            const u32 toRemove = tris.Length() - targetTriangles;
+            u32 removed = 0, done = 0;
+            for (const Collapse& col : collapses) {
+                if (col.error > passLimit) {
+                    if (done) break;
+                    passLimit = errorLimit;
+                }
+                if (col.error > passLimit || removed >= toRemove) break;
+                if (touched[col.from] || touched[col.to]) continue;
+
+                // the triangles left around from musnt turn over once it sits on to
+                bool flips = false;
+                for (u32 i = firstTri[col.from]; i < firstTri[col.from + 1] && !flips; ++i) {
+                    const TriIndices& t = tris[triOfVertex[i]];
+                    if (t.i == col.to || t.j == col.to || t.k == col.to) continue;
+                    const Math::fVector3 a = pos[t.i], b = pos[t.j], d = pos[t.k];
+                    const Math::fVector3 before = (b - a).cross(d - a);
+                    const Math::fVector3 na = t.i == col.from ? pos[col.to] : a,
+                                         nb = t.j == col.from ? pos[col.to] : b,
+                                         nd = t.k == col.from ? pos[col.to] : d;
+                    flips = before.dot((nb - na).cross(nd - na)) <= 0;
+                }
+                if (flips) continue;
+
+                // every vertex around from gets new triangles, so they wait for the next pass
+                for (u32 i = firstTri[col.from]; i < firstTri[col.from + 1]; ++i) {
+                    const TriIndices& t = tris[triOfVertex[i]];
+                    if (t.i == col.to || t.j == col.to || t.k == col.to) ++removed;
+                    touched[t.i] = touched[t.j] = touched[t.k] = true;
+                }
+                remap[col.from] = col.to;
+                quadrics[col.to] += quadrics[col.from];
+                worst = std::max(worst, col.error);
+                ++done;
+            }
+            if (!done) break;
+
+            u32 kept = 0;
+            for (const TriIndices& t : tris) {
+                const TriIndices r = { remap[t.i], remap[t.j], remap[t.k] };
+                if (r.i != r.j && r.j != r.k && r.k != r.i) tris[kept++] = r;
+            }
+            tris.Truncate(kept);
+            buildEdges();
+        }
+
+        std::memcpy(triangles.Data(), tris.Data(), tris.Length() * sizeof(TriIndices));
+        return { (u32)tris.Length(), std::sqrt(worst) };
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include "Mesh.h"
+
+namespace Quasi::Graphics::MeshOptimizer {
+    // how a fifo post transform cache of cacheSize vertices does on the triangles, in order.
+    // acmr is vertices shaded per triangle (0.5 is the best a big grid can do, 3 is no reuse),
+    // atvr is vertices shaded per vertex used (1 is the best)
+    struct CacheStats {
+        u32 triangles = 0, vertices = 0, transforms = 0;
+        float acmr = 0, atvr = 0;
+    };
+    CacheStats AnalyzeVertexCache(Span<const TriIndices> triangles, u32 vertexCount, u32 cacheSize = 16);
+
+    // reorders the triangles so the ones sharing vertices come close together (forsyth's linear speed
+    // vertex cache optimization). doesnt depend on the exact size of the hardware cache
+    void OptimizeVertexCache(Span<TriIndices> triangles, u32 vertexCount);
+
+    // reorders clusters of triangles that face outwards to be drawn first, so less is shaded twice.
+    // the triangles should already be cache optimized, clusters only split where the cache would miss
+    // anyway. threshold is how much worse the acmr may get for more, smaller clusters (1 to skip splitting).
+    // positions are 3 floats, read stride bytes apart
+    void OptimizeOverdraw(Span<TriIndices> triangles, const byte* positions, u32 vertexCount, usize stride, float threshold = 1.05f);
+
+    // renumbers the vertices in the order the triangles first use them, so fetching them moves forwards
+    // through memory. remap[old] is the new index, unused vertices go at the end
+    Vec<u32> OptimizeVertexFetch(Span<TriIndices> triangles, u32 vertexCount);
+
+    struct SimplifyResult {
+        u32 triangles = 0;
+        float error = 0; // relative to the size of the mesh, like targetError
+    };
+    // collapses edges into one of their vertices, cheapest first by the quadric error metric
+    // (garland & heckbert), until targetTriangles are left or the next one would move the surface by
+    // more than targetError (a fraction of the largest side of the mesh's box). no vertex is moved or
+    // made, so every attribute stays as it was. vertices sharing a position with another (uv or normal
+    // seams) never move, and borders only shrink along themselves. the remaining triangles are written
+    // to the front, invalid ones are dropped
+    SimplifyResult Simplify(Span<TriIndices> triangles, const byte* positions, u32 vertexCount, usize stride,
+                            u32 targetTriangles, float targetError = 1.0f);
+
+    struct Options {
+        bool reorderVertices = true;
+        bool reduceOverdraw = false; // 3d meshes only
+        float overdrawThreshold = 1.05f;
+        u32 analyzeCacheSize = 16;
+    };
+
+    struct Report {
+        CacheStats before, after;
+    };
+
+    // at load time or offline, the result is the same mesh with its triangles and vertices moved around
+    template <IVertex T>
+    Report Optimize(Mesh<T>& mesh, const Options& options = {}) {
+        Report report;
+        const u32 vertexCount = mesh.vertices.Length();
+        Span<TriIndices> triangles = mesh.indices.AsSpan();
+        report.before = AnalyzeVertexCache(triangles, vertexCount, options.analyzeCacheSize);
+
+        OptimizeVertexCache(triangles, vertexCount);
+        if constexpr (T::DIMENSION == 3) {
+            if (options.reduceOverdraw && vertexCount)
+                OptimizeOverdraw(triangles, Memory::TransmutePtr<const byte>(&mesh.vertices[0].Position),
+                                 vertexCount, sizeof(T), options.overdrawThreshold);
+        }
+        if (options.reorderVertices) {
+            const Vec<u32> remap = OptimizeVertexFetch(triangles, vertexCount);
+            Vec<T> reordered;
+            reordered.Resize(vertexCount);
+            for (u32 v = 0; v < vertexCount; ++v) reordered[remap[v]] = mesh.vertices[v];
+            mesh.vertices = std::move(reordered);
+        }
+
+        report.after = AnalyzeVertexCache(triangles, vertexCount, options.analyzeCacheSize);
+        return report;
+    }
+
+    // a new mesh with at most targetTriangles (unless that would go over targetError), holding only the
+    // vertices still used, cache optimized. the model transform is kept
+    template <IVertex T> requires (T::DIMENSION == 3)
+    Mesh<T> Simplified(const Mesh<T>& mesh, u32 targetTriangles, float targetError = 1.0f, OptRef<float> error = nullptr) {
+        Mesh<T> result;
+        result.modelTransform = mesh.modelTransform;
+        result.indices = mesh.indices.Clone();
+        const u32 vertexCount = mesh.vertices.Length();
+        const SimplifyResult simplified = vertexCount ?
+            Simplify(result.indices.AsSpan(), Memory::TransmutePtr<const byte>(&mesh.vertices[0].Position),
+                     vertexCount, sizeof(T), targetTriangles, targetError) : SimplifyResult {};
+        result.indices.Truncate(simplified.triangles);
+        if (error) *error = simplified.error;
+
+        OptimizeVertexCache(result.indices.AsSpan(), vertexCount);
+        const Vec<u32> remap = OptimizeVertexFetch(result.indices.AsSpan(), vertexCount);
+        u32 used = 0;
+        for (const TriIndices& t : result.indices) used = std::max({ used, t.i + 1, t.j + 1, t.k + 1 });
+        result.vertices.Resize(used);
+        for (u32 v = 0; v < vertexCount; ++v)
+            if (remap[v] < used) result.vertices[remap[v]] = mesh.vertices[v];
+        return result;
+    }
+}
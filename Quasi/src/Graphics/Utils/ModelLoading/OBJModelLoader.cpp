@@ -155,6 +155,7 @@ namespace Quasi::Graphics {
         }
 
         faces.Clear();
+        if (optimizeMeshes) MeshOptimizer::Optimize(obj.mesh, optimizeOptions);
     }
 
     OBJModel&& OBJModelLoader::RetrieveModel() {
@@ -2,6 +2,7 @@
 
 #include "MTLMaterialLoader.h"
 #include "OBJModel.h"
+#include "Meshes/MeshOptimizer.h"
 
 #include "Math/Vector.h"
 
@@ -42,6 +43,10 @@ namespace Quasi::Graphics {
 
         String folder, filename;
     public:
+        // the resolved meshes come out in file order, this reorders them for the vertex cache
+        bool optimizeMeshes = true;
+        MeshOptimizer::Options optimizeOptions;
+
         OBJModelLoader() = default;
 
         void LoadFile(CStr filepath);
@@ -5,6 +5,7 @@
 #include <glp.h>
 #include "Utils/Str.h"
 #include "Graphics/GLs/GLDebug.h"
+#include "Graphics/GLs/GLStateCache.h"
 #include "Graphics/Graphicals/GraphicsDevice.h"
 #include "stb_image/stb_image.h"
 #include "Utils/CStr.h"
@@ -40,14 +41,15 @@ namespace Quasi::Graphics {
 
     void Texture::DestroyObject(const GraphicsID id) {
         QGLCall$(GL::DeleteTextures(1, &id));
+        GLStateCache::ForgetTexture(id);
     }
 
     void Texture::BindObject(TextureTarget target, GraphicsID id) {
-        QGLCall$(GL::BindTexture((int)target, id));
+        GLStateCache::BindTexture((u32)target, id);
     }
 
     void Texture::UnbindObject(TextureTarget target) {
-        QGLCall$(GL::BindTexture((int)target, 0));
+        GLStateCache::BindTexture((u32)target, 0);
     }
 
     void Texture::SetParam(TextureParamName param, float val) const {
@@ -145,14 +147,14 @@ namespace Quasi::Graphics {
             slot = FindEmptySlot();
         if (slot == -1) return; // if slot is still -1, then the slots are full
 
-        QGLCall$(GL::ActiveTexture(GL::TEXTURE0 + slot));
+        GLStateCache::ActiveTexture(slot);
         Bind();
         Slots[slot] = *this;
         textureSlot.Replace(slot + 1);
     }
 
     void Texture::Deactivate() {
-        QGLCall$(GL::ActiveTexture(GL::TEXTURE0 + Slot()));
+        GLStateCache::ActiveTexture(Slot());
         Unbind();
         textureSlot.Close();
     }
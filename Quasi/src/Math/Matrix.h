@@ -17,6 +17,7 @@ namespace Quasi::Math {
         using vec  = VectorN<N - 1, float>;
         using rvec = VectorN<M - 1, float>;
         static constexpr bool is_square = N == M;
+        static constexpr u32 row_count = N, col_count = M;
 
         VectorN<M, col> mat { col::ZERO() };
 
@@ -104,4 +105,6 @@ namespace Quasi::Math {
 
     using Matrix2D = Matrix3x3;
     using Matrix3D = Matrix4x4;
+
+    template <class T> concept IMatrix = std::is_same_v<T, Matrix<T::row_count, T::col_count>>;
 }
\ No newline at end of file
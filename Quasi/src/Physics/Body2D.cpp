@@ -36,12 +36,12 @@ namespace Quasi::Physics2D {
         invMass = mass > 0 ? 1 / mass : 0;
     }
 
-    Manifold Body::CollideWith(const Body& target) const {
-        return CollideWith(target.shape, target.GetTransform());
+    Manifold Body::CollideWith(const Body& target, float margin) const {
+        return CollideWith(target.shape, target.GetTransform(), margin);
     }
 
-    Manifold Body::CollideWith(const Shape& target, const PhysicsTransform& xf) const {
-        return CollideShapes(shape, GetTransform(), target, xf);
+    Manifold Body::CollideWith(const Shape& target, const PhysicsTransform& xf, float margin) const {
+        return CollideShapes(shape, GetTransform(), target, xf, margin);
     }
 
     bool Body::OverlapsWith(const Body& target) const {
@@ -72,6 +72,10 @@ namespace Quasi::Physics2D {
         boundingBox = GetTransform().TransformRect(baseBoundingBox);
     }
 
+    void Body::SweepBoundingBox(float dt) {
+        boundingBox = boundingBox.expand(boundingBox.offseted(velocity * dt));
+    }
+
     void Body::SetShapeHasChanged() {
         shapeHasChanged = true;
     }
@@ -48,14 +48,15 @@ namespace Quasi::Physics2D {
 
         void Stop() { velocity = 0; angularVelocity = 0; }
 
-        Manifold CollideWith(const Body& target) const;
-        Manifold CollideWith(const Shape& target, const PhysicsTransform& xf) const;
+        Manifold CollideWith(const Body& target, float margin = 0.0f) const;
+        Manifold CollideWith(const Shape& target, const PhysicsTransform& xf, float margin = 0.0f) const;
         bool OverlapsWith(const Body& target) const;
         bool OverlapsWith(const Shape& target, const PhysicsTransform& xf) const;
         PhysicsTransform GetTransform() const;
 
         void Update(float dt);
         void TryUpdateTransforms();
+        void SweepBoundingBox(float dt); // grows the box to cover the motion over the next dt
         void SetShapeHasChanged();
 
         bool IsStatic()  const { return type == BodyType::STATIC; }
@@ -68,7 +69,7 @@ namespace Quasi::Physics2D {
 
         friend class World;
         friend void StaticResolve (Body&, Body&, const Manifold&);
-        friend void DynamicResolve(Body&, Body&, const Manifold&);
+        friend void DynamicResolve(Body&, Body&, const Manifold&, float);
     };
 
     struct BodyHandle : INullable<Body&, BodyHandle>, IReference<Body, BodyHandle> {
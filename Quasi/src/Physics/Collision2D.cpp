@@ -62,41 +62,55 @@ namespace Quasi::Physics2D {
         return c1->distsq(*c2);
     }
 
-    Manifold CollideShapes(const Shape& s1, const PhysicsTransform& xf1, const Shape& s2, const PhysicsTransform& xf2) {
+    Manifold CollideShapes(const Shape& s1, const PhysicsTransform& xf1, const Shape& s2, const PhysicsTransform& xf2, float margin) {
         const Shape::ClipPrimitive prim1 = s1.PreferedPrimitive(),
                                    prim2 = s2.PreferedPrimitive();
 
 #define SHAPE_PRIM_PAIR(X, Y) case Shape::PRIM_##X * 3 + Shape::PRIM_##Y
         switch (prim1 * 3 + prim2) {
             SHAPE_PRIM_PAIR(CIRCLE, CIRCLE):
-                return CollideCircles(s1.As<CircleShape>(), xf1, s2.As<CircleShape>(), xf2);
+                return CollideCircles(s1.As<CircleShape>(), xf1, s2.As<CircleShape>(), xf2, margin);
 
-            SHAPE_PRIM_PAIR(CIRCLE, LINE):  SHAPE_PRIM_PAIR(CIRCLE, POLYGON):
-                return CollideCircleShape(s1, xf1, s2, xf2);
+            SHAPE_PRIM_PAIR(CIRCLE, LINE):
+                return CollideCircleCapsule(*s1.As<CircleShape>(), xf1, *s2.As<CapsuleShape>(), xf2, margin);
 
-            SHAPE_PRIM_PAIR(LINE, CIRCLE): SHAPE_PRIM_PAIR(POLYGON, CIRCLE):
-                return Manifold::Flip(CollideCircleShape(s2, xf2, s1, xf1));
+            SHAPE_PRIM_PAIR(LINE, CIRCLE):
+                return Manifold::Flip(CollideCircleCapsule(*s2.As<CircleShape>(), xf2, *s1.As<CapsuleShape>(), xf1, margin));
+
+            SHAPE_PRIM_PAIR(CIRCLE, POLYGON):
+                if (s2.Is<RectShape>())
+                    return CollideCircleRect(*s1.As<CircleShape>(), xf1, *s2.As<RectShape>(), xf2, margin);
+                return CollideCircleShape(s1, xf1, s2, xf2, margin);
+
+            SHAPE_PRIM_PAIR(POLYGON, CIRCLE):
+                if (s1.Is<RectShape>())
+                    return Manifold::Flip(CollideCircleRect(*s2.As<CircleShape>(), xf2, *s1.As<RectShape>(), xf1, margin));
+                return Manifold::Flip(CollideCircleShape(s2, xf2, s1, xf1, margin));
 
             SHAPE_PRIM_PAIR(LINE, LINE):
-                return CollideCapsules(s1, xf1, s2, xf2);
+                return CollideCapsules(s1, xf1, s2, xf2, margin);
 
             SHAPE_PRIM_PAIR(POLYGON, LINE):
-                return CollidePolygonCapsule(s1, xf1, s2, xf2);
+                if (s1.Is<RectShape>())
+                    return CollideRectCapsule(*s1.As<RectShape>(), xf1, *s2.As<CapsuleShape>(), xf2, margin);
+                return CollidePolygonCapsule(s1, xf1, s2, xf2, margin);
 
             SHAPE_PRIM_PAIR(LINE, POLYGON):
-                return Manifold::Flip(CollidePolygonCapsule(s2, xf2, s1, xf1));
+                if (s2.Is<RectShape>())
+                    return Manifold::Flip(CollideRectCapsule(*s2.As<RectShape>(), xf2, *s1.As<CapsuleShape>(), xf1, margin));
+                return Manifold::Flip(CollidePolygonCapsule(s2, xf2, s1, xf1, margin));
 
             SHAPE_PRIM_PAIR(POLYGON, POLYGON):
-                return CollidePolygons(s1, xf1, s2, xf2);
+                return CollidePolygons(s1, xf1, s2, xf2, margin);
 
             default:
                 return Manifold::None();
         }
     }
 
-    Manifold CollideCircles(const CircleShape& s1, const PhysicsTransform& xf1, const CircleShape& s2, const PhysicsTransform& xf2) {
+    Manifold CollideCircles(const CircleShape& s1, const PhysicsTransform& xf1, const CircleShape& s2, const PhysicsTransform& xf2, float margin) {
         float distsq = xf1.position.distsq(xf2.position);
-        if (distsq >= (s1.radius + s2.radius) * (s1.radius + s2.radius))
+        if (distsq >= (s1.radius + s2.radius + margin) * (s1.radius + s2.radius + margin))
             return Manifold::None();
 
         distsq = std::sqrt(distsq);
@@ -109,8 +123,8 @@ namespace Quasi::Physics2D {
         };
     }
 
-    Manifold CollideCircleShape(const Shape& s1, const PhysicsTransform& xf1, const Shape& s2, const PhysicsTransform& xf2) {
-        SeperatingAxisSolver sat = SeperatingAxisSolver::CheckCollisionFor(s1, xf1, s2, xf2);
+    Manifold CollideCircleShape(const Shape& s1, const PhysicsTransform& xf1, const Shape& s2, const PhysicsTransform& xf2, float margin) {
+        SeperatingAxisSolver sat = SeperatingAxisSolver::CheckCollisionFor(s1, xf1, s2, xf2, margin);
         const auto& circle = *s1.As<CircleShape>();
 
         sat.SetCheckFor(SeperatingAxisSolver::NEITHER);
@@ -129,8 +143,8 @@ namespace Quasi::Physics2D {
         };
     }
 
-    Manifold CollidePolygons(const Shape& s1, const PhysicsTransform& xf1, const Shape& s2, const PhysicsTransform& xf2) {
-        SeperatingAxisSolver sat = SeperatingAxisSolver::CheckCollisionFor(s1, xf1, s2, xf2);
+    Manifold CollidePolygons(const Shape& s1, const PhysicsTransform& xf1, const Shape& s2, const PhysicsTransform& xf2, float margin) {
+        SeperatingAxisSolver sat = SeperatingAxisSolver::CheckCollisionFor(s1, xf1, s2, xf2, margin);
         sat.CheckAxisFor(SeperatingAxisSolver::BASE);
         sat.CheckAxisFor(SeperatingAxisSolver::TARGET);
 
@@ -140,7 +154,7 @@ namespace Quasi::Physics2D {
         return Manifold::From(sat);
     }
 
-    Manifold CollideCapsules(const Shape& s1, const PhysicsTransform& xf1, const Shape& s2, const PhysicsTransform& xf2) {
+    Manifold CollideCapsules(const Shape& s1, const PhysicsTransform& xf1, const Shape& s2, const PhysicsTransform& xf2, float margin) {
         const CapsuleShape& cap1 = s1.As<CapsuleShape>(),
                           & cap2 = s2.As<CapsuleShape>();
 
@@ -289,7 +303,79 @@ namespace Quasi::Physics2D {
 	 //    }
   //   	return manifold;
 
-        SeperatingAxisSolver sat = SeperatingAxisSolver::CheckCollisionFor(s1, xf1, s2, xf2);
+        const fVector2 f1 = xf1.TransformDir(cap1.forward),
+                       f2 = xf2.TransformDir(cap2.forward);
+        const fVector2 a1 = xf1.position - f1;
+
+        float s, t;
+        fVector2 c1, c2;
+        const float distsq = ClosestBetweenSegments(a1, xf1.position + f1, xf2.position - f2, xf2.position + f2, &s, &t, &c1, &c2);
+        const float totalRadius = cap1.radius + cap2.radius;
+        if (distsq >= (totalRadius + margin) * (totalRadius + margin))
+            return Manifold::None();
+
+        const float dist = std::sqrt(distsq);
+        fVector2 n = f1.perpend() * cap1.invLength;
+        if (dist > EPSILON) n = (c2 - c1) / dist;
+        else if (n.dot(xf2.position - xf1.position) < 0) n = -n;
+
+        // nearly parallel capsules get both ends of the overlap as contacts, otherwise they rock on a single point
+        if (std::abs(f1.zcross(f2)) * cap1.invLength * cap2.invLength < 0.05f) {
+            const fVector2 u = f1 * cap1.invLength;
+            fVector2 side = u.perpend();
+            if (side.dot(n) < 0) side = -side;
+
+            fVector2 e0 = xf2.position - f2, e1 = xf2.position + f2;
+            float p0 = (e0 - a1).dot(u), p1 = (e1 - a1).dot(u);
+            if (p0 > p1) { std::swap(e0, e1); std::swap(p0, p1); }
+            const float span = 2 * cap1.length;
+            if (p1 - p0 > EPSILON && p0 < span && p1 > 0) {
+                const fVector2 lo = p0 < 0    ? e0 + (e1 - e0) * ((0    - p0) / (p1 - p0)) : e0,
+                               hi = p1 > span ? e0 + (e1 - e0) * ((span - p0) / (p1 - p0)) : e1;
+                Manifold manifold = Manifold::None();
+                manifold.seperatingNormal = side;
+                for (const fVector2& p : { lo, hi }) {
+                    if (const float depth = totalRadius - (p - a1).dot(side); depth > -margin)
+                        manifold.AddPoint(p - side * cap2.radius, depth);
+                }
+                if (manifold.contactCount) return manifold;
+            }
+        }
+
+        return Manifold {
+            .seperatingNormal = n,
+            .contactPoint = { c1 + n * cap1.radius },
+            .contactDepth = { totalRadius - dist },
+            .contactCount = 1,
+        };
+    }
+
+    Manifold CollidePolygonCapsule(const Shape& s1, const PhysicsTransform& xf1, const Shape& s2, const PhysicsTransform& xf2, float margin) {
+        SeperatingAxisSolver sat = SeperatingAxisSolver::CheckCollisionFor(s1, xf1, s2, xf2, margin);
+        sat.CheckAxisFor(SeperatingAxisSolver::BASE);
+        sat.CheckAxisFor(SeperatingAxisSolver::TARGET);
+
+        const auto& cap = *s2.As<CapsuleShape>();
+        sat.SetCheckFor(SeperatingAxisSolver::NEITHER);
+        const fVector2 tip = xf2.Transform(cap.forward), end = 2 * xf2.position - tip;
+        sat.CheckAxis((xf1.Transform(s1.NearestPointTo(xf1.TransformInverse(tip))) - tip).norm());
+        sat.CheckAxis((xf1.Transform(s1.NearestPointTo(xf1.TransformInverse(end))) - end).norm());
+
+        if (!sat.Collides())
+            return Manifold::None();
+
+        return Manifold {
+            .seperatingNormal = sat.GetSepAxis(),
+            .contactPoint = { xf2.Transform(cap.FurthestAlong(xf2.TransformInverseDir(-sat.GetSepAxis()))) },
+            .contactDepth = { sat.GetDepth() },
+            .contactCount = 1,
+        };
+    }
+
+    Manifold CollideCapsulesSolver(const Shape& s1, const PhysicsTransform& xf1, const Shape& s2, const PhysicsTransform& xf2, float margin) {
+        const CapsuleShape& cap1 = s1.As<CapsuleShape>(),
+                          & cap2 = s2.As<CapsuleShape>();
+        SeperatingAxisSolver sat = SeperatingAxisSolver::CheckCollisionFor(s1, xf1, s2, xf2, margin);
 
         const fVector2 f1 = xf1.TransformDir(cap1.forward),
                        f2 = xf2.TransformDir(cap2.forward);
@@ -326,24 +412,129 @@ namespace Quasi::Physics2D {
         };
     }
 
-    Manifold CollidePolygonCapsule(const Shape& s1, const PhysicsTransform& xf1, const Shape& s2, const PhysicsTransform& xf2) {
-        SeperatingAxisSolver sat = SeperatingAxisSolver::CheckCollisionFor(s1, xf1, s2, xf2);
-        sat.CheckAxisFor(SeperatingAxisSolver::BASE);
-        sat.CheckAxisFor(SeperatingAxisSolver::TARGET);
+    Manifold CollideCircleCapsule(const CircleShape& s1, const PhysicsTransform& xf1, const CapsuleShape& s2, const PhysicsTransform& xf2, float margin) {
+        const fVector2 f = xf2.TransformDir(s2.forward);
+        const float t = std::clamp((xf1.position - xf2.position).dot(f) * s2.invLenSq, -1.0f, 1.0f);
+        const fVector2 d = xf2.position + f * t - xf1.position;
 
-        const auto& cap = *s2.As<CapsuleShape>();
-        sat.SetCheckFor(SeperatingAxisSolver::NEITHER);
-        const fVector2 tip = xf2.Transform(cap.forward), end = 2 * xf2.position - tip;
-        sat.CheckAxis((xf1.Transform(s1.NearestPointTo(xf1.TransformInverse(tip))) - tip).norm());
-        sat.CheckAxis((xf1.Transform(s1.NearestPointTo(xf1.TransformInverse(end))) - end).norm());
-
-        if (!sat.Collides())
+        const float totalRadius = s1.radius + s2.radius, distsq = d.lensq();
+        if (distsq >= (totalRadius + margin) * (totalRadius + margin))
             return Manifold::None();
 
+        const float dist = std::sqrt(distsq);
+        // circle centered on the segment, any side works
+        const fVector2 n = dist > EPSILON ? d / dist : f.perpend() * s2.invLength;
         return Manifold {
-            .seperatingNormal = sat.GetSepAxis(),
-            .contactPoint = { xf2.Transform(cap.FurthestAlong(xf2.TransformInverseDir(-sat.GetSepAxis()))) },
-            .contactDepth = { sat.GetDepth() },
+            .seperatingNormal = n,
+            .contactPoint = { xf1.position + n * s1.radius },
+            .contactDepth = { totalRadius - dist },
+            .contactCount = 1,
+        };
+    }
+
+    Manifold CollideCircleRect(const CircleShape& s1, const PhysicsTransform& xf1, const RectShape& s2, const PhysicsTransform& xf2, float margin) {
+        const fVector2 p = xf2.TransformInverse(xf1.position),
+                       q = { std::clamp(p.x, -s2.hx, s2.hx), std::clamp(p.y, -s2.hy, s2.hy) };
+        const float r = s1.radius;
+
+        if (p.x != q.x || p.y != q.y) {
+            const fVector2 d = q - p;
+            const float distsq = d.lensq();
+            if (distsq >= (r + margin) * (r + margin))
+                return Manifold::None();
+
+            const float dist = std::sqrt(distsq);
+            const fVector2 n = xf2.TransformDir(d / dist);
+            return Manifold {
+                .seperatingNormal = n,
+                .contactPoint = { xf1.position + n * r },
+                .contactDepth = { r - dist },
+                .contactCount = 1,
+            };
+        }
+
+        // center is inside, leave through the closest face
+        const float dx = s2.hx - std::abs(p.x), dy = s2.hy - std::abs(p.y);
+        const fVector2 outward = dx < dy ? fVector2 { p.x < 0 ? -1.0f : 1.0f, 0 } : fVector2 { 0, p.y < 0 ? -1.0f : 1.0f };
+        const fVector2 n = xf2.TransformDir(-outward);
+        return Manifold {
+            .seperatingNormal = n,
+            .contactPoint = { xf1.position + n * r },
+            .contactDepth = { r + std::min(dx, dy) },
+            .contactCount = 1,
+        };
+    }
+
+    Manifold CollideRectCapsule(const RectShape& s1, const PhysicsTransform& xf1, const CapsuleShape& s2, const PhysicsTransform& xf2, float margin) {
+        // everything in rect local space
+        const fVector2 c = xf1.TransformInverse(xf2.position),
+                       f = xf1.TransformInverseDir(xf2.TransformDir(s2.forward)),
+                       a = c - f, b = c + f;
+        const float hx = s1.hx, hy = s1.hy, r = s2.radius;
+
+        // closest features: both endpoints against the box, then the segment against all 4 edges
+        fVector2 onRect, onSegment;
+        float bestsq = INFINITY;
+        const auto consider = [&] (const fVector2& pr, const fVector2& ps) {
+            if (const float dsq = pr.distsq(ps); dsq < bestsq) { bestsq = dsq; onRect = pr; onSegment = ps; }
+        };
+        for (const fVector2& e : { a, b })
+            consider({ std::clamp(e.x, -hx, hx), std::clamp(e.y, -hy, hy) }, e);
+        const fVector2 corners[4] = { { -hx, -hy }, { hx, -hy }, { hx, hy }, { -hx, hy } };
+        for (u32 i = 0; i < 4; ++i) {
+            float s, t;
+            fVector2 pr, ps;
+            ClosestBetweenSegments(corners[i], corners[(i + 1) % 4], a, b, &s, &t, &pr, &ps);
+            consider(pr, ps);
+        }
+
+        fVector2 n; // rect -> capsule
+        float depth;
+        if (bestsq > EPSILON) {
+            if (bestsq >= (r + margin) * (r + margin))
+                return Manifold::None();
+            const float dist = std::sqrt(bestsq);
+            n = (onSegment - onRect) / dist;
+            depth = r - dist;
+        } else {
+            // the core segment itself is inside, only the 2 faces and the segment normal can seperate
+            const fVector2 axes[3] = { { 1, 0 }, { 0, 1 }, f.perpend() * s2.invLength };
+            depth = INFINITY;
+            for (const fVector2& u : axes) {
+                const float boxR = hx * std::abs(u.x) + hy * std::abs(u.y);
+                const float pa = a.dot(u), pb = b.dot(u);
+                const float pushPos = boxR - (std::min(pa, pb) - r), pushNeg = std::max(pa, pb) + r + boxR;
+                if (pushPos < depth) { depth = pushPos; n =  u; }
+                if (pushNeg < depth) { depth = pushNeg; n = -u; }
+            }
+            onSegment = f.dot(n) > 0 ? a : b; // deepest end towards the rect
+        }
+
+        // resting on a face with the capsule lying flat: clip the segment against the face for 2 points
+        const bool xFace = std::abs(n.x) > std::abs(n.y);
+        const fVector2 u = xFace ? fVector2 { n.x < 0 ? -1.0f : 1.0f, 0 } : fVector2 { 0, n.y < 0 ? -1.0f : 1.0f };
+        if (n.dot(u) > 0.98f && std::abs(f.dot(u)) * s2.invLength < 0.05f) {
+            const float face = xFace ? hx : hy, extent = xFace ? hy : hx;
+            fVector2 e0 = a, e1 = b;
+            float t0 = xFace ? a.y : a.x, t1 = xFace ? b.y : b.x;
+            if (t0 > t1) { std::swap(e0, e1); std::swap(t0, t1); }
+            if (t1 - t0 > EPSILON && t0 < extent && t1 > -extent) {
+                const fVector2 lo = t0 < -extent ? e0 + (e1 - e0) * ((-extent - t0) / (t1 - t0)) : e0,
+                               hi = t1 >  extent ? e0 + (e1 - e0) * (( extent - t0) / (t1 - t0)) : e1;
+                Manifold manifold = Manifold::None();
+                manifold.seperatingNormal = xf1.TransformDir(u);
+                for (const fVector2& p : { lo, hi }) {
+                    if (const float d = face + r - p.dot(u); d > -margin)
+                        manifold.AddPoint(xf1.Transform(p - u * r), d);
+                }
+                if (manifold.contactCount) return manifold;
+            }
+        }
+
+        return Manifold {
+            .seperatingNormal = xf1.TransformDir(n),
+            .contactPoint = { xf1.Transform(onSegment - n * r) },
+            .contactDepth = { depth },
             .contactCount = 1,
         };
     }
@@ -431,6 +622,7 @@ namespace Quasi::Physics2D {
         switch (manifold.contactCount) {
             case 0: return;
             case 1: {
+                if (manifold.contactDepth[0] <= 0) return; // speculative, nothing to push out
                 sep *= shareForce ? 0.5f * manifold.contactDepth[0] : manifold.contactDepth[0];
                 if (bodyDyn)
                     body.position -= sep;
@@ -440,6 +632,7 @@ namespace Quasi::Physics2D {
             }
             case 2: {
                 const float depth = std::max(manifold.contactDepth[0], manifold.contactDepth[1]);
+                if (depth <= 0) return;
                 sep *= shareForce ? 0.5f * depth : depth;
                 if (bodyDyn)
                     body.position -= sep;
@@ -450,7 +643,7 @@ namespace Quasi::Physics2D {
         }
     }
 
-    void DynamicResolve(Body& body, Body& target, const Manifold& manifold) {
+    void DynamicResolve(Body& body, Body& target, const Manifold& manifold, float invDt) {
         constexpr auto TAG = [] (const u32 ccount, bool bdyn, bool tdyn) constexpr -> u32 {
             return ccount << 2 |
                    bdyn << 1 |
@@ -458,18 +651,18 @@ namespace Quasi::Physics2D {
         };
 
         switch (TAG(manifold.contactCount, body.IsDynamic(), target.IsDynamic())) {
-            case TAG(1, true,  true ): DynamicResolveFor<1, true,  true >(body, target, manifold); break;
-            case TAG(1, true,  false): DynamicResolveFor<1, true,  false>(body, target, manifold); break;
-            case TAG(1, false, true ): DynamicResolveFor<1, false, true >(body, target, manifold); break;
-            case TAG(2, true,  true ): DynamicResolveFor<2, true,  true >(body, target, manifold); break;
-            case TAG(2, true,  false): DynamicResolveFor<2, true,  false>(body, target, manifold); break;
-            case TAG(2, false, true ): DynamicResolveFor<2, false, true >(body, target, manifold); break;
+            case TAG(1, true,  true ): DynamicResolveFor<1, true,  true >(body, target, manifold, invDt); break;
+            case TAG(1, true,  false): DynamicResolveFor<1, true,  false>(body, target, manifold, invDt); break;
+            case TAG(1, false, true ): DynamicResolveFor<1, false, true >(body, target, manifold, invDt); break;
+            case TAG(2, true,  true ): DynamicResolveFor<2, true,  true >(body, target, manifold, invDt); break;
+            case TAG(2, true,  false): DynamicResolveFor<2, true,  false>(body, target, manifold, invDt); break;
+            case TAG(2, false, true ): DynamicResolveFor<2, false, true >(body, target, manifold, invDt); break;
             default: Debug::Error("bad collision response");
         }
     }
 
     template <u32 ContactCount, bool BDyn, bool TDyn>
-    void DynamicResolveFor(Body& body, Body& target, const Manifold& manifold) {
+    void DynamicResolveFor(Body& body, Body& target, const Manifold& manifold, float invDt) {
         const fVector2& normal = manifold.seperatingNormal, tangent = normal.perpend();
         const float share = ContactCount == 2 ? 0.5f : 1.0f;
         // this makes contactCount known in compile time for loop unrolling
@@ -656,7 +849,10 @@ namespace Quasi::Physics2D {
                 }
             } ();
 
-            velocityMag[i] = relVel.dot(normal);
+            // a speculative contact may still close its gap this step, and never bounces
+            const float gap = std::max(-manifold.contactDepth[i], 0.0f);
+            velocityMag[i] = relVel.dot(normal) + gap * invDt;
+            jn[i] = 0.0f;
             if (velocityMag[i] > 0.0f) continue;
 
             const float denomN = [&] {
@@ -676,7 +872,8 @@ namespace Quasi::Physics2D {
                 }
             } ();
 
-            jn[i] = -(1.0f + BODY_RESTITUION) * velocityMag[i] * share / denomN;
+            const float restitution = gap > 0.0f ? 0.0f : BODY_RESTITUION;
+            jn[i] = -(1.0f + restitution) * velocityMag[i] * share / denomN;
 
             const fVector2 impulse = jn[i] * normal;
 
@@ -754,10 +951,10 @@ namespace Quasi::Physics2D {
         }
     }
 
-    template void DynamicResolveFor<1, true,  true >(Body& body, Body& target, const Manifold& manifold);
-    template void DynamicResolveFor<1, true,  false>(Body& body, Body& target, const Manifold& manifold);
-    template void DynamicResolveFor<1, false, true >(Body& body, Body& target, const Manifold& manifold);
-    template void DynamicResolveFor<2, true,  true >(Body& body, Body& target, const Manifold& manifold);
-    template void DynamicResolveFor<2, true,  false>(Body& body, Body& target, const Manifold& manifold);
-    template void DynamicResolveFor<2, false, true >(Body& body, Body& target, const Manifold& manifold);
+    template void DynamicResolveFor<1, true,  true >(Body& body, Body& target, const Manifold& manifold, float invDt);
+    template void DynamicResolveFor<1, true,  false>(Body& body, Body& target, const Manifold& manifold, float invDt);
+    template void DynamicResolveFor<1, false, true >(Body& body, Body& target, const Manifold& manifold, float invDt);
+    template void DynamicResolveFor<2, true,  true >(Body& body, Body& target, const Manifold& manifold, float invDt);
+    template void DynamicResolveFor<2, true,  false>(Body& body, Body& target, const Manifold& manifold, float invDt);
+    template void DynamicResolveFor<2, false, true >(Body& body, Body& target, const Manifold& manifold, float invDt);
 } // Physics2D
\ No newline at end of file
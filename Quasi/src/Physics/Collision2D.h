@@ -5,6 +5,7 @@ namespace Quasi::Physics2D {
     class Shape;
     class CircleShape;
     class CapsuleShape;
+    class RectShape;
     class Body;
 }
 
@@ -12,13 +13,20 @@ namespace Quasi::Physics2D {
     float ClosestBetweenSegments(const fVector2& a1, const fVector2& b1, const fVector2& a2, const fVector2& b2,
                                  float* s, float* t, fVector2* c1, fVector2* c2);
 
-    Manifold CollideShapes(const Shape& s1, const PhysicsTransform& xf1, const Shape& s2, const PhysicsTransform& xf2);
+    // margin > 0 also reports shapes seperated by less than margin, as speculative contacts with negative depth
+    Manifold CollideShapes(const Shape& s1, const PhysicsTransform& xf1, const Shape& s2, const PhysicsTransform& xf2, float margin = 0.0f);
 
-    Manifold CollideCircles       (const CircleShape& s1, const PhysicsTransform& xf1, const CircleShape& s2, const PhysicsTransform& xf2);
-    Manifold CollideCircleShape   (const Shape& s1,       const PhysicsTransform& xf1, const Shape& s2,       const PhysicsTransform& xf2);
-    Manifold CollidePolygons      (const Shape& s1,       const PhysicsTransform& xf1, const Shape& s2,       const PhysicsTransform& xf2);
-    Manifold CollideCapsules      (const Shape& s1,       const PhysicsTransform& xf1, const Shape& s2,       const PhysicsTransform& xf2);
-    Manifold CollidePolygonCapsule(const Shape& s1,       const PhysicsTransform& xf1, const Shape& s2,       const PhysicsTransform& xf2);
+    Manifold CollideCircles       (const CircleShape& s1, const PhysicsTransform& xf1, const CircleShape& s2, const PhysicsTransform& xf2, float margin = 0.0f);
+    Manifold CollideCircleShape   (const Shape& s1,       const PhysicsTransform& xf1, const Shape& s2,       const PhysicsTransform& xf2, float margin = 0.0f);
+    Manifold CollidePolygons      (const Shape& s1,       const PhysicsTransform& xf1, const Shape& s2,       const PhysicsTransform& xf2, float margin = 0.0f);
+    Manifold CollideCapsules      (const Shape& s1,       const PhysicsTransform& xf1, const Shape& s2,       const PhysicsTransform& xf2, float margin = 0.0f);
+    Manifold CollidePolygonCapsule(const Shape& s1,       const PhysicsTransform& xf1, const Shape& s2,       const PhysicsTransform& xf2, float margin = 0.0f);
+    // closed form, without going through the seperating axis solver
+    Manifold CollideCircleCapsule (const CircleShape& s1, const PhysicsTransform& xf1, const CapsuleShape& s2, const PhysicsTransform& xf2, float margin = 0.0f);
+    Manifold CollideCircleRect    (const CircleShape& s1, const PhysicsTransform& xf1, const RectShape& s2,    const PhysicsTransform& xf2, float margin = 0.0f);
+    Manifold CollideRectCapsule   (const RectShape& s1,   const PhysicsTransform& xf1, const CapsuleShape& s2, const PhysicsTransform& xf2, float margin = 0.0f);
+    // the seperating axis version CollideCapsules replaced, one contact point only. kept to compare against
+    Manifold CollideCapsulesSolver(const Shape& s1,       const PhysicsTransform& xf1, const Shape& s2,       const PhysicsTransform& xf2, float margin = 0.0f);
 
     bool OverlapShapes(const Shape& s1, const PhysicsTransform& xf1, const Shape& s2, const PhysicsTransform& xf2);
 
@@ -29,7 +37,8 @@ namespace Quasi::Physics2D {
     bool OverlapPolygonCapsule(const Shape& s1,       const PhysicsTransform& xf1, const Shape& s2,       const PhysicsTransform& xf2);
 
     void StaticResolve (Body& body, Body& target, const Manifold& manifold);
+    // invDt lets speculative contacts (negative depth) close their gap within the step instead of bouncing
     template <u32 ContactCount, bool BDyn, bool TDyn>
-    void DynamicResolveFor(Body& body, Body& target, const Manifold& manifold);
-    void DynamicResolve(Body& body, Body& target, const Manifold& manifold);
+    void DynamicResolveFor(Body& body, Body& target, const Manifold& manifold, float invDt);
+    void DynamicResolve(Body& body, Body& target, const Manifold& manifold, float invDt = 0.0f);
 } // Physics2D::Collision
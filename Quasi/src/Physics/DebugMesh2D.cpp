@@ -0,0 +1,223 @@
+#include "DebugMesh2D.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define QUASI_DEBUGMESH_SSE 1
+#include <xmmintrin.h>
+#else
+#define QUASI_DEBUGMESH_SSE 0
+#endif
+
+#include "VertexBlueprint.h"
+#include "Meshes/Circle.h"
+#include "Meshes/Stadium.h"
+
+namespace Quasi::Physics2D {
+    u32 DebugMeshBuilder::Track(BodyHandle body, const Math::fColor& color) {
+        Entry& e = entries.Push({ .body = body, .color = color });
+        // a pending rebuild lays out everything again anyways
+        if (!needsRebuild) AppendLocalGeometry(e);
+        return (u32)entries.Length() - 1;
+    }
+
+    void DebugMeshBuilder::Untrack(u32 i) {
+        entries.Pop(i);
+        needsRebuild = true;
+    }
+
+    void DebugMeshBuilder::Clear() {
+        entries.Clear();
+        localPositions.Clear();
+        mesh.Clear();
+        needsRebuild = anyShapeChanged = false;
+    }
+
+    void DebugMeshBuilder::SetColor(u32 i, const Math::fColor& color) {
+        Entry& e = entries[i];
+        if (e.color == color) return;
+        e.color = color;
+        // the rotation marker at the end keeps its own color
+        for (u32 v = e.vertexStart; v < e.markerStart; ++v)
+            mesh.vertices[v].Color = color;
+    }
+
+    void DebugMeshBuilder::MarkAllDirty() {
+        for (Entry& e : entries) e.needsWrite = true;
+    }
+
+    u32 DebugMeshBuilder::Update() {
+        if (anyShapeChanged && !needsRebuild) {
+            for (Entry& e : entries) {
+                if (!e.shapeChanged) continue;
+                Retriangulate(e);
+                if (needsRebuild) break;
+            }
+        }
+        anyShapeChanged = false;
+        if (needsRebuild) Rebuild();
+
+        u32 written = 0;
+        for (Entry& e : entries) {
+            if (!e.body) continue;
+            const Body& body = *e.body;
+            if (!body.enabled && !e.needsWrite) continue;
+
+            const PhysicsTransform xf = body.GetTransform();
+            if (!e.needsWrite && xf.position == e.lastTransform.position && xf.rotation == e.lastTransform.rotation)
+                continue;
+
+            WriteTransformed(e, xf);
+            e.lastTransform = xf;
+            e.needsWrite = false;
+            ++written;
+        }
+        return written;
+    }
+
+    void DebugMeshBuilder::Rebuild() {
+        mesh.Clear();
+        localPositions.Clear();
+        for (Entry& e : entries) AppendLocalGeometry(e);
+        needsRebuild = false;
+    }
+
+    void DebugMeshBuilder::Retriangulate(Entry& entry) {
+        const Entry old = entry;
+        const u32 vertexEnd = (u32)mesh.vertices.Length(), indexEnd = (u32)mesh.indices.Length();
+        // triangulated at the end first, since the new counts arent known before
+        AppendLocalGeometry(entry);
+        if (entry.vertexCount != old.vertexCount || entry.indexCount != old.indexCount) {
+            needsRebuild = true;
+            return;
+        }
+
+        const u32 shift = vertexEnd - old.vertexStart;
+        for (u32 v = 0; v < entry.vertexCount; ++v) {
+            mesh.vertices[old.vertexStart + v] = mesh.vertices[vertexEnd + v];
+            localPositions[old.vertexStart + v] = localPositions[vertexEnd + v];
+        }
+        for (u32 t = 0; t < entry.indexCount; ++t) {
+            const Graphics::TriIndices& tri = mesh.indices[indexEnd + t];
+            mesh.indices[old.indexStart + t] = { tri.i - shift, tri.j - shift, tri.k - shift };
+        }
+        mesh.vertices.Truncate(vertexEnd);
+        localPositions.Truncate(vertexEnd);
+        mesh.indices.Truncate(indexEnd);
+
+        entry.vertexStart = old.vertexStart;
+        entry.markerStart -= shift;
+        entry.indexStart = old.indexStart;
+        entry.shapeChanged = false;
+    }
+
+    void DebugMeshBuilder::AppendLocalGeometry(Entry& entry) {
+        using namespace Graphics;
+        entry.vertexStart = (u32)mesh.vertices.Length();
+        entry.indexStart = (u32)mesh.indices.Length();
+        entry.needsWrite = true;
+        entry.shapeChanged = false;
+        if (!entry.body) { entry.vertexCount = entry.indexCount = 0; entry.markerStart = entry.vertexStart; return; }
+
+        const Math::fColor& color = entry.color;
+        entry.markerStart = ~0;
+        const auto pushMarker = [&] (const fVector2& p) {
+            entry.markerStart = (u32)mesh.vertices.Length();
+            const Math::fColor white = Math::fColor::WHITE();
+            auto meshp = mesh.NewBatch();
+            meshp.PushV({ p + fVector2 { -0.5f, -0.5f }, white });
+            meshp.PushV({ p + fVector2 { -0.5f, +0.5f }, white });
+            meshp.PushV({ p + fVector2 { +0.5f, -0.5f }, white });
+            meshp.PushV({ p + fVector2 { +0.5f, +0.5f }, white });
+            meshp.PushI(0, 1, 2);
+            meshp.PushI(1, 2, 3);
+        };
+
+        Qmatch$(entry.body->shape, (
+            instanceof (const CircleShape& circ) {
+                // only the subdivisions go in the options, so every circle shares one cached geometry
+                MeshUtils::CircleCreator::MergeCached(
+                    { circleSubdivisions },
+                    QGLCreateBlueprint$(Vertex, (
+                        in (Position),
+                        out (Position) = Position * circ.radius;,
+                        out (Color)    = color;
+                    )),
+                    mesh
+                );
+                pushMarker({ circ.radius, 0 });
+            },
+            instanceof (const CapsuleShape& cap) {
+                MeshUtils::StadiumCreator::Merge(
+                    { .start = -cap.forward, .end = cap.forward, .radius = cap.radius, .subdivisions = capsuleSubdivisions },
+                    QGLCreateBlueprint$(Vertex, (
+                        in (Position),
+                        out (Position) = Position;,
+                        out (Color)    = color;
+                    )), mesh
+                );
+                pushMarker(cap.forward.perpend() * (cap.invLength * cap.radius));
+            },
+            instanceof (const TriangleShape& tri) {
+                mesh.PushPolygon({
+                    { tri.points[0], color },
+                    { tri.points[1], color },
+                    { tri.points[2], color },
+                });
+            },
+            instanceof (const RectShape& rect) {
+                mesh.PushPolygon({
+                    { rect.Corner(false, false), color },
+                    { rect.Corner(true,  false), color },
+                    { rect.Corner(true,  true ), color },
+                    { rect.Corner(false, true ), color },
+                });
+            },
+            instanceof (const QuadShape& quad) {
+                mesh.PushPolygon({
+                    { quad.points[0], color },
+                    { quad.points[1], color },
+                    { quad.points[2], color },
+                    { quad.points[3], color },
+                });
+            },
+            instanceof (const DynPolygonShape& poly) {
+                mesh.PushPolygon(
+                    poly.data.Iter()
+                             .Map(Operators::Member<&DynPolygonShape::PointWithInvDist::coords> {})
+                             .Map([&] (const fVector2& p) { return Vertex { p, color }; })
+                );
+            }
+        ))
+
+        entry.vertexCount = (u32)mesh.vertices.Length() - entry.vertexStart;
+        entry.indexCount = (u32)mesh.indices.Length() - entry.indexStart;
+        if (entry.markerStart == ~0) entry.markerStart = (u32)mesh.vertices.Length();
+        localPositions.Reserve(entry.vertexCount);
+        for (u32 v = entry.vertexStart; v < mesh.vertices.Length(); ++v)
+            localPositions.Push(mesh.vertices[v].Position);
+    }
+
+    void DebugMeshBuilder::WriteTransformed(const Entry& entry, const PhysicsTransform& xf) {
+        const fVector2* src = localPositions.Data() + entry.vertexStart;
+        Vertex* dst = mesh.vertices.Data() + entry.vertexStart;
+        const u32 n = entry.vertexCount;
+
+        u32 i = 0;
+#if QUASI_DEBUGMESH_SSE
+        // two points per register as x0 y0 x1 y1, rotated by the complex (c, s)
+        const float c = xf.rotation.re, s = xf.rotation.im;
+        const __m128 cc = _mm_set1_ps(c),
+                     ss = _mm_setr_ps(-s, s, -s, s),
+                     tt = _mm_setr_ps(xf.position.x, xf.position.y, xf.position.x, xf.position.y);
+        for (; i + 2 <= n; i += 2) {
+            const __m128 p = _mm_loadu_ps(&src[i].x),
+                         q = _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 3, 0, 1));
+            const __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(p, cc), _mm_mul_ps(q, ss)), tt);
+            _mm_storel_pi((__m64*)&dst[i].Position.x, r);
+            _mm_storeh_pi((__m64*)&dst[i + 1].Position.x, r);
+        }
+#endif
+        for (; i < n; ++i) {
+            dst[i].Position = xf.rotation.rotate(src[i]) + xf.position;
+        }
+    }
+} // Physics2D
@@ -0,0 +1,56 @@
+#pragma once
+#include "Body2D.h"
+#include "Color.h"
+#include "Mesh.h"
+#include "VertexElement.h"
+
+namespace Quasi::Physics2D {
+    // keeps a single mesh with the geometry of every tracked body.
+    // each shape is triangulated once in local space, and per frame only the
+    // positions of bodies that moved are rewritten, so nothing is allocated
+    class DebugMeshBuilder {
+    public:
+        using Vertex = Graphics::VertexColor2D;
+
+        struct Entry {
+            BodyHandle body;
+            Math::fColor color;
+            u32 vertexStart = 0, vertexCount = 0, markerStart = 0;
+            u32 indexStart = 0, indexCount = 0;
+            PhysicsTransform lastTransform;
+            bool needsWrite = true, shapeChanged = false;
+        };
+    private:
+        Vec<Entry> entries;
+        Vec<fVector2> localPositions; // parallel to mesh.vertices
+        Graphics::Mesh<Vertex> mesh;
+        bool needsRebuild = false, anyShapeChanged = false;
+    public:
+        u32 circleSubdivisions = 16, capsuleSubdivisions = 4;
+
+        DebugMeshBuilder() = default;
+
+        // returns the index of the entry, which is the number of entries tracked before it
+        u32 Track(BodyHandle body, const Math::fColor& color);
+        // entries after i move down by one, so indices from Track past i are off by one after this
+        void Untrack(u32 i);
+        void Clear();
+        usize TrackedCount() const { return entries.Length(); }
+
+        void SetColor(u32 i, const Math::fColor& color);
+        // re-triangulates entry i on the next Update. in place if the vertex and index counts
+        // stay the same, like for a resized circle, otherwise the whole mesh is laid out again
+        void MarkShapeChanged(u32 i) { entries[i].shapeChanged = true; anyShapeChanged = true; }
+        void MarkAllDirty();
+
+        // writes transforms of bodies that moved since the last call, returns how many were written
+        u32 Update();
+
+        const Graphics::Mesh<Vertex>& GetMesh() const { return mesh; }
+    private:
+        void Rebuild();
+        void Retriangulate(Entry& entry);
+        void AppendLocalGeometry(Entry& entry);
+        void WriteTransformed(const Entry& entry, const PhysicsTransform& xf);
+    };
+} // Physics2D
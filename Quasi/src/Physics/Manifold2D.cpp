@@ -22,13 +22,13 @@ namespace Quasi::Physics2D {
         const bool flip = std::abs(baseClips.forward().dot(n)) > std::abs(targetClips.forward().dot(n));
         const fLine2D& ref = flip ? targetClips : baseClips, &inc = flip ? baseClips : targetClips;
 
-        Manifold manifold = FromEdges(ref, inc, flip ? n : -n);
+        Manifold manifold = FromEdges(ref, inc, flip ? n : -n, sat.margin);
         manifold.seperatingNormal = n;
         // return the valid points
         return manifold;
     }
 
-    Manifold Manifold::FromEdges(const fLine2D& ref, const fLine2D& inc, const fVector2& n) {
+    Manifold Manifold::FromEdges(const fLine2D& ref, const fLine2D& inc, const fVector2& n, float margin) {
         const fVector2 refFwd = ref.forward().norm();
 
         Manifold manifold = Clip(inc.start, inc.end, refFwd, refFwd.dot(ref.start));
@@ -39,10 +39,11 @@ namespace Quasi::Physics2D {
         const fVector2 refNorm = n;
         const float max = ref.start.dot(refNorm);
 
-        if (const float d = refNorm.dot(manifold.contactPoint[0]) - max; d > 0) {
+        // points within the margin are kept as speculative contacts with negative depth
+        if (const float d = refNorm.dot(manifold.contactPoint[0]) - max; d > -margin) {
             result.AddPoint(manifold.contactPoint[0], d);
         }
-        if (const float d = refNorm.dot(manifold.contactPoint[1]) - max; d > 0) {
+        if (const float d = refNorm.dot(manifold.contactPoint[1]) - max; d > -margin) {
             result.AddPoint(manifold.contactPoint[1], d);
         }
         // return the valid points
@@ -0,0 +1,188 @@
+#include "ParticleSystem2D.h"
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define QUASI_PARTICLE_SSE 1
+#include <xmmintrin.h>
+#else
+#define QUASI_PARTICLE_SSE 0
+#endif
+
+#include "World2D.h"
+
+namespace Quasi::Physics2D {
+    ParticleSystem::ParticleSystem(World& world) : gravity(world.gravity), world(world) {}
+
+    void ParticleSystem::Reserve(usize count) {
+        posX.Reserve(count); posY.Reserve(count);
+        velX.Reserve(count); velY.Reserve(count);
+        radius.Reserve(count);
+    }
+
+    void ParticleSystem::Clear() {
+        posX.Clear(); posY.Clear();
+        velX.Clear(); velY.Clear();
+        radius.Clear();
+        cellStart.Clear(); cellEntries.Clear(); particleBucket.Clear();
+        maxRadius = 0.0f;
+    }
+
+    u32 ParticleSystem::Spawn(const ParticleCreateOptions& options) {
+        posX.Push(options.position.x); posY.Push(options.position.y);
+        velX.Push(options.velocity.x); velY.Push(options.velocity.y);
+        radius.Push(options.radius);
+        maxRadius = std::max(maxRadius, options.radius);
+        return (u32)Count() - 1;
+    }
+
+    void ParticleSystem::SpawnMany(Span<const ParticleCreateOptions> options) {
+        Reserve(options.Length());
+        for (const ParticleCreateOptions& o : options) Spawn(o);
+    }
+
+    void ParticleSystem::Remove(u32 i) {
+        // maxRadius is left as is, it only needs to be an upper bound
+        posX.PopUnordered(i); posY.PopUnordered(i);
+        velX.PopUnordered(i); velY.PopUnordered(i);
+        radius.PopUnordered(i);
+    }
+
+    void ParticleSystem::Update(float dt) {
+        // world gravity wins if attached, so particles fall with the bodies
+        if (world) gravity = world->gravity;
+        Integrate(dt);
+        if (!collideParticles && !world) return;
+
+        BuildGrid();
+        if (collideParticles) SolveParticleContacts();
+        if (world) SolveBodyContacts();
+    }
+
+    void ParticleSystem::Update(float dt, int simUpdates) {
+        for (int i = 0; i < simUpdates; ++i) {
+            Update(dt / (float)simUpdates);
+        }
+    }
+
+    void ParticleSystem::Integrate(float dt) {
+        const usize n = Count();
+        float* px = posX.Data(), *py = posY.Data(), *vx = velX.Data(), *vy = velY.Data();
+        const float gx = gravity.x * dt, gy = gravity.y * dt;
+
+        usize i = 0;
+#if QUASI_PARTICLE_SSE
+        const __m128 dt4 = _mm_set1_ps(dt), gx4 = _mm_set1_ps(gx), gy4 = _mm_set1_ps(gy);
+        for (; i + 4 <= n; i += 4) {
+            const __m128 nvx = _mm_add_ps(_mm_loadu_ps(vx + i), gx4),
+                         nvy = _mm_add_ps(_mm_loadu_ps(vy + i), gy4);
+            _mm_storeu_ps(vx + i, nvx);
+            _mm_storeu_ps(vy + i, nvy);
+            _mm_storeu_ps(px + i, _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(nvx, dt4)));
+            _mm_storeu_ps(py + i, _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(nvy, dt4)));
+        }
+#endif
+        for (; i < n; ++i) {
+            vx[i] += gx; vy[i] += gy;
+            px[i] += vx[i] * dt; py[i] += vy[i] * dt;
+        }
+    }
+
+    void ParticleSystem::BuildGrid() {
+        const u32 n = (u32)Count();
+        // cells at least as wide as a particle keep every contact within the 3x3 neighborhood
+        const float size = cellSize > 0 ? cellSize : 2 * maxRadius;
+        invCellSize = size > 0 ? 1 / size : 1.0f;
+
+        const u32 bucketCount = std::bit_ceil(std::max(n, 16u));
+        bucketMask = bucketCount - 1;
+
+        cellStart.Clear();
+        cellStart.Resize(bucketCount + 1, 0);
+        particleBucket.Resize(n);
+        cellEntries.Resize(n);
+
+        for (u32 i = 0; i < n; ++i) {
+            const u32 b = BucketOf(CellOf(posX[i]), CellOf(posY[i]));
+            particleBucket[i] = b;
+            ++cellStart[b];
+        }
+        // inclusive prefix sum, then fill backwards so cellStart[b] ends at the bucket start
+        for (u32 b = 1; b < bucketCount; ++b) cellStart[b] += cellStart[b - 1];
+        cellStart[bucketCount] = n;
+        for (u32 i = n; i --> 0;) {
+            cellEntries[--cellStart[particleBucket[i]]] = i;
+        }
+    }
+
+    void ParticleSystem::SolveParticleContacts() {
+        const u32 n = (u32)Count();
+        float* px = posX.Data(), *py = posY.Data(), *vx = velX.Data(), *vy = velY.Data();
+        const float* r = radius.Data();
+
+        for (u32 i = 0; i < n; ++i) {
+            const i32 cx = CellOf(px[i]), cy = CellOf(py[i]);
+            u32 visited[9], visitedCount = 0;
+            for (i32 dy = -1; dy <= 1; ++dy)
+                for (i32 dx = -1; dx <= 1; ++dx) {
+                    const u32 b = BucketOf(cx + dx, cy + dy);
+                    // neighboring cells can hash into the same bucket
+                    if (std::find(visited, visited + visitedCount, b) != visited + visitedCount) continue;
+                    visited[visitedCount++] = b;
+
+                    for (u32 k = cellStart[b]; k < cellStart[b + 1]; ++k) {
+                        const u32 j = cellEntries[k];
+                        if (j <= i) continue;
+
+                        const float ox = px[j] - px[i], oy = py[j] - py[i], rsum = r[i] + r[j];
+                        const float dsq = ox * ox + oy * oy;
+                        if (dsq >= rsum * rsum || dsq <= 0.0f) continue;
+
+                        const float d = std::sqrt(dsq), nx = ox / d, ny = oy / d;
+                        const float push = 0.5f * (rsum - d);
+                        px[i] -= nx * push; py[i] -= ny * push;
+                        px[j] += nx * push; py[j] += ny * push;
+
+                        // equal masses, so the impulse is split evenly
+                        const float vn = (vx[j] - vx[i]) * nx + (vy[j] - vy[i]) * ny;
+                        if (vn >= 0.0f) continue;
+                        const float jn = -0.5f * (1.0f + restitution) * vn;
+                        vx[i] -= nx * jn; vy[i] -= ny * jn;
+                        vx[j] += nx * jn; vy[j] += ny * jn;
+                    }
+                }
+        }
+    }
+
+    void ParticleSystem::SolveBodyContacts() {
+        const World& w = *world;
+        for (u32 bi = 0; bi < w.bodies.Length(); ++bi) {
+            if (!w.BodyIsValid(bi)) continue;
+            const Body& body = w.bodies[bi];
+            if (!body.enabled) continue;
+
+            const PhysicsTransform bodyXf = body.GetTransform();
+            QueryArea(body.boundingBox.extrude(maxRadius), [&] (u32 p) {
+                const fVector2 pos = PositionOf(p);
+                const float r = radius[p];
+                if (!body.boundingBox.overlaps(fRect2D { pos - r, pos + r })) return;
+
+                const Manifold manifold = CollideShapes(CircleShape { r }, pos, body.shape, bodyXf);
+                if (!manifold.contactCount) return;
+
+                // the normal points from the particle into the body
+                const fVector2& n = manifold.seperatingNormal;
+                const float depth = manifold.contactCount == 2 ?
+                    std::max(manifold.contactDepth[0], manifold.contactDepth[1]) : manifold.contactDepth[0];
+                SetPosition(p, pos - n * depth);
+
+                const fVector2 relPos = manifold.contactPoint[0] - body.position;
+                const fVector2 bodyVel = body.velocity + relPos.perpend() * -body.angularVelocity;
+                const float vn = (VelocityOf(p) - bodyVel).dot(n);
+                if (vn > 0.0f)
+                    SetVelocity(p, VelocityOf(p) - n * ((1.0f + bodyRestitution) * vn));
+            });
+        }
+    }
+} // Physics2D
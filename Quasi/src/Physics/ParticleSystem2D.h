@@ -0,0 +1,93 @@
+#pragma once
+#include "Rect.h"
+#include "Vec.h"
+#include "Vector.h"
+
+namespace Quasi::Physics2D {
+    using namespace Math;
+
+    class World;
+
+    struct ParticleCreateOptions {
+        fVector2 position, velocity;
+        float radius = 0.1f;
+    };
+
+    // a bag of equal-mass circles, stored as plain float arrays so integration vectorizes.
+    // particles collide with each other through a hashed uniform grid and are pushed out of
+    // the bodies of an attached world, but never push back on them
+    class ParticleSystem {
+    public:
+        Vec<float> posX, posY, velX, velY, radius;
+        float maxRadius = 0.0f;
+
+        fVector2 gravity;
+        float restitution = 0.3f, bodyRestitution = 0.2f;
+        float cellSize = 0.0f; // <= 0 uses twice the largest radius
+        bool collideParticles = true;
+
+        OptRef<const World> world;
+    private:
+        // grid is a spatial hash sorted by counting sort: bucket b holds
+        // cellEntries[cellStart[b] .. cellStart[b + 1]]
+        Vec<u32> cellStart, cellEntries, particleBucket;
+        float invCellSize = 1.0f;
+        u32 bucketMask = 0;
+    public:
+        ParticleSystem() = default;
+        ParticleSystem(const fVector2& gravity) : gravity(gravity) {}
+        ParticleSystem(World& world);
+
+        usize Count() const { return posX.Length(); }
+        void Reserve(usize count);
+        void Clear();
+
+        u32 Spawn(const ParticleCreateOptions& options);
+        void SpawnMany(Span<const ParticleCreateOptions> options);
+        void Remove(u32 i); // swaps the last particle into i
+        void RemoveIf(Predicate<u32> auto&& pred) {
+            for (u32 i = 0; i < Count();) {
+                if (pred(i)) Remove(i); else ++i;
+            }
+        }
+
+        fVector2 PositionOf(u32 i) const { return { posX[i], posY[i] }; }
+        fVector2 VelocityOf(u32 i) const { return { velX[i], velY[i] }; }
+        void SetPosition(u32 i, const fVector2& p) { posX[i] = p.x; posY[i] = p.y; }
+        void SetVelocity(u32 i, const fVector2& v) { velX[i] = v.x; velY[i] = v.y; }
+
+        void Update(float dt);
+        void Update(float dt, int simUpdates);
+
+        // calls f(i) for every particle whose grid bucket touches the area. may include extras
+        void QueryArea(const fRect2D& area, FnArgs<u32> auto&& f) const {
+            if (cellStart.IsEmpty()) return;
+            const i32 x0 = CellOf(area.min.x), x1 = CellOf(area.max.x),
+                      y0 = CellOf(area.min.y), y1 = CellOf(area.max.y);
+            // a large area wraps over the whole table, so clamp to visiting every bucket once
+            if ((u64)(x1 - x0 + 1) * (u64)(y1 - y0 + 1) > bucketMask) {
+                for (const u32 p : cellEntries) f(p);
+                return;
+            }
+            for (i32 y = y0; y <= y1; ++y)
+                for (i32 x = x0; x <= x1; ++x) {
+                    const u32 b = BucketOf(x, y);
+                    for (u32 k = cellStart[b]; k < cellStart[b + 1]; ++k) f(cellEntries[k]);
+                }
+        }
+    private:
+        // clamped before the cast, a nan or a particle flung far away would overflow i32.
+        // the limit leaves room for x1 - x0 + 1 in QueryArea
+        static constexpr float MAX_CELL = (float)(1 << 29);
+        i32 CellOf(float x) const {
+            const float c = std::floor(x * invCellSize);
+            return c >= -MAX_CELL ? (i32)std::min(c, MAX_CELL) : (i32)-MAX_CELL;
+        }
+        u32 BucketOf(i32 x, i32 y) const { return ((u32)x * 73856093u ^ (u32)y * 19349663u) & bucketMask; }
+
+        void Integrate(float dt);
+        void BuildGrid();
+        void SolveParticleContacts();
+        void SolveBodyContacts();
+    };
+} // Physics2D
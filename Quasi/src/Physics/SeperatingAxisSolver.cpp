@@ -11,8 +11,8 @@ namespace Quasi::Physics2D {
 
     SeperatingAxisSolver SeperatingAxisSolver::CheckCollisionFor(
         const Shape& s1, const PhysicsTransform& xf1,
-        const Shape& s2, const PhysicsTransform& xf2) {
-        return { s1, xf1, s2, xf2, COLLISION };
+        const Shape& s2, const PhysicsTransform& xf2, float margin) {
+        return { s1, xf1, s2, xf2, COLLISION, margin };
     }
 
     OptRef<const Shape> SeperatingAxisSolver::CurrentlyCheckedShape() const {
@@ -55,7 +55,7 @@ namespace Quasi::Physics2D {
                            + targetXf->position.dot(worldAxis);
 
         const float d1 = bproj.max - tproj.min, d2 = tproj.max - bproj.min,
-                    depth = std::min(d1, d2);
+                    depth = std::min(d1, d2) + margin;
 
         if (depth <= 0) {
             collides = false;
@@ -76,7 +76,7 @@ namespace Quasi::Physics2D {
     }
 
     float SeperatingAxisSolver::GetDepth() const {
-        return overlap;
+        return overlap - margin;
     }
 
     const fVector2& SeperatingAxisSolver::GetSepAxis() const {
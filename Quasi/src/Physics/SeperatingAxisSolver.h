@@ -21,17 +21,19 @@ namespace Quasi::Physics2D {
 
         fVector2 seperatingAxis;
         float overlap = INFINITY;
+        float margin = 0.0f; // speculative distance, shapes closer than this still 'collide'
         u32 axisIndex = 0;
 
 
         SeperatingAxisSolver(const Shape& s1, const PhysicsTransform& xf1,
-                             const Shape& s2, const PhysicsTransform& xf2, CheckMode mode) :
-            base(s1), target(s2), baseXf(xf1), targetXf(xf2), checkMode(mode) {}
+                             const Shape& s2, const PhysicsTransform& xf2, CheckMode mode, float margin = 0.0f) :
+            base(s1), target(s2), baseXf(xf1), targetXf(xf2), checkMode(mode), margin(margin) {}
     public:
         static SeperatingAxisSolver CheckOverlapFor  (const Shape& s1, const PhysicsTransform& xf1,
                                                       const Shape& s2, const PhysicsTransform& xf2);
         static SeperatingAxisSolver CheckCollisionFor(const Shape& s1, const PhysicsTransform& xf1,
-                                                      const Shape& s2, const PhysicsTransform& xf2);
+                                                      const Shape& s2, const PhysicsTransform& xf2,
+                                                      float margin = 0.0f);
 
         OptRef<const Shape>            CurrentlyCheckedShape() const;
         OptRef<const PhysicsTransform> CurrentlyCheckedTransform() const;
@@ -42,7 +44,8 @@ namespace Quasi::Physics2D {
         bool IsChecking(Subject subject) const;
         bool Collides() const { return collides; }
 
-        float GetDepth() const;
+        float GetDepth() const; // negative for speculative contacts
+        float GetMargin() const { return margin; }
         const fVector2& GetSepAxis() const;
 
         friend struct Manifold;
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 
+#include "Logger.h"
 #include "Memory.h"
 
 namespace Quasi::Physics2D {
@@ -20,6 +21,7 @@ namespace Quasi::Physics2D {
         bodyIndicesSorted = std::move(w.bodyIndicesSorted);
         bodyCount         = w.bodyCount;
         gravity           = w.gravity;
+        speculativeContacts = w.speculativeContacts;
     }
 
     World& World::operator=(World&& w) noexcept {
@@ -28,6 +30,7 @@ namespace Quasi::Physics2D {
         bodyIndicesSorted = std::move(w.bodyIndicesSorted);
         bodyCount         = w.bodyCount;
         gravity           = w.gravity;
+        speculativeContacts = w.speculativeContacts;
         return *this;
     }
 
@@ -38,6 +41,7 @@ namespace Quasi::Physics2D {
         w.bodyIndicesSorted = bodyIndicesSorted.Clone();
         w.bodyCount         = bodyCount;
         w.gravity           = gravity;
+        w.speculativeContacts = speculativeContacts;
         return w;
     }
 
@@ -81,11 +85,10 @@ namespace Quasi::Physics2D {
         return bodySparseEnabled.Length() * BITS_IN_USIZE;
     }
 
-    BodyHandle World::CreateBody(const BodyCreateOptions& options, Shape shape) {
+    Body World::NewBody(const BodyCreateOptions& options, Shape shape) {
         const float area = shape.ComputeArea();
-        const u32 i = FindVacantIndex();
         const bool isStatic = options.type == BodyType::STATIC;
-        Body b {
+        return {
             options.position,
             fComplex::rotate(RAD2DEG * options.rotAngle),
             isStatic ? 0 : area * options.density,
@@ -93,6 +96,30 @@ namespace Quasi::Physics2D {
             *this,
             std::move(shape)
         };
+    }
+
+    void World::MergeBodyIndices(Span<u32> added) {
+        const auto minX = [&] (u32 i) { return bodies[i].boundingBox.min.x; };
+        added.SortByKey(minX);
+
+        Vec<u32> merged = Vec<u32>::WithCap(bodyCount);
+        usize j = 0;
+        for (const u32 i : bodyIndicesSorted) {
+            if (i == ~0) continue; // drops the tombstones left by DeleteBody
+            while (j < added.Length() && minX(added[j]) < minX(i))
+                merged.Push(added[j++]);
+            merged.Push(i);
+        }
+        merged.Extend(added.Skip(j));
+
+        for (u32 k = 0; k < merged.Length(); ++k)
+            bodies[merged[k]].sortedIndex = k;
+        bodyIndicesSorted = std::move(merged);
+    }
+
+    BodyHandle World::CreateBody(const BodyCreateOptions& options, Shape shape) {
+        const u32 i = FindVacantIndex();
+        Body b = NewBody(options, std::move(shape));
         if (i >= bodySparseEnabled.Length() * BITS_IN_USIZE) {
             bodySparseEnabled.Push(1);
             bodies.Push(std::move(b));
@@ -111,6 +138,44 @@ namespace Quasi::Physics2D {
         return BodyHandle::At(*this, i);
     }
 
+    Vec<BodyHandle> World::CreateBodies(Span<const BodyCreateOptions> options, Span<Shape> shapes) {
+        Debug::QAssertMsg$(options.Length() == shapes.Length(), "CreateBodies needs a shape for every options");
+        const usize count = options.Length();
+        Vec<BodyHandle> handles = Vec<BodyHandle>::WithCap(count);
+        if (!count) return handles;
+
+        Vec<u32> added = Vec<u32>::WithCap(count);
+        usize next = 0;
+        // fill the holes left by deleted bodies first
+        const u32 occupied = (u32)bodies.Length();
+        for (u32 w = 0; w < bodySparseEnabled.Length() && next < count; ++w) {
+            for (usize vacant = ~bodySparseEnabled[w]; vacant && next < count; vacant &= vacant - 1) {
+                const u32 i = w * BITS_IN_USIZE + std::countr_zero(vacant);
+                if (i >= occupied) break;
+                Memory::ConstructAt(&bodies[i], NewBody(options[next], std::move(shapes[next])));
+                bodySparseEnabled[w] |= (usize)1 << (i % BITS_IN_USIZE);
+                added.Push(i);
+                ++next;
+            }
+        }
+
+        // then append the rest with a single reservation
+        const usize appended = count - next;
+        bodies.ReserveExact(appended);
+        bodySparseEnabled.Resize((bodies.Length() + appended + BITS_IN_USIZE - 1) / BITS_IN_USIZE, 0);
+        for (; next < count; ++next) {
+            const u32 i = (u32)bodies.Length();
+            bodies.Push(NewBody(options[next], std::move(shapes[next])));
+            bodySparseEnabled[i / BITS_IN_USIZE] |= (usize)1 << (i % BITS_IN_USIZE);
+            added.Push(i);
+        }
+        bodyCount += count;
+
+        for (const u32 i : added) handles.Push(BodyHandle::At(*this, i));
+        MergeBodyIndices(added.AsSpan());
+        return handles;
+    }
+
     void World::DeleteBody(usize i) {
         if (BodyIsValid(i)) {
             bodySparseEnabled[i / BITS_IN_USIZE] &= ~((usize)1 << i % BITS_IN_USIZE);
@@ -120,6 +185,15 @@ namespace Quasi::Physics2D {
         }
     }
 
+    void World::DeleteBodies(Span<const u32> indices) {
+        for (const u32 i : indices) DeleteBody(i);
+
+        // compact the tombstones now instead of bubbling them back in SortBodyIndices
+        bodyIndicesSorted.Keep([] (u32 i) { return i != ~0; });
+        for (u32 k = 0; k < bodyIndicesSorted.Length(); ++k)
+            bodies[bodyIndicesSorted[k]].sortedIndex = k;
+    }
+
     void World::Update(float dt) {
         for (u32 i = 0; i < bodies.Length(); ++i) {
             if (!BodyIsValid(i)) continue;
@@ -129,6 +203,7 @@ namespace Quasi::Physics2D {
             if (b.type == BodyType::DYNAMIC)
                 b.velocity += gravity * dt;
             b.Update(dt);
+            if (speculativeContacts) b.SweepBoundingBox(dt);
         }
 
         SortBodyIndices();
@@ -146,12 +221,18 @@ namespace Quasi::Physics2D {
                 if (c.boundingBox.max.x > min) {
                     const bool bDyn = b.IsDynamic(), cDyn = c.IsDynamic();
                     if ((bDyn || cDyn) && c.boundingBox.yrange().overlaps(b.boundingBox.yrange())) {
-                        const Manifold manifold = b.CollideWith(c);
-                        if (manifold.contactCount && std::max(manifold.contactDepth[0], manifold.contactDepth[1]) > EPSILON) {
+                        const float margin = speculativeContacts ? (b.velocity - c.velocity).len() * dt : 0.0f;
+                        const Manifold manifold = b.CollideWith(c, margin);
+                        if (manifold.contactCount && (speculativeContacts ||
+                            std::max(manifold.contactDepth[0], manifold.contactDepth[1]) > EPSILON)) {
                             StaticResolve(b, c, manifold);
-                            DynamicResolve(b, c, manifold);
+                            DynamicResolve(b, c, manifold, speculativeContacts ? 1 / dt : 0.0f);
                             if (bDyn) b.TryUpdateTransforms();
                             if (cDyn) c.TryUpdateTransforms();
+                            if (speculativeContacts) {
+                                if (bDyn) b.SweepBoundingBox(dt);
+                                if (cDyn) c.SweepBoundingBox(dt);
+                            }
                         }
                     }
                     ++j;
@@ -13,6 +13,9 @@ namespace Quasi::Physics2D {
         static constexpr u32 BITS_IN_USIZE = 8 * sizeof(usize);
 
         fVector2 gravity;
+        // sweeps bounding boxes by velocity * dt and treats near misses as speculative contacts,
+        // which keeps fast bodies from tunneling with fewer substeps
+        bool speculativeContacts = false;
     public:
         World() = default;
         World(const fVector2& gravity) : gravity(gravity) {}
@@ -27,7 +30,9 @@ namespace Quasi::Physics2D {
     private:
         const Body& BodyDirectAt(u32 i) const { return bodies[i]; }
         Body& BodyDirectAt(u32 i) { return bodies[i]; }
+        Body NewBody(const BodyCreateOptions& options, Shape shape);
         void SortBodyIndices();
+        void MergeBodyIndices(Span<u32> added);
     public:
         usize BodyCount() const { return bodyCount; }
         void Reserve(usize size);
@@ -38,7 +43,11 @@ namespace Quasi::Physics2D {
         template <class S, class... Rs> BodyHandle CreateBody(const BodyCreateOptions& options, Rs&&... args) {
             return this->CreateBody(options, S(std::forward<Rs>(args)...));
         }
+        // creates options.Length() bodies at once, reusing vacant slots before appending.
+        // handles are returned in the same order as the options
+        Vec<BodyHandle> CreateBodies(Span<const BodyCreateOptions> options, Span<Shape> shapes);
         void DeleteBody(usize i);
+        void DeleteBodies(Span<const u32> indices);
 
         void Update(float dt);
         void Update(float dt, int simUpdates);
@@ -48,6 +48,14 @@ namespace Quasi::Text {
         return false;
     }
 
+    bool WriteFileBinary(CStr fname, Str contents) {
+        if (std::ofstream out { fname.Data(), std::ios::binary }) {
+            out.write(contents.Data(), (isize)contents.Length());
+            return (bool)out;
+        }
+        return false;
+    }
+
     bool ExistsFile(CStr fname) {
         return std::ifstream { fname.Data() }.good();
     }
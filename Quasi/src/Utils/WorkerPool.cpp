@@ -0,0 +1,105 @@
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Quasi {
+    namespace {
+        thread_local bool insideLoop = false;
+    }
+
+    struct WorkerPool::State {
+        std::vector<std::thread> threads;
+        std::mutex loopLock;   // held for a whole ParallelFor
+        std::mutex wakeLock;
+        std::condition_variable wake, finished;
+        u64 generation = 0;
+        bool stopping = false;
+
+        // the loop being run
+        FuncRef<void(usize, usize)> fn;
+        usize count = 0, chunk = 1;
+        std::atomic<usize> next = 0;
+        std::atomic<u32> working = 0;
+
+        void RunChunks() {
+            insideLoop = true;
+            for (usize begin; (begin = next.fetch_add(chunk)) < count;)
+                fn(begin, std::min(begin + chunk, count));
+            insideLoop = false;
+        }
+
+        void WorkerMain() {
+            u64 seen = 0;
+            while (true) {
+                {
+                    std::unique_lock lock { wakeLock };
+                    wake.wait(lock, [&] { return stopping || generation != seen; });
+                    if (stopping) return;
+                    seen = generation;
+                }
+                RunChunks();
+                if (working.fetch_sub(1) == 1) {
+                    std::lock_guard lock { wakeLock };
+                    finished.notify_one();
+                }
+            }
+        }
+    };
+
+    WorkerPool::WorkerPool(u32 workers) : state(new State) {
+        state->threads.reserve(workers);
+        for (u32 i = 0; i < workers; ++i)
+            state->threads.emplace_back([s = state] { s->WorkerMain(); });
+    }
+
+    WorkerPool::~WorkerPool() {
+        {
+            std::lock_guard lock { state->wakeLock };
+            state->stopping = true;
+        }
+        state->wake.notify_all();
+        for (std::thread& t : state->threads) t.join();
+        delete state;
+    }
+
+    WorkerPool& WorkerPool::Global() {
+        static WorkerPool pool { std::max(std::thread::hardware_concurrency(), 2u) - 1 };
+        return pool;
+    }
+
+    u32 WorkerPool::ThreadCount() const {
+        return (u32)state->threads.size() + 1;
+    }
+
+    void WorkerPool::ParallelFor(usize count, usize minChunk, FuncRef<void(usize, usize)> fn) {
+        if (count == 0) return;
+        minChunk = std::max<usize>(minChunk, 1);
+        if (insideLoop || state->threads.empty() || count <= minChunk) {
+            fn(0, count);
+            return;
+        }
+
+        std::lock_guard loop { state->loopLock };
+        // a few chunks per thread so uneven ranges even out
+        const usize chunk = std::max(minChunk, count / (ThreadCount() * 4) + 1);
+        {
+            std::lock_guard lock { state->wakeLock };
+            state->fn = fn;
+            state->count = count;
+            state->chunk = chunk;
+            state->next = 0;
+            state->working = (u32)state->threads.size();
+            ++state->generation;
+        }
+        state->wake.notify_all();
+
+        state->RunChunks();
+        std::unique_lock lock { state->wakeLock };
+        state->finished.wait(lock, [&] { return state->working == 0; });
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include "Type.h"
+#include "Func.h"
+
+namespace Quasi {
+    // a fixed set of threads to split loops over. ParallelFor blocks until every chunk is
+    // done and the calling thread takes chunks as well, so nothing outlives the call.
+    // only one loop runs at a time, a ParallelFor from inside a chunk just runs in place
+    class WorkerPool {
+        struct State;
+        State* state = nullptr;
+    public:
+        explicit WorkerPool(u32 workers);
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        // one less than the hardware threads, the caller is the last one
+        static WorkerPool& Global();
+
+        // threads that take part in a loop, counting the caller
+        u32 ThreadCount() const;
+        // calls fn(begin, end) for disjoint ranges covering [0, count), each at least minChunk long
+        void ParallelFor(usize count, usize minChunk, FuncRef<void(usize, usize)> fn);
+    };
+}
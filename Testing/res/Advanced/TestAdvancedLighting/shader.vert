@@ -8,7 +8,10 @@ out vec3 vPosition;
 out vec3 vNormal;
 flat out int vMatId;
 
-uniform mat4 u_projection, u_view;
+layout (std140) uniform Camera {
+    mat4 u_projection;
+    mat4 u_view;
+};
 
 void main() {
     gl_Position = u_projection * u_view * position;
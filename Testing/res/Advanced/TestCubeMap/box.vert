@@ -7,7 +7,10 @@ layout (location = 2) in vec3 normal;
 out vec2 vTexCoord;
 out vec3 vPosition, vNormal;
 
-uniform mat4 u_projection, u_view;
+layout (std140) uniform Camera {
+    mat4 u_projection;
+    mat4 u_view;
+};
 
 void main() {
     gl_Position = u_projection * u_view * position;
@@ -6,7 +6,10 @@ layout (location = 2) in vec3 normal;
 
 out vec3 vTexCoord;
 
-uniform mat4 u_projection, u_view;
+layout (std140) uniform Camera {
+    mat4 u_projection;
+    mat4 u_view;
+};
 
 void main() {
     // gl_Position = vec4(vec3(u_projection * u_view * vec4(position, 0.0)), 1.0);
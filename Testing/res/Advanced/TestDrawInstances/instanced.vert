@@ -1,19 +1,22 @@
 #version 330 core
 
-#define INSTANCE_NUM 27
-
 layout (location = 0) in vec4 position;
 layout (location = 1) in vec3 normal;
+// per instance, a mat4 takes 4 locations
+layout (location = 2) in mat4 model;
+layout (location = 6) in mat4 normMat;
+layout (location = 10) in vec3 color;
 
 out vec3 vNormal;
 out vec3 vColor;
 
-uniform mat4 u_projection, u_view;
-uniform mat4 models[INSTANCE_NUM], normMat[INSTANCE_NUM];
-uniform vec3 colors[INSTANCE_NUM];
+layout (std140) uniform Camera {
+    mat4 u_projection;
+    mat4 u_view;
+};
 
 void main() {
-    gl_Position = u_projection * u_view * models[gl_InstanceID] * position;
-    vNormal = normalize(vec3(normMat[gl_InstanceID] * vec4(normal, 0.0)));
-    vColor = colors[gl_InstanceID];
+    gl_Position = u_projection * u_view * model * position;
+    vNormal = normalize(vec3(normMat * vec4(normal, 0.0)));
+    vColor = color;
 }
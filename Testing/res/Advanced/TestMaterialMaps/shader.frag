@@ -6,11 +6,13 @@ in vec3 vPosition;
 in vec2 vTexCoord;
 in vec3 vNormal;
 
-uniform vec3 lightPosition;
-uniform vec3 lightColor;
-uniform float ambientStrength;
+layout (std140) uniform Lighting {
+    vec3 lightPosition;
+    vec3 lightColor;
+    float ambientStrength;
+    float specularIntensity;
+};
 uniform vec3 viewPosition;
-uniform float specularIntensity;
 
 uniform sampler2D diffuseMap, specularMap;
 
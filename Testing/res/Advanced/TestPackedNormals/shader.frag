@@ -0,0 +1,19 @@
+#version 330 core
+
+layout (location = 0) out vec4 glColor;
+
+in vec3 vNormal;
+
+uniform vec3 lightDirection;
+uniform vec3 color;
+uniform float ambientStrength;
+uniform float specularStrength;
+
+void main() {
+    vec3 normal = normalize(vNormal);
+    float diffuse = max(dot(normal, lightDirection), 0.0);
+    // the highlight is where a bad normal shows first
+    vec3 halfway = normalize(lightDirection + vec3(0.0, 0.0, 1.0));
+    float specular = pow(max(dot(normal, halfway), 0.0), 64.0) * specularStrength;
+    glColor = vec4(color * (ambientStrength + diffuse) + specular, 1.0);
+}
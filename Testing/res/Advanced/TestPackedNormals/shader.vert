@@ -0,0 +1,31 @@
+#version 330 core
+
+layout (location = 0) in vec4 position;
+#ifdef OCTAHEDRAL_NORMAL
+// two snorm16s, the normal folded onto an octahedron
+layout (location = 1) in vec2 normal;
+#else
+layout (location = 1) in vec3 normal;
+#endif
+
+out vec3 vNormal;
+
+layout (std140) uniform Camera {
+    mat4 u_projection;
+    mat4 u_view;
+};
+
+vec3 UnfoldNormal(vec2 p) {
+    vec3 n = vec3(p, 1.0 - abs(p.x) - abs(p.y));
+    if (n.z < 0.0) n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    return normalize(n);
+}
+
+void main() {
+    gl_Position = u_projection * u_view * position;
+#ifdef OCTAHEDRAL_NORMAL
+    vNormal = UnfoldNormal(normal);
+#else
+    vNormal = normalize(normal);
+#endif
+}
@@ -3,8 +3,10 @@
 layout(location = 0) in vec4 position;
 layout(location = 1) in vec4 color;
 
-uniform mat4 u_projection;
-uniform mat4 u_view;
+layout (std140) uniform Camera {
+    mat4 u_projection;
+    mat4 u_view;
+};
 
 void main() {
     gl_Position = u_projection * u_view * position;
@@ -9,8 +9,10 @@ out vec2 v_TexCoord;
 out vec4 v_color;
 flat out int v_index;
 
-uniform mat4 u_projection;
-uniform mat4 u_view;
+layout (std140) uniform Camera {
+    mat4 u_projection;
+    mat4 u_view;
+};
 
 void main() {
     gl_Position = u_projection * u_view * position;
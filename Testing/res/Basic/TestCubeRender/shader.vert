@@ -6,8 +6,10 @@ layout(location = 1) in vec4 color;
 out vec4 v_color;
 out float v_alpha;
 
-uniform mat4 u_projection;
-uniform mat4 u_view;
+layout (std140) uniform Camera {
+    mat4 u_projection;
+    mat4 u_view;
+};
 uniform float u_alpha;
 
 void main() {
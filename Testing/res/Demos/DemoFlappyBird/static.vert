@@ -0,0 +1,23 @@
+#version 330 core
+
+layout(location = 0) in vec4 position;
+layout(location = 1) in vec4 color;
+layout(location = 2) in vec2 texCoord;
+layout(location = 3) in int rtype;
+
+out vec4 v_color;
+out vec2 v_TexCoord;
+flat out int v_rtype;
+
+layout (std140) uniform Camera {
+    mat4 u_projection;
+    mat4 u_view;
+};
+uniform mat4 u_model;
+
+void main() {
+    gl_Position = u_projection * u_view * u_model * position;
+    v_rtype = rtype;
+    v_TexCoord = texCoord;
+    v_color = color;
+}
\ No newline at end of file
@@ -0,0 +1,7 @@
+#version 330 core
+
+layout (location = 0) out vec4 glColor;
+
+void main() {
+    glColor = vec4(0.35, 0.35, 0.4, 1.0);
+}
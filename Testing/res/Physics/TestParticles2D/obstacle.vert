@@ -0,0 +1,11 @@
+#version 330 core
+
+layout (location = 0) in vec2 position;
+
+uniform mat4 u_projection;
+uniform vec2 offset;
+uniform float scale;
+
+void main() {
+    gl_Position = u_projection * vec4(position * scale + offset, 0.0, 1.0);
+}
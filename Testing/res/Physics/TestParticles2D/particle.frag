@@ -0,0 +1,11 @@
+#version 330 core
+
+layout (location = 0) out vec4 glColor;
+
+in vec2 vLocal;
+in vec4 vColor;
+
+void main() {
+    if (dot(vLocal, vLocal) > 1.0) discard;
+    glColor = vColor;
+}
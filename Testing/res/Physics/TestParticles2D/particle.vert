@@ -0,0 +1,18 @@
+#version 330 core
+
+layout (location = 0) in vec2 position;
+// per instance
+layout (location = 1) in vec2 offset;
+layout (location = 2) in float scale;
+layout (location = 3) in float speed;
+
+uniform mat4 u_projection;
+
+out vec2 vLocal;
+out vec4 vColor;
+
+void main() {
+    gl_Position = u_projection * vec4(position * scale + offset, 0.0, 1.0);
+    vLocal = position;
+    vColor = vec4(mix(vec3(0.2, 0.4, 1.0), vec3(1.0, 0.9, 0.5), clamp(speed / 20.0, 0.0, 1.0)), 1.0);
+}
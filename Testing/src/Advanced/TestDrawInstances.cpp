@@ -10,6 +10,7 @@
 namespace Test {
     void TestDrawInstances::OnInit(Graphics::GraphicsDevice& gdevice) {
         scene = gdevice.CreateNewRender<Vertex>();
+        instances = Graphics::InstanceBuffer<Instance>::New(scene.GetRenderData(), INSTANCE_NUM);
 
         transforms.Resize(INSTANCE_NUM);
         colors.Resize(INSTANCE_NUM);
@@ -38,6 +39,12 @@ namespace Test {
 
         scene.UseShaderFromFile(res("instanced.vert"), res("instanced.frag"));
 
+        cubeBounds = cube.LocalBounds();
+        occlusion = Graphics::OcclusionBuffer::New();
+        cubeHandles.Reserve(INSTANCE_NUM);
+        for (u32 i = 0; i < INSTANCE_NUM; ++i)
+            cubeHandles.Push(bvh.Insert(Graphics::Mesh<Vertex>::TransformBounds(cubeBounds, transforms[i]), i));
+
         camera.position = { -6.8653593, -7.7674685, -6.846223 };
         camera.yaw = -2.2986794; camera.pitch = -0.55294377;
         camera.speed = 5;
@@ -56,18 +63,21 @@ namespace Test {
         scene.SetProjection(camera.GetProjMat());
         scene.SetCamera(camera.GetViewMat());
 
-        Vec<Math::Matrix3D> modelMats, normMats;
-        modelMats.Reserve(INSTANCE_NUM);
-        normMats.Reserve(INSTANCE_NUM);
-        for (const auto& t : transforms) {
-            modelMats.Push(t.TransformMatrix());
-            normMats.Push(t.NormalTransform().TransformMatrix());
+        CullCubes(camera.GetProjMat() * camera.GetViewMat());
+        if (visibleCubes.IsEmpty()) return;
+
+        Span<Instance> data = instances.Map(visibleCubes.Length());
+        for (usize n = 0; n < visibleCubes.Length(); ++n) {
+            const u32 i = visibleCubes[n];
+            data[n] = {
+                .Model        = transforms[i].TransformMatrix(),
+                .NormalMatrix = transforms[i].NormalTransform().TransformMatrix(),
+                .Color        = colors[i],
+            };
         }
+        instances.Unmap();
 
-        scene.DrawInstanced(cube, INSTANCE_NUM, Graphics::UseArgs({
-            { "models",         modelMats },
-            { "normMat",        normMats },
-            { "colors",         colors },
+        scene.DrawInstanced(cube, (int)instances.Count(), Graphics::UseArgs({
             { "lightDirection", Math::fVector3::from_spheric(1, lightYaw, lightPitch) },
             { "ambientStrength", ambStrength },
         }));
@@ -76,6 +86,11 @@ namespace Test {
     void TestDrawInstances::OnImGuiRender(Graphics::GraphicsDevice& gdevice) {
         ImGui::EditRotation("Light Rotation", lightYaw, lightPitch);
         ImGui::EditScalar("Ambient", ambStrength, 0.05f);
+
+        ImGui::Checkbox("Frustum Culling", &frustumCull);
+        if (frustumCull) ImGui::Checkbox("Occlusion Culling", &occlusionCull);
+        ImGui::Text("Cubes Drawn: %zu, Culled: %zu (%u occlusion rejects)", visibleCubes.Length(), culledCubes, occludedBoxes);
+
         if (ImGui::TreeNode("Cube Instances")) {
             for (u32 i = 0; i < INSTANCE_NUM; ++i) {
                 if (!ImGui::TreeNode(std::format("Cube #{}", i + 1).c_str())) continue;
@@ -95,6 +110,34 @@ namespace Test {
         scene.Destroy();
     }
 
+    void TestDrawInstances::CullCubes(const Math::Matrix3D& viewProj) {
+        visibleCubes.Clear();
+        occludedBoxes = 0;
+        if (!frustumCull) {
+            for (u32 i = 0; i < INSTANCE_NUM; ++i) visibleCubes.Push(i);
+            culledCubes = 0;
+            return;
+        }
+
+        // the transforms can be edited at any time, refitting 27 boxes costs nothing
+        for (u32 i = 0; i < INSTANCE_NUM; ++i)
+            bvh.Update(cubeHandles[i], Graphics::Mesh<Vertex>::TransformBounds(cubeBounds, transforms[i]));
+
+        // the cubes are their own occluders, the outer ones hide the ones in the middle
+        if (occlusionCull) {
+            occlusion.Clear(viewProj);
+            for (const Math::Transform3D& t : transforms) {
+                occlusion.AddOccluder(Memory::TransmutePtr<const byte>(&cube.vertices[0].Position), cube.vertices.Length(), sizeof(Vertex),
+                                      cube.indices.AsSpan(), t.TransformMatrix());
+            }
+        }
+
+        bvh.ResetStats();
+        bvh.Cull(viewProj, visibleCubes, occlusionCull ? OptRef { occlusion } : nullptr);
+        occludedBoxes = bvh.GetStats().occluded;
+        culledCubes = INSTANCE_NUM - visibleCubes.Length();
+    }
+
     void TestDrawInstances::RandomizeRotations(Graphics::GraphicsDevice& gdevice) {
         for (u32 i = 0; i < INSTANCE_NUM; ++i) {
             transforms[i].rotation = Math::Quaternion::random_rot(gdevice.GetRand());
@@ -1,18 +1,37 @@
 #pragma once
 #include "CameraController.h"
+#include "InstanceBuffer.h"
 #include "Mesh.h"
+#include "SceneBVH.h"
 #include "Test.h"
 
 namespace Test {
     class TestDrawInstances : public Test {
         using Vertex = Graphics::VertexNormal3D;
+        struct Instance {
+            Math::Matrix3D Model, NormalMatrix;
+            Math::fColor3 Color;
+
+            QuasiDefineInstance$(Instance, (Model)(NormalMatrix)(Color));
+        };
         static constexpr int INSTANCE_NUM = 27;
         Graphics::RenderObject<Vertex> scene;
+        Graphics::InstanceBuffer<Instance> instances;
         Graphics::Mesh<Vertex> cube;
 
         Vec<Math::Transform3D> transforms;
         Vec<Math::fColor3> colors;
 
+        // only the cubes left after culling get an instance
+        Graphics::SceneBVH bvh;
+        Graphics::OcclusionBuffer occlusion;
+        Vec<Graphics::SceneBVH::Handle> cubeHandles;
+        Vec<u32> visibleCubes;
+        Math::fRect3D cubeBounds;
+        bool frustumCull = true, occlusionCull = true;
+        usize culledCubes = 0;
+        u32 occludedBoxes = 0;
+
         float lightYaw = -0.346f, lightPitch = 0.088f, ambStrength = 0.2f;
 
         Graphics::CameraController camera;
@@ -26,5 +45,6 @@ namespace Test {
         void OnDestroy(Graphics::GraphicsDevice& gdevice) override;
 
         void RandomizeRotations(Graphics::GraphicsDevice& gdevice);
+        void CullCubes(const Math::Matrix3D& viewProj);
     };
 } // Test
@@ -10,20 +10,7 @@
 namespace Test {
     void TestGeometryShader::OnInit(Graphics::GraphicsDevice& gdevice) {
         scene = gdevice.CreateNewRender<Vertex>(2048, 1024);
-
-        sphere = Graphics::MeshUtils::Sphere({ 20 }, QGLCreateBlueprint$(Vertex, (
-            in (Position, Normal),
-            out (Position) = Position;,
-            out (Color)    = Math::fColor::BETTER_AQUA();,
-            out (Normal)   = Normal;,
-        )), Math::Transform3D::Scaling(10.0f));
-
-        icosphere = Graphics::MeshUtils::Icosphere({ 2 }, QGLCreateBlueprint$(Vertex, (
-            in (Position, Normal),
-            out (Position) = Position;,
-            out (Color)    = Math::fColor::BETTER_RED();,
-            out (Normal)   = Normal;,
-        )), Math::Transform3D::Scaling(10.0f));
+        CreateMeshes();
 
         scene.UseShaderFromFile(res("shader.vert"), res("shader.frag"));
         scene.SetProjection(Math::Matrix3D::perspective_fov(90.0f, gdevice.GetAspectRatio(), 0.01f, 100.0f));
@@ -44,6 +31,30 @@ namespace Test {
         lightPitch = 0.5f;
     }
 
+    void TestGeometryShader::CreateMeshes() {
+        sphere = Graphics::MeshUtils::Sphere({ 20 }, QGLCreateBlueprint$(Vertex, (
+            in (Position, Normal),
+            out (Position) = Position;,
+            out (Color)    = Math::fColor::BETTER_AQUA();,
+            out (Normal)   = Normal;,
+        )), Math::Transform3D::Scaling(10.0f));
+
+        icosphere = Graphics::MeshUtils::Icosphere({ 2 }, QGLCreateBlueprint$(Vertex, (
+            in (Position, Normal),
+            out (Position) = Position;,
+            out (Color)    = Math::fColor::BETTER_RED();,
+            out (Normal)   = Normal;,
+        )), Math::Transform3D::Scaling(10.0f));
+
+        if (optimizeMeshes) {
+            sphereReport    = Graphics::MeshOptimizer::Optimize(sphere,    { .reduceOverdraw = true });
+            icosphereReport = Graphics::MeshOptimizer::Optimize(icosphere, { .reduceOverdraw = true });
+        } else {
+            sphereReport = {};
+            icosphereReport = {};
+        }
+    }
+
     void TestGeometryShader::OnUpdate(Graphics::GraphicsDevice& gdevice, float deltaTime) {
         camera.Update(gdevice, deltaTime);
     }
@@ -101,6 +112,15 @@ namespace Test {
             ImGui::EditScalar("Normal Length", normMag, 0.1f);
         }
 
+        ImGui::Separator();
+        if (ImGui::Checkbox("Optimize Meshes", &optimizeMeshes)) CreateMeshes();
+        if (optimizeMeshes) {
+            ImGui::Text("Sphere: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f",
+                        sphereReport.before.acmr, sphereReport.after.acmr, sphereReport.before.atvr, sphereReport.after.atvr);
+            ImGui::Text("Icosphere: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f",
+                        icosphereReport.before.acmr, icosphereReport.after.acmr, icosphereReport.before.atvr, icosphereReport.after.atvr);
+        }
+
         ImGui::EditCameraController("Camera", camera);
     }
 
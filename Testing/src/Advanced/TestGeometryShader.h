@@ -2,6 +2,7 @@
 #include "CameraController.h"
 #include "Mesh.h"
 #include "Test.h"
+#include "Meshes/MeshOptimizer.h"
 
 namespace Test {
     class TestGeometryShader : public Test {
@@ -17,9 +18,13 @@ namespace Test {
         Math::fColor normColor = Math::fColor::BETTER_WHITE();
         bool useGeomShader = true, useFlatShading = false;
         int displayFace = -1;
+        // reordering the triangles changes which ones 'Display Face' picks
+        bool optimizeMeshes = false;
+        Graphics::MeshOptimizer::Report sphereReport, icosphereReport;
 
         DEFINE_TEST_T(TestGeometryShader, ADVANCED);
     public:
+        void CreateMeshes();
 
         void OnInit(Graphics::GraphicsDevice& gdevice) override;
         void OnUpdate(Graphics::GraphicsDevice& gdevice, float deltaTime) override;
@@ -8,7 +8,6 @@
 
 namespace Test {
     void TestLightCasters::OnInit(Graphics::GraphicsDevice& gdevice) {
-        scene = gdevice.CreateNewRender<Vertex>();
         lightScene = gdevice.CreateNewRender<Graphics::VertexColor3D>();
 
         Graphics::OBJModelLoader mloader;
@@ -23,9 +22,26 @@ namespace Test {
                     [&] (const Graphics::OBJVertex& v) { return Vertex { v.Position, v.Normal, obj.materialIndex }; }
             ));
         }
+        meshLODs.Reserve(meshes.Length());
+        for (const Graphics::Mesh<Vertex>& mesh : meshes) meshLODs.Push(Graphics::MeshLOD<Vertex>::Build(mesh));
+
+        u32 vertexCount = 0, triangleCount = 0;
+        for (const Graphics::MeshLOD<Vertex>& lod : meshLODs) {
+            for (u32 i = 0; i < lod.LevelCount(); ++i) {
+                vertexCount   += lod.GetMesh(i).vertices.Length();
+                triangleCount += lod.GetMesh(i).indices.Length();
+            }
+        }
+        // meshLODs doesnt grow after this, so the levels stay where the handles expect them
+        scene = Graphics::StaticMeshes<Vertex>::New(gdevice, vertexCount, triangleCount);
+        levelHandles.Reserve(meshLODs.Length());
+        for (const Graphics::MeshLOD<Vertex>& lod : meshLODs) {
+            Vec<StaticHandle>& handles = levelHandles.Push({});
+            for (u32 i = 0; i < lod.LevelCount(); ++i) handles.Push(scene.Add(lod.GetMesh(i)));
+        }
 
-        scene.UseShaderFromFile(res("shader.vert"), res("shader.frag"));
-        scene.SetProjection(Math::Matrix3D::perspective_fov(90.0f, gdevice.GetAspectRatio(), 0.01f, 100.0f));
+        scene.GetRender().UseShaderFromFile(res("shader.vert"), res("shader.frag"));
+        scene.GetRender().SetProjection(Math::Matrix3D::perspective_fov(90.0f, gdevice.GetAspectRatio(), 0.01f, 100.0f));
 
         camera.position = { 8.746245, 16.436476, 7.217131 };
         camera.yaw = -5.5221653; camera.pitch = 1.1316143;
@@ -75,7 +91,7 @@ namespace Test {
     void TestLightCasters::OnRender(Graphics::GraphicsDevice& gdevice) {
         lightScene.SetProjection(camera.GetProjMat());
         lightScene.SetCamera(camera.GetViewMat());
-        lightScene.Draw(lightMeshes);
+        lightScene.Submit(lightMeshes);
 
         scene->shader.Bind();
         for (u32 i = 0; i < materials.Length(); ++i) {
@@ -86,9 +102,19 @@ namespace Test {
             UniformLight(std::format("lights[{}]", i), lights[i]);
         }
 
-        scene.SetProjection(camera.GetProjMat());
-        scene.SetCamera(camera.GetViewMat());
-        scene.Draw(meshes, Graphics::UseArgs({
+        scene.GetRender().SetProjection(camera.GetProjMat());
+        scene.GetRender().SetCamera(camera.GetViewMat());
+        drawnHandles.Clear();
+        drawnTriangles = 0;
+        const auto selector = Graphics::LODSelector::FromCamera(camera, (float)gdevice.GetWindowSize().y, lodPixelError);
+        for (u32 i = 0; i < meshLODs.Length(); ++i) {
+            const u32 level = useLODs ? meshLODs[i].SelectLevel(selector) : 0;
+            drawnHandles.Push(levelHandles[i][level]);
+            drawnTriangles += meshLODs[i].GetMesh(level).indices.Length();
+        }
+
+        // the levels share one buffer, so the queue draws them with a single multi draw
+        scene.Submit(drawnHandles, Graphics::UseArgs({
             { "ambientStrength",   ambientStrength },
             { "viewPosition",      camera.position },
             { "specularIntensity", specularStrength },
@@ -99,6 +125,10 @@ namespace Test {
         ImGui::EditScalar("Ambient Strength", ambientStrength, 0.01f);
         ImGui::EditScalar("Specular Strength", specularStrength, 0.01f);
 
+        ImGui::Checkbox("Use LODs", &useLODs);
+        if (useLODs) ImGui::EditScalar("Max Pixel Error", lodPixelError, 0.05f, Math::fRange { 0.1f, 32.0f });
+        ImGui::Text("Triangles Drawn: %zu", drawnTriangles);
+
         ImGui::EditCameraController("Camera", camera);
 
         if (ImGui::TreeNode("Lights")) {
@@ -1,6 +1,8 @@
 #pragma once
 #include "CameraController.h"
 #include "Light.h"
+#include "MeshLOD.h"
+#include "StaticMeshes.h"
 #include "Test.h"
 #include "ModelLoading/OBJModel.h"
 
@@ -18,9 +20,17 @@ namespace Test {
             QuasiDefineVertex$(Vertex, 3D, (Position, Graphics::PosTf)(Normal, Graphics::NormTf)(MaterialID));
         };
     private:
-        Graphics::RenderObject<Vertex> scene;
+        using StaticHandle = Graphics::StaticMeshes<Vertex>::Handle;
+        // every level of every mesh is uploaded once, a frame only picks which ones to draw
+        Graphics::StaticMeshes<Vertex> scene;
         Vec<Graphics::MTLMaterial> materials;
         Vec<Graphics::Mesh<Vertex>> meshes;
+        Vec<Graphics::MeshLOD<Vertex>> meshLODs;
+        Vec<Vec<StaticHandle>> levelHandles; // by mesh, then by level
+        Vec<StaticHandle> drawnHandles;
+        bool useLODs = true;
+        float lodPixelError = 1.0f;
+        usize drawnTriangles = 0;
         Vec<Graphics::Light> lights;
         static constexpr int MAX_LIGHTS = 8;
         Graphics::CameraController camera;
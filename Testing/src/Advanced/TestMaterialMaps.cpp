@@ -7,25 +7,31 @@
 
 namespace Test {
     void TestMaterialMaps::OnInit(Graphics::GraphicsDevice& gdevice) {
-        scene = gdevice.CreateNewRender<Graphics::VertexTextureNormal3D>();
         lightScene = gdevice.CreateNewRender<Graphics::VertexColor3D>(8, 12);
 
         Graphics::OBJModelLoader mloader;
         mloader.LoadFile(res("boxes.obj"));
 
         meshes = mloader.GetModel().RetrieveMeshes();
+        u32 vertexCount = 0, triangleCount = 0;
+        for (const auto& mesh : meshes) {
+            vertexCount   += mesh.vertices.Length();
+            triangleCount += mesh.indices.Length();
+        }
+        scene = Graphics::StaticMeshes<Graphics::VertexTextureNormal3D>::New(gdevice, vertexCount, triangleCount);
+        meshHandles.Reserve(meshes.Length());
+        for (const auto& mesh : meshes) meshHandles.Push(scene.Add(mesh));
 
         diffuseMap = Graphics::Texture::LoadPNG(res("diffuse.png"));
         specularMap = Graphics::Texture::LoadPNG(res("specular.png"));
         diffuseMap.Activate(0);
         specularMap.Activate(1);
 
-        scene.UseShaderFromFile(res("shader.vert"), res("shader.frag"));
-
-        scene->shader.Bind();
-        scene->shader.SetUniformTex("diffuseMap", diffuseMap);
-        scene->shader.SetUniformTex("specularMap", specularMap);
-        scene->shader.Unbind();
+        scene.GetRender().UseShaderFromFile(res("shader.vert"), res("shader.frag"));
+        SetupShader(scene->shader);
+        scene.GetRender().WatchShaderFiles(res("shader.vert"), res("shader.frag"));
+        gdevice.GetShaderReloader().OnReload(scene->shader, [this] (Graphics::Shader& shader) { SetupShader(shader); });
+        lighting = Graphics::UniformBlock<Lighting>::New(Graphics::UniformBindings::MATERIAL);
 
         lightSource = Graphics::MeshUtils::CubeNormless(QGLCreateBlueprint$(Graphics::VertexColor3D, (
             in (Position),
@@ -52,27 +58,32 @@ namespace Test {
         lightScene.SetProjection(camera.GetProjMat());
         lightScene.SetCamera(camera.GetViewMat());
 
-        lightSource.GeometryPass([&] (Graphics::VertexColor3D& v) { v.Color = lightColor.with_alpha(1); });
-        lightSource.SetTransform(Math::Transform3D::Translation(lightPos));
-        lightScene.Draw(lightSource);
-
-        scene.SetProjection(camera.GetProjMat());
-        scene.SetCamera(camera.GetViewMat());
-
-        scene.Draw(meshes, Graphics::UseArgs({
-            { "lightPosition",     lightPos },
-            { "lightColor",        lightColor },
-            { "ambientStrength",   ambientStrength },
-            { "viewPosition",      camera.position },
-            { "specularIntensity", specularStrength },
-        }));
+        lightSource.GeometryPass([&] (Graphics::VertexColor3D& v) { v.Color = lighting.Get().lightColor.with_alpha(1); });
+        lightSource.SetTransform(Math::Transform3D::Translation(lighting.Get().lightPosition));
+        // both go through the render queue, drawn together at the end of the frame
+        lightScene.Submit(lightSource);
+
+        scene.GetRender().SetProjection(camera.GetProjMat());
+        scene.GetRender().SetCamera(camera.GetViewMat());
+
+        // only reaches gl on the frames the light was edited
+        lighting.Upload();
+        lighting.Bind();
+        // every box reads the same buffers and textures, so the queue merges them into one draw
+        Graphics::DrawOptions options = Graphics::UseArgs({
+            { "viewPosition", camera.position },
+        });
+        options.texture = diffuseMap;
+        options.textureSlot = 0;
+        scene.Submit(meshHandles, options);
     }
 
     void TestMaterialMaps::OnImGuiRender(Graphics::GraphicsDevice& gdevice) {
-        ImGui::EditVector("Light Position", lightPos);
-        ImGui::EditColor("Light Color", lightColor);
-        ImGui::EditScalar("Ambient Strength", ambientStrength, 0.01f);
-        ImGui::EditScalar("Specular Strength", specularStrength, 0.01f);
+        Lighting& light = lighting.Mut();
+        ImGui::EditVector("Light Position", light.lightPosition);
+        ImGui::EditColor("Light Color", light.lightColor);
+        ImGui::EditScalar("Ambient Strength", light.ambientStrength, 0.01f);
+        ImGui::EditScalar("Specular Strength", light.specularIntensity, 0.01f);
 
         ImGui::EditCameraController("Camera", camera);
     }
@@ -81,4 +92,12 @@ namespace Test {
         scene.Destroy();
         lightScene.Destroy();
     }
+
+    void TestMaterialMaps::SetupShader(Graphics::Shader& shader) {
+        shader.Bind();
+        shader.SetUniformTex("diffuseMap", diffuseMap);
+        shader.SetUniformTex("specularMap", specularMap);
+        shader.Unbind();
+        shader.BindUniformBlock("Lighting", Graphics::UniformBindings::MATERIAL);
+    }
 }
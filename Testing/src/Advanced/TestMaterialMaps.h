@@ -1,22 +1,31 @@
 #pragma once
 #include "CameraController.h"
 #include "Mesh.h"
+#include "StaticMeshes.h"
 #include "Test.h"
 #include "Textures/Texture.h"
+#include "UniformBuffer.h"
 
 namespace Test {
     class TestMaterialMaps : public Test {
     private:
-        Graphics::RenderObject<Graphics::VertexTextureNormal3D> scene;
+        // the boxes never change, so they are uploaded once
+        Graphics::StaticMeshes<Graphics::VertexTextureNormal3D> scene;
         Graphics::RenderObject<Graphics::VertexColor3D> lightScene;
 
         Vec<Graphics::Mesh<Graphics::VertexTextureNormal3D>> meshes;
+        Vec<Graphics::StaticMeshes<Graphics::VertexTextureNormal3D>::Handle> meshHandles;
         Graphics::Mesh<Graphics::VertexColor3D> lightSource;
         Graphics::CameraController camera;
 
-        Math::fVector3 lightPos = { 0, 8, 2 };
-        Math::fColor3 lightColor = 1;
-        float ambientStrength = 0.03f, specularStrength = 1.2f;
+        struct Lighting {
+            Math::fVector3 lightPosition = { 0, 8, 2 };
+            Math::fColor3 lightColor = 1;
+            float ambientStrength = 0.03f, specularIntensity = 1.2f;
+
+            QuasiDefineUniformBlock$(Lighting, (lightPosition)(lightColor)(ambientStrength)(specularIntensity));
+        };
+        Graphics::UniformBlock<Lighting> lighting;
         Graphics::Texture diffuseMap, specularMap;
 
         DEFINE_TEST_T(TestMaterialMaps, ADVANCED)
@@ -28,5 +37,8 @@ namespace Test {
         void OnRender(Graphics::GraphicsDevice& gdevice) override;
         void OnImGuiRender(Graphics::GraphicsDevice& gdevice) override;
         void OnDestroy(Graphics::GraphicsDevice& gdevice) override;
+
+        // the samplers and the lighting block, again after every reload
+        void SetupShader(Graphics::Shader& shader);
     };
 };
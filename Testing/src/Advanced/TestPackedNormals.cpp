@@ -0,0 +1,90 @@
+#include "TestPackedNormals.h"
+
+#include "imgui.h"
+#include "VertexBlueprint.h"
+#include "Extension/ImGuiExt.h"
+#include "Meshes/Sphere.h"
+#include "Utils/Text.h"
+
+namespace Test {
+    void TestPackedNormals::OnInit(Graphics::GraphicsDevice& gdevice) {
+        fullScene   = gdevice.CreateNewRender<FullVertex>();
+        packedScene = gdevice.CreateNewRender<PackedVertex>();
+
+        fullSphere = Graphics::MeshUtils::Sphere({ 32 }, QGLCreateBlueprint$(FullVertex, (
+            in (Position, Normal),
+            out (Position) = Position;,
+            out (Normal)   = Normal;,
+        )));
+        packedSphere = fullSphere.GeometryMap<PackedVertex>(
+            [] (Ref<const FullVertex> v) { return PackedVertex::From(*v); }
+        );
+
+        maxErrorDeg = 0;
+        for (usize i = 0; i < fullSphere.vertices.Length(); ++i) {
+            const Math::fVector3 exact = fullSphere.vertices[i].Normal.norm(),
+                                 packed = packedSphere.vertices[i].Normal.Unpack();
+            const float cos = std::clamp(exact.dot(packed), -1.0f, 1.0f);
+            maxErrorDeg = std::max(maxErrorDeg, std::acos(cos) * Math::RAD2DEG);
+        }
+
+        fullScene->shader   = LoadShader(FullVertex::VERTEX_LAYOUT);
+        packedScene->shader = LoadShader(PackedVertex::VERTEX_LAYOUT);
+
+        const Math::Matrix3D projection = Math::Matrix3D::perspective_fov(60.0f, gdevice.GetAspectRatio(), 0.1f, 100.0f),
+                             view = Math::Matrix3D::look_at({ 0, 0, 6 }, { 0, 0, 0 }, { 0, 1, 0 });
+        fullScene.SetProjection(projection);
+        fullScene.SetCamera(view);
+        packedScene.SetProjection(projection);
+        packedScene.SetCamera(view);
+    }
+
+    void TestPackedNormals::OnRender(Graphics::GraphicsDevice& gdevice) {
+        fullSphere  .SetTransform({ { -1.2f, 0, 0 }, 1, rotation });
+        packedSphere.SetTransform({ {  1.2f, 0, 0 }, 1, rotation });
+
+        const auto args = [&] {
+            return Graphics::UseArgs({
+                { "lightDirection",   Math::fVector3::from_spheric(1, lightYaw, lightPitch) },
+                { "color",            color },
+                { "ambientStrength",  ambStrength },
+                { "specularStrength", specStrength },
+            });
+        };
+        fullScene.Draw(fullSphere, args());
+        packedScene.Draw(packedSphere, args());
+    }
+
+    void TestPackedNormals::OnImGuiRender(Graphics::GraphicsDevice& gdevice) {
+        const usize vertexCount = fullSphere.vertices.Length();
+        ImGui::Text("Float Normals: %zu bytes per vertex, %zu bytes total",
+            sizeof(FullVertex), vertexCount * sizeof(FullVertex));
+        ImGui::Text("Octahedral Normals: %zu bytes per vertex, %zu bytes total",
+            sizeof(PackedVertex), vertexCount * sizeof(PackedVertex));
+        ImGui::Text("Largest Packing Error: %.4f degrees", maxErrorDeg);
+
+        ImGui::EditVector  ("Rotation", rotation);
+        ImGui::EditRotation("Light Rotation", lightYaw, lightPitch);
+        ImGui::EditColor   ("Color", color);
+        ImGui::EditScalar  ("Ambient", ambStrength, 0.01f, Math::fRange { 0.0f, 1.0f });
+        ImGui::EditScalar  ("Specular", specStrength, 0.01f, Math::fRange { 0.0f, 1.0f });
+    }
+
+    void TestPackedNormals::OnDestroy(Graphics::GraphicsDevice& gdevice) {
+        fullScene.Destroy();
+        packedScene.Destroy();
+    }
+
+    Graphics::Shader TestPackedNormals::LoadShader(const Graphics::VertexBufferLayout& layout) {
+        Option<String> vert = Text::ReadFile(res("shader.vert")), frag = Text::ReadFile(res("shader.frag"));
+        if (!vert || !frag) return {};
+
+        if (layout.HasFlags(Graphics::VertexBufferComponent::OCTAHEDRAL_FLAG)) {
+            // the define has to come after #version
+            const Str source = *vert;
+            const usize lineEnd = source.Find('\n').UnwrapOr(source.Length() - 1) + 1;
+            *vert = String { source.First(lineEnd) } + "#define OCTAHEDRAL_NORMAL\n"_str + source.Skip(lineEnd);
+        }
+        return Graphics::Shader::New(*vert, *frag);
+    }
+}
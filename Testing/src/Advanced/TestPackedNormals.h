@@ -0,0 +1,34 @@
+#pragma once
+#include "Mesh.h"
+#include "Test.h"
+
+namespace Test {
+    // the same sphere twice, on the left with float normals and on the right with octahedral
+    // ones (4 bytes instead of 12). both use one vertex shader, which unfolds the normal when
+    // the vertex layout says its packed
+    class TestPackedNormals : public Test {
+        using FullVertex   = Graphics::VertexNormal3D;
+        using PackedVertex = Graphics::VertexCompactNormal3D;
+
+        Graphics::RenderObject<FullVertex> fullScene;
+        Graphics::RenderObject<PackedVertex> packedScene;
+        Graphics::Mesh<FullVertex> fullSphere;
+        Graphics::Mesh<PackedVertex> packedSphere;
+
+        Math::fColor3 color = Math::fColor3::BETTER_AQUA();
+        float lightYaw = 0.6f, lightPitch = 0.5f, ambStrength = 0.1f, specStrength = 0.6f;
+        Math::fVector3 rotation = 0;
+        float maxErrorDeg = 0;
+
+        DEFINE_TEST_T(TestPackedNormals, ADVANCED);
+    public:
+        void OnInit(Graphics::GraphicsDevice& gdevice) override;
+        void OnUpdate(Graphics::GraphicsDevice& gdevice, float deltaTime) override {}
+        void OnRender(Graphics::GraphicsDevice& gdevice) override;
+        void OnImGuiRender(Graphics::GraphicsDevice& gdevice) override;
+        void OnDestroy(Graphics::GraphicsDevice& gdevice) override;
+
+        // OCTAHEDRAL_NORMAL is defined for layouts with octahedral components
+        static Graphics::Shader LoadShader(const Graphics::VertexBufferLayout& layout);
+    };
+} // Test
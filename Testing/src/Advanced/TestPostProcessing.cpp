@@ -16,7 +16,7 @@ namespace Test {
 
         constexpr float s = 0.3f;
         for (int i = 0; i < 8; ++i) {
-            cubes.Push(Graphics::MeshUtils::CubeNormless(QGLCreateBlueprint$(Graphics::VertexColor3D, (
+            cubes.Push(Graphics::MeshUtils::CubeNormlessCreator::CreateCached({}, QGLCreateBlueprint$(Graphics::VertexColor3D, (
                 in (Position),
                 out (Position) = Position;,
                 out (Color) = Math::fColor::color_id(i);
@@ -34,26 +34,6 @@ namespace Test {
         scene.UseShader(Graphics::Shader::StdColored);
         scene.SetProjection(Math::Matrix3D::perspective_fov(90.0f, gdevice.GetAspectRatio(), 0.01f, 100.0f));
 
-        const auto [winX, winY] = gdevice.GetWindowSize();
-        fbo = Graphics::FrameBuffer::New();
-        fbo.Bind();
-
-        renderResult = Graphics::Texture::New(
-            nullptr, { winX, winY },
-            { .load = { .format = Graphics::TextureFormat::RGB, .internalformat = Graphics::TextureIFormat::RGB_8 } }
-        );
-
-        fbo.Attach(renderResult);
-
-        depthStencilAttachment = Graphics::RenderBuffer::New(
-            Graphics::TextureIFormat::DEPTH_24_STENCIL_8, gdevice.GetWindowSize()
-        );
-
-        fbo.Bind();
-        fbo.Attach(depthStencilAttachment, Graphics::AttachmentType::DEPTH_STENCIL);
-        fbo.Complete();
-        fbo.Unbind();
-
         screenQuad = Graphics::MeshUtils::Quad(QGLCreateBlueprint$(Graphics::VertexTexture2D, (
             in (Position),
             out (Position) = Position;,
@@ -70,7 +50,6 @@ namespace Test {
         shaderOutline = Graphics::Shader::FromFile(res("outline.vert"), res("outline.frag"));
 
         currShader = &postProcessingQuad->shader;
-        renderResult.Activate(0);
     }
 
     void TestPostProcessing::OnUpdate(Graphics::GraphicsDevice& gdevice, float deltaTime) {
@@ -78,20 +57,26 @@ namespace Test {
     }
 
     void TestPostProcessing::OnRender(Graphics::GraphicsDevice& gdevice) {
+        using Graphics::FrameGraph;
         scene.SetCamera(transform.TransformMatrix());
 
-        if (currShader != &shaderOutline) {
-            Graphics::Render::EnableDepth();
-            if (usePostProcessing) {
-                fbo.Bind();
-                Graphics::Render::Clear();
-            }
-        }
-
-        scene.Draw(cubes);
-
-        if (usePostProcessing) {
-            if (currShader == &shaderOutline) {
+        const bool outline = currShader == &shaderOutline, postProcess = usePostProcessing && !outline;
+        frameGraph.Reset();
+        const FrameGraph::Resource screen = frameGraph.Backbuffer();
+        const Graphics::RenderTargetDesc colorDesc = { .format = Graphics::TextureIFormat::RGB_8 };
+        const FrameGraph::Resource sceneColor = frameGraph.CreateRelative("Scene Color", colorDesc),
+                                   sceneDepth = frameGraph.CreateRelative("Scene Depth", {
+                                       .format = Graphics::TextureIFormat::DEPTH_24_STENCIL_8, .sampled = false
+                                   });
+
+        frameGraph.AddPass("Scene", [&] (FrameGraph::PassContext&) {
+            if (!outline) Graphics::Render::EnableDepth();
+            if (postProcess) Graphics::Render::Clear();
+            scene.Draw(cubes);
+        }).Write(postProcess ? sceneColor : screen).WriteDepth(postProcess ? sceneDepth : screen);
+
+        if (usePostProcessing && outline) {
+            frameGraph.AddPass("Outline", [&] (FrameGraph::PassContext&) {
                 Graphics::Render::UseStencilTest(Graphics::CmpOperation::NOTEQUAL, 1); // pass if it hasnt been set (drawn to) yet
                 Graphics::Render::DisableDepth();
                 Graphics::Render::DisableStencilWrite();
@@ -103,30 +88,49 @@ namespace Test {
                 Graphics::Render::UseStencilTest(Graphics::CmpOperation::ALWAYS, 1);
                 Graphics::Render::EnableStencilWrite(); // write to stencil
                 Graphics::Render::EnableDepth();
-                return;
-            }
+            }).Write(screen);
+        }
 
-            Graphics::Render::DisableDepth();
-            fbo.Unbind();
-
-            // Graphics::Render::SetClearColor(1);
-            Graphics::Render::ClearColorBit();
-
-            currShader->Bind();
-            currShader->SetUniformTex("screenTexture", renderResult);
-            if (currShader == &shaderBlur) {
-                currShader->SetUniformFvec2("blurOff", effectOff);
-            } else if (currShader == &shaderEdgeDetect) {
-                currShader->SetUniformFvec2("detectOff", effectOff);
-            } else if (currShader == &shaderHsv) {
-                currShader->SetUniformFloat("dh", hueShift);
-                currShader->SetUniformFloat("ds", satMul);
-                currShader->SetUniformFloat("dv", valShift);
-            }
+        // the chain is always there, without post processing nothing reads it and it gets culled.
+        // each blur only needs the one before, so the pool ends up with two targets however long it is
+        FrameGraph::Resource last = sceneColor;
+        const int blurs = currShader == &shaderBlur ? blurPasses : 1;
+        for (int i = 1; i < blurs; ++i) {
+            const FrameGraph::Resource blurred = frameGraph.CreateRelative("Blurred", colorDesc);
+            frameGraph.AddPass("Blur", [&, last] (FrameGraph::PassContext& ctx) {
+                DrawEffect(ctx.GetTexture(last));
+            }).Read(last).Write(blurred);
+            last = blurred;
+        }
+
+        if (postProcess) {
+            frameGraph.AddPass("Post Processing", [&, last] (FrameGraph::PassContext& ctx) {
+                // Graphics::Render::SetClearColor(1);
+                Graphics::Render::ClearColorBit();
+                DrawEffect(ctx.GetTexture(last));
+            }).Read(last).Write(screen);
+        }
+
+        frameGraph.Execute(renderTargets, gdevice.GetWindowSize().as<u32>());
+    }
 
-            // Graphics::Render::Draw(postProcessingQuad.GetRenderData(), *currShader);
-            postProcessingQuad.Draw(screenQuad, UseShader(*currShader, false));
+    void TestPostProcessing::DrawEffect(Graphics::Texture& screen) {
+        Graphics::Render::DisableDepth();
+
+        currShader->Bind();
+        currShader->SetUniformTex("screenTexture", screen);
+        if (currShader == &shaderBlur) {
+            currShader->SetUniformFvec2("blurOff", effectOff);
+        } else if (currShader == &shaderEdgeDetect) {
+            currShader->SetUniformFvec2("detectOff", effectOff);
+        } else if (currShader == &shaderHsv) {
+            currShader->SetUniformFloat("dh", hueShift);
+            currShader->SetUniformFloat("ds", satMul);
+            currShader->SetUniformFloat("dv", valShift);
         }
+
+        // Graphics::Render::Draw(postProcessingQuad.GetRenderData(), *currShader);
+        postProcessingQuad.Draw(screenQuad, UseShader(*currShader, false));
     }
 
     void TestPostProcessing::OnImGuiRender(Graphics::GraphicsDevice& gdevice) {
@@ -147,7 +151,9 @@ namespace Test {
                 ImGui::EditScalar("Hue Shift", hueShift, 0.01f, Math::fRange { 0, 1 });
                 ImGui::EditScalar("Saturation Multiplier", satMul, 0.01f, Math::fRange { 0, 10 });
                 ImGui::EditScalar("Value Shift", valShift, 0.01f, Math::fRange { -1, 1 });)
-            TAB_ITEM(BLUR, "Blur", shaderBlur, ImGui::EditVector("Blur Offset", effectOff, 0.1f); )
+            TAB_ITEM(BLUR, "Blur", shaderBlur,
+                ImGui::EditVector("Blur Offset", effectOff, 0.1f);
+                ImGui::SliderInt("Blur Passes", &blurPasses, 1, 8);)
             TAB_ITEM(EDGE_DETECT, "Edge Detection", shaderEdgeDetect, ImGui::EditVector("Detect Offset", effectOff, 0.1f); )
             TAB_ITEM(OUTLINE, "Outline (Stencil)", shaderOutline,
                 ImGui::EditScalar("Outline Size", outlineSize, 0.01f, Math::fRange { 1, 2 });
@@ -156,6 +162,11 @@ namespace Test {
         }
 #undef TAB_ITEM
 
+        const Graphics::FrameGraph::Stats& graphStats = frameGraph.GetStats();
+        ImGui::Text("Passes: %u (%u culled)", graphStats.passes, graphStats.culled);
+        ImGui::Text("Render Targets: %u for %u transients, %.2f MB",
+            renderTargets.TargetCount(), graphStats.transients, (float)renderTargets.ByteSize() / (1024.0f * 1024.0f));
+
         if (prev != currShader) {
             if (currShader == &shaderOutline) {
                 Graphics::Render::EnableStencil();
@@ -174,6 +185,7 @@ namespace Test {
 
     void TestPostProcessing::OnDestroy(Graphics::GraphicsDevice& gdevice) {
         scene.Destroy();
+        renderTargets.Clear();
         Graphics::Render::EnableDepth();
         Graphics::Render::DisableStencil();
     }
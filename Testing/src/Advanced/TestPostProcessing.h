@@ -1,9 +1,7 @@
 #pragma once
-#include "FrameBuffer.h"
+#include "FrameGraph.h"
 #include "Mesh.h"
-#include "RenderBuffer.h"
 #include "Test.h"
-#include "Textures/Texture.h"
 
 namespace Test {
     // all from https://learnopengl.com/Advanced-OpenGL/Framebuffers & https://learnopengl.com/Guest-Articles/2022/Phys.-Based-Bloom
@@ -12,9 +10,8 @@ namespace Test {
         Graphics::RenderObject<Graphics::VertexColor3D> scene;
         Graphics::RenderObject<Graphics::VertexTexture2D> postProcessingQuad;
 
-        Graphics::FrameBuffer fbo;
-        Graphics::Texture renderResult;
-        Graphics::RenderBuffer depthStencilAttachment;
+        Graphics::RenderTargetPool renderTargets;
+        Graphics::FrameGraph frameGraph;
 
         Vec<Graphics::Mesh<Graphics::VertexColor3D>> cubes;
         Graphics::Mesh<Graphics::VertexTexture2D> screenQuad;
@@ -25,6 +22,7 @@ namespace Test {
         Math::fVector2 effectOff = 3;
         float hueShift = 0, satMul = 0, valShift = 0;
         float outlineSize = 1.1f;
+        int blurPasses = 1;
 
         Graphics::Shader shaderInv, shaderHsv, shaderBlur, shaderEdgeDetect, shaderOutline, *currShader;
 
@@ -39,5 +37,7 @@ namespace Test {
         void OnRender(Graphics::GraphicsDevice& gdevice) override;
         void OnImGuiRender(Graphics::GraphicsDevice& gdevice) override;
         void OnDestroy(Graphics::GraphicsDevice& gdevice) override;
+
+        void DrawEffect(Graphics::Texture& screen);
     };
 }
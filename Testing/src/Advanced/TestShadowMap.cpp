@@ -30,26 +30,6 @@ namespace Test {
         depthShader = Graphics::Shader::FromFile(res("depth.vert"), res("depth.frag"));
         scene.UseShaderFromFile(res("shadow.vert"), res("shadow.frag"));
 
-        depthMap = Graphics::FrameBuffer::New();
-        depthTex = Graphics::Texture::New(
-            nullptr, gdevice.GetWindowSize().as<u32>(), {
-                .load = {
-                    .format = Graphics::TextureFormat::DEPTH,
-                    .internalformat = Graphics::TextureIFormat::DEPTH_16,
-                    .type = Graphics::GLTypeID::FLOAT
-                },
-                .params = {
-                    { Graphics::TextureParamName::XT_WRAPPING, Graphics::TextureBorder::CLAMP_TO_BORDER },
-                    { Graphics::TextureParamName::BORDER_COLOR, Math::fVector4::ONE().cbegin() }
-                }
-            }
-        );
-        depthMap.Bind();
-        depthMap.Attach(depthTex, Graphics::AttachmentType::DEPTH);
-        Graphics::Render::SetColorWrite(Graphics::BufferMode::NONE);
-        depthMap.Complete();
-        depthMap.Unbind();
-
         shadowMapDisplay = gdevice.CreateNewRender<Graphics::VertexTexture2D>(4, 2);
         shadowMapDisplay.UseShaderFromFile(res("display.vert"), res("display.frag"));
 
@@ -58,7 +38,6 @@ namespace Test {
             out (Position) = Position;,
             out (TextureCoordinate) = (Position + 1) * 0.5f;
         )));
-        depthTex.Activate(0);
 
         Graphics::Render::EnableCullFace();
         Graphics::Render::SetFrontFacing(Graphics::OrientationMode::CLOCKWISE);
@@ -78,41 +57,53 @@ namespace Test {
     }
 
     void TestShadowMap::OnRender(Graphics::GraphicsDevice& gdevice) {
+        using Graphics::FrameGraph;
         const Math::Matrix3D lightProj = Math::Matrix3D::perspective_fov(90.0f, gdevice.GetAspectRatio(), clipDistance.min, clipDistance.max),
                            lightView = Math::Matrix3D::look_at(lightPosition, 0, Math::fVector3::UP());
 
-        {
+        frameGraph.Reset();
+        const FrameGraph::Resource depthMap = frameGraph.CreateRelative("Shadow Map", {
+            .format = Graphics::TextureIFormat::DEPTH_16,
+            .border = Graphics::TextureBorder::CLAMP_TO_BORDER,
+            .borderColor = Math::fVector4::ONE(),
+        });
+
+        frameGraph.AddPass("Shadow Depth", [&] (FrameGraph::PassContext&) {
             Graphics::Render::SetCullFace(Graphics::FacingMode::FRONT);
-            depthMap.Bind();
             Graphics::Render::ClearDepthBit();
             scene.SetProjection(lightProj);
             scene.SetCamera(lightView);
 
             scene.Draw(meshes, UseShader(depthShader));
-            depthMap.Unbind();
-        }
-        Graphics::Render::SetCullFace(Graphics::FacingMode::BACK);
-        Graphics::Render::ClearColorBit();
-        Graphics::Render::ClearDepthBit();
-        if (showDepthMap) {
-            shadowMapDisplay.Draw(screenQuad, Graphics::UseArgs({
-                { "displayTex", depthTex },
-                { "near", clipDistance.min.value() },
-                { "far", clipDistance.max.value() }
-            }, false));
-        } else {
-            scene.SetProjection(camera.GetProjMat());
-            scene.SetCamera(camera.GetViewMat());
-
-            scene.Draw(meshes, Graphics::UseArgs({
-                { "lightSpaceMat", lightProj * lightView },
-                { "depthMap", depthTex },
-                { "lightPos", lightPosition },
-                { "viewPos", camera.position },
-                { "ambStrength", ambStrength },
-                { "useSmoothShadows", useSmoothShadows }
-            }));
-        }
+        }).WriteDepth(depthMap);
+
+        frameGraph.AddPass(showDepthMap ? "Display Depth" : "Scene", [&] (FrameGraph::PassContext& ctx) {
+            Graphics::Texture& depthTex = ctx.GetTexture(depthMap);
+            Graphics::Render::SetCullFace(Graphics::FacingMode::BACK);
+            Graphics::Render::ClearColorBit();
+            Graphics::Render::ClearDepthBit();
+            if (showDepthMap) {
+                shadowMapDisplay.Draw(screenQuad, Graphics::UseArgs({
+                    { "displayTex", depthTex },
+                    { "near", clipDistance.min.value() },
+                    { "far", clipDistance.max.value() }
+                }, false));
+            } else {
+                scene.SetProjection(camera.GetProjMat());
+                scene.SetCamera(camera.GetViewMat());
+
+                scene.Draw(meshes, Graphics::UseArgs({
+                    { "lightSpaceMat", lightProj * lightView },
+                    { "depthMap", depthTex },
+                    { "lightPos", lightPosition },
+                    { "viewPos", camera.position },
+                    { "ambStrength", ambStrength },
+                    { "useSmoothShadows", useSmoothShadows }
+                }));
+            }
+        }).Read(depthMap).Write(frameGraph.Backbuffer());
+
+        frameGraph.Execute(renderTargets, gdevice.GetWindowSize().as<u32>());
     }
 
     void TestShadowMap::OnImGuiRender(Graphics::GraphicsDevice& gdevice) {
@@ -128,6 +119,7 @@ namespace Test {
     void TestShadowMap::OnDestroy(Graphics::GraphicsDevice& gdevice) {
         scene.Destroy();
         shadowMapDisplay.Destroy();
+        renderTargets.Clear();
         Graphics::Render::DisableCullFace();
     }
 } // Test
\ No newline at end of file
@@ -1,17 +1,16 @@
 #pragma once
 #include "CameraController.h"
-#include "FrameBuffer.h"
+#include "FrameGraph.h"
 #include "Mesh.h"
 #include "Test.h"
-#include "Textures/Texture.h"
 
 namespace Test {
     class TestShadowMap : public Test {
         using Vertex = Graphics::VertexColorNormal3D;
         Graphics::RenderObject<Vertex> scene;
         Vec<Graphics::Mesh<Vertex>> meshes;
-        Graphics::FrameBuffer depthMap;
-        Graphics::Texture depthTex;
+        Graphics::RenderTargetPool renderTargets;
+        Graphics::FrameGraph frameGraph;
         Graphics::Shader depthShader;
 
         Graphics::RenderObject<Graphics::VertexTexture2D> shadowMapDisplay;
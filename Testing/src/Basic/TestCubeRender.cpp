@@ -1,12 +1,13 @@
 ﻿#include "TestCubeRender.h"
 
+#include "imgui.h"
 #include "VertexBlueprint.h"
 #include "Extension/ImGuiExt.h"
 #include "Meshes/Cube.h"
 
 namespace Test {
     void TestCubeRender::OnInit(Graphics::GraphicsDevice& gdevice) {
-        render = gdevice.CreateNewRender<Graphics::VertexColor3D>(4 * 6, 12);
+        render = gdevice.CreateNewRender<Graphics::VertexColor3D>(4 * 6 * (ARM_LENGTH + 1), 12 * (ARM_LENGTH + 1));
 
         using namespace Math;
 
@@ -18,20 +19,57 @@ namespace Test {
             i++;
         )));
 
-        render.UseShaderFromFile(res("shader.vert"), res("shader.frag"));
+        root = graph.Add(cube.modelTransform);
+        Graphics::SceneGraph::Handle parent = root;
+        armCubes.Reserve(ARM_LENGTH);
+        arm.Reserve(ARM_LENGTH);
+        for (u32 a = 0; a < ARM_LENGTH; ++a) {
+            // on the corner of the one before, at 60% its size
+            parent = graph.Add(Math::Transform3D { { 1.6f, 1.6f, 0 }, 0.6f }, parent);
+            arm.Push(parent);
+            armCubes.Push(cube);
+        }
+
+        // edit the shader files while this runs, they are rebuilt in the background
+        render.WatchShaderFiles(res("shader.vert"), res("shader.frag"));
         render.SetProjection(projection);
     }
 
+    void TestCubeRender::OnUpdate(Graphics::GraphicsDevice& gdevice, float deltaTime) {
+        if (spinArm) {
+            for (u32 a = 0; a < arm.Length(); ++a)
+                graph.EditLocal(arm[a]).rotation.rotate_by(Math::Quaternion::rotate_z(spinSpeed * (float)(a + 1) * deltaTime));
+        }
+
+        graph.Update();
+        // only the cubes under something that moved get a new transform
+        if (graph.WasUpdated(root)) cube.SetTransform(graph.GetWorld(root));
+        for (u32 a = 0; a < arm.Length(); ++a)
+            if (graph.WasUpdated(arm[a])) armCubes[a].SetTransform(graph.GetWorld(arm[a]));
+    }
+
     void TestCubeRender::OnRender(Graphics::GraphicsDevice& gdevice) {
         render.Draw(cube, Graphics::UseArgs({{ "u_alpha", alpha }}));
+        render.Draw(armCubes, Graphics::UseArgs({{ "u_alpha", alpha }}));
     }
 
     void TestCubeRender::OnImGuiRender(Graphics::GraphicsDevice& gdevice) {
-        ImGui::EditTransform("Transform", cube.modelTransform, 0.01f);
+        Math::Transform3D rootLocal = graph.GetLocal(root);
+        ImGui::EditTransform("Transform", rootLocal, 0.01f);
+        // setting it marks the whole arm, so only when it was edited
+        const Math::Transform3D& before = graph.GetLocal(root);
+        if (!(rootLocal.position == before.position && rootLocal.scale == before.scale && rootLocal.rotation == before.rotation))
+            graph.SetLocal(root, rootLocal);
+
         ImGui::EditScalar("Transparency", alpha, 0.01f, Math::fRange { 0, 1 });
+        ImGui::Checkbox("Spin Arm", &spinArm);
+        ImGui::EditScalar("Spin Speed", spinSpeed, 0.01f);
     }
 
     void TestCubeRender::OnDestroy(Graphics::GraphicsDevice& gdevice) {
         render.Destroy();
+        graph.Clear();
+        arm.Clear();
+        armCubes.Clear();
     }
 }
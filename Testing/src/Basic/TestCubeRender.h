@@ -1,23 +1,33 @@
 ﻿#pragma once
 #include "Mesh.h"
+#include "SceneGraph.h"
 #include "Test.h"
 
 namespace Test {
+    // a cube with an arm of smaller cubes, each one parented to the one before through a scene graph
     class TestCubeRender : public Test {
     private:
+        static constexpr u32 ARM_LENGTH = 4;
+
         // unsigned int faceOrder[6] = { 0, 1, 2, 3, 4, 5 };
         Graphics::RenderObject<Graphics::VertexColor3D> render;
         Graphics::Mesh<Graphics::VertexColor3D> cube;
+        Vec<Graphics::Mesh<Graphics::VertexColor3D>> armCubes;
+
+        Graphics::SceneGraph graph;
+        Graphics::SceneGraph::Handle root;
+        Vec<Graphics::SceneGraph::Handle> arm;
 
         Math::Matrix3D projection = Math::Matrix3D::ortho_projection({ -5.0f, 5.0f, -5.0f, 5.0f, -5.0f, 5.0f });
-        float alpha = 1.0f;
+        float alpha = 1.0f, spinSpeed = 0.5f;
+        bool spinArm = true;
 
         DEFINE_TEST_T(TestCubeRender, BASIC)
     public:
         TestCubeRender() = default;
 
         void OnInit(Graphics::GraphicsDevice& gdevice) override;
-        void OnUpdate(Graphics::GraphicsDevice& gdevice, float deltaTime) override {}
+        void OnUpdate(Graphics::GraphicsDevice& gdevice, float deltaTime) override;
         void OnRender(Graphics::GraphicsDevice& gdevice) override;
         void OnImGuiRender(Graphics::GraphicsDevice& gdevice) override;
         void OnDestroy(Graphics::GraphicsDevice& gdevice) override;
@@ -9,6 +9,7 @@ namespace Test {
 
         render.UseShader(Graphics::Shader::StdColored);
         render.SetProjection(projection);
+        render->EnableStreaming();
 
         using namespace Math;
         Vec<Vertex> vertices = Vec<Vertex>::New({
@@ -36,6 +37,12 @@ namespace Test {
     }
 
     void TestDynamicVertexGeometry::OnImGuiRender(Graphics::GraphicsDevice& gdevice) {
+        if (ImGui::Checkbox("Stream Vertices", &streaming)) {
+            if (streaming) render->EnableStreaming();
+            else           render->DisableStreaming();
+        }
+        if (streaming) ImGui::Text("Stalls: %u, Grows: %u", render->StreamStalls(), render->StreamGrows());
+
         Vertex* vertices = mesh.vertices.Data();
         ImGui::EditVector("Red    Vertex [0]", vertices[0].Position);
         ImGui::EditVector("Green  Vertex [1]", vertices[1].Position);
@@ -8,6 +8,7 @@ namespace Test {
     private:
         Graphics::RenderObject<Vertex> render;
         Graphics::Mesh<Vertex> mesh;
+        bool streaming = true; // rewritten every frame, so written straight into mapped memory
 
         Math::Matrix3D projection = Math::Matrix3D::ortho_projection({ -320.0f, 320.0f, -240.0f, 240.0f, -1.0f, 1.0f });
 
@@ -0,0 +1,84 @@
+#include "TestSpriteBatch.h"
+
+#include "imgui.h"
+#include "Timer.h"
+#include "Extension/ImGuiExt.h"
+#include "Meshes/Quad.h"
+
+namespace Test {
+    void TestSpriteBatch::OnInit(Graphics::GraphicsDevice& gdevice) {
+        render = gdevice.CreateNewRender<Vertex>(DEFAULT_SPRITE_COUNT * 4, DEFAULT_SPRITE_COUNT * 2);
+
+        render.UseShader(Graphics::Shader::StdColored);
+        render.SetProjection(Math::Matrix3D::ortho_projection({ viewport.min.x, viewport.max.x, viewport.min.y, viewport.max.y, -1.0f, 1.0f }));
+
+        ResetSprites(gdevice);
+    }
+
+    void TestSpriteBatch::OnUpdate(Graphics::GraphicsDevice& gdevice, float deltaTime) {
+        if (!moving) return;
+        const Math::fVector2 size = viewport.size();
+        for (usize i = 0; i < sprites.Length(); ++i) {
+            auto& t = sprites[i].modelTransform;
+            t.position += motions[i].velocity * deltaTime;
+            t.rotation *= Math::fComplex::rotate(motions[i].spin * deltaTime);
+            // wraps around the edges, so the count on screen stays the same
+            if (t.position.x < viewport.min.x) t.position.x += size.x;
+            if (t.position.x > viewport.max.x) t.position.x -= size.x;
+            if (t.position.y < viewport.min.y) t.position.y += size.y;
+            if (t.position.y > viewport.max.y) t.position.y -= size.y;
+        }
+    }
+
+    void TestSpriteBatch::OnRender(Graphics::GraphicsDevice& gdevice) {
+        Debug::Timer timer { "SpriteBatch" };
+        render.BeginContext();
+        if (parallel) render.AddMeshes(sprites);
+        else for (const auto& sprite : sprites) render.AddMesh(sprite);
+        render.EndContext();
+        buildMs = (float)Debug::Timer::UnitConvert<Debug::Microsecond>(timer.Stop()) / 1000.0f;
+
+        render.DrawContext();
+    }
+
+    void TestSpriteBatch::OnImGuiRender(Graphics::GraphicsDevice& gdevice) {
+        frameMs = 1000.0f / ImGui::GetIO().Framerate;
+        ImGui::Text("Sprites: %zu (%zu vertices)", sprites.Length(), sprites.Length() * 4);
+        ImGui::Text("Batch Build: %.2fms (%.1fns per sprite)", buildMs,
+            sprites.Length() ? buildMs * 1e6f / (float)sprites.Length() : 0.0f);
+        ImGui::Text("Frame: %.2fms", frameMs);
+
+        ImGui::Checkbox("Build on Worker Pool", &parallel);
+        ImGui::Checkbox("Move Sprites", &moving);
+        ImGui::SliderInt("Count", &spriteCount, 1000, MAX_SPRITE_COUNT);
+        if (ImGui::Button("Reset Sprites")) ResetSprites(gdevice);
+    }
+
+    void TestSpriteBatch::OnDestroy(Graphics::GraphicsDevice& gdevice) {
+        render.Destroy();
+    }
+
+    void TestSpriteBatch::ResetSprites(Graphics::GraphicsDevice& gdevice) {
+        auto& rand = gdevice.GetRand();
+
+        sprites.Clear();
+        motions.Clear();
+        sprites.Reserve(spriteCount);
+        motions.Reserve(spriteCount);
+        // every sprite is the same quad, so its made once and only copied and tinted
+        const Graphics::Mesh<Vertex>& unitQuad = Graphics::MeshUtils::QuadCreator::Shared({}, [] (const auto& m) {
+            return Vertex { .Position = m.Position * 2, .Color = Math::fColor::BETTER_WHITE() };
+        });
+        for (int i = 0; i < spriteCount; ++i) {
+            const Math::fColor color = Math::fColor::from_hsv(rand.Get(0.0f, 360.0f), 0.8f, 1.0f);
+            Graphics::Mesh<Vertex>& sprite = sprites.Push(unitQuad);
+            for (Vertex& v : sprite.vertices) v.Color = color;
+            sprite.modelTransform.position = Math::fVector2::random(rand, viewport);
+            sprite.modelTransform.RotationAngle() = rand.Get(0.0f, Math::TAU);
+            motions.Push({
+                .velocity = Math::fVector2::random(rand, { -40, 40, -40, 40 }),
+                .spin = rand.Get(-2.0f, 2.0f),
+            });
+        }
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Test.h"
+#include "Mesh.h"
+
+namespace Test {
+    // tens of thousands of separate quad meshes moved every frame and batched into one draw,
+    // to see how long building the batch takes with and without the worker pool
+    class TestSpriteBatch : public Test {
+    private:
+        static constexpr u32 DEFAULT_SPRITE_COUNT = 50'000, MAX_SPRITE_COUNT = 200'000;
+
+        using Vertex = Graphics::VertexColor2D;
+        struct Motion {
+            Math::fVector2 velocity;
+            float spin;
+        };
+
+        Graphics::RenderObject<Vertex> render;
+        Vec<Graphics::Mesh<Vertex>> sprites;
+        Vec<Motion> motions;
+
+        Math::fRect2D viewport = { -320.0f, 320.0f, -240.0f, 240.0f };
+        int spriteCount = DEFAULT_SPRITE_COUNT;
+        bool parallel = true, moving = true;
+        float buildMs = 0, frameMs = 0;
+
+        DEFINE_TEST_T(TestSpriteBatch, BASIC)
+    public:
+        TestSpriteBatch() = default;
+
+        void OnInit(Graphics::GraphicsDevice& gdevice) override;
+        void OnUpdate(Graphics::GraphicsDevice& gdevice, float deltaTime) override;
+        void OnRender(Graphics::GraphicsDevice& gdevice) override;
+        void OnImGuiRender(Graphics::GraphicsDevice& gdevice) override;
+        void OnDestroy(Graphics::GraphicsDevice& gdevice) override;
+
+        void ResetSprites(Graphics::GraphicsDevice& gdevice);
+    };
+}
@@ -40,6 +40,11 @@ namespace Test {
             Graphics::MeshUtils::Quad(blueprint, Math::Transform2D { { 0, -240 }, { 320, 20 } })
         }));
 
+        statics = Graphics::StaticMeshes<Vertex>::New(gdevice, 64, 64);
+        statics.GetRender().UseShaderFromFile(res("static.vert"), res("shader.frag"));
+        statics.GetRender().SetProjection(render->projection);
+        statics.Add(mBg);
+
         time = gdevice.GetIO().Time.currentTime;
         nextSpawnTime = 0;
         Graphics::Render::SetClearColor(Math::fColor::BETTER_BLACK());
@@ -72,8 +77,10 @@ namespace Test {
                 return { v.Position, v.Color, v.TextureCoord, 1 };
         });
 
+        statics.DrawAll();
+
         render.BeginContext();
-        render.AddMeshes({ &mPlayer, &mBg, &mText });
+        render.AddMeshes({ &mPlayer, &mText });
         render.AddMeshes(spikes.Iter().Map(Operators::Member<&Spike::mesh> {}));
         render.EndContext();
         render.DrawContext();
@@ -85,6 +92,7 @@ namespace Test {
 
     void DemoFlappyBird::OnDestroy(Graphics::GraphicsDevice& gdevice) {
         render.Destroy();
+        statics.Destroy();
         Graphics::Render::SetClearColor(0);
     }
 
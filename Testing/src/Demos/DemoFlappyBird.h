@@ -3,6 +3,7 @@
 
 #include "Geometry.h"
 #include "Mesh.h"
+#include "StaticMeshes.h"
 #include "Test.h"
 #include "Fonts/Font.h"
 
@@ -24,6 +25,7 @@ namespace Test {
         };
 
         Graphics::RenderObject<Vertex> render;
+        Graphics::StaticMeshes<Vertex> statics; // the background never changes, so it is uploaded once
         Graphics::Font font;
         Graphics::Mesh<Vertex> mPlayer, mText, mBg;
         Vec<Spike> spikes;
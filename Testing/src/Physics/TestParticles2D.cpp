@@ -0,0 +1,110 @@
+#include "TestParticles2D.h"
+
+#include <imgui.h>
+
+#include "Timer.h"
+#include "VertexBlueprint.h"
+#include "Extension/ImGuiExt.h"
+#include "Meshes/Circle.h"
+#include "Meshes/Quad.h"
+
+namespace Test {
+    void TestParticles2D::OnInit(Graphics::GraphicsDevice& gdevice) {
+        scene = gdevice.CreateNewRender<Vertex>();
+        instances = Graphics::InstanceBuffer<Instance>::New(scene.GetRenderData(), DEFAULT_PARTICLE_COUNT);
+        viewport = { 0, 80, 0, 60 };
+
+        quad = Graphics::MeshUtils::Quad(QGLCreateBlueprint$(Vertex, (
+            in (Position),
+            out (Position) = Position;
+        )));
+        circleMesh = Graphics::MeshUtils::Circle({ 32 }, QGLCreateBlueprint$(Vertex, (
+            in (Position),
+            out (Position) = Position;
+        )));
+
+        scene.UseShaderFromFile(res("particle.vert"), res("particle.frag"));
+        obstacleShader = Graphics::Shader::FromFile(res("obstacle.vert"), res("obstacle.frag"));
+
+        scene.SetProjection(Math::Matrix3D::ortho_projection({ 0, 80, 0, 60, -1, 1 }));
+
+        ResetParticles(gdevice);
+    }
+
+    void TestParticles2D::OnUpdate(Graphics::GraphicsDevice& gdevice, float deltaTime) {
+        Debug::Timer timer { "ParticleUpdate" };
+        particles.Update(std::min(deltaTime, 1 / 30.0f), simUpdates);
+        updateMs = (float)Debug::Timer::UnitConvert<Debug::Microsecond>(timer.Stop()) / 1000.0f;
+    }
+
+    void TestParticles2D::OnRender(Graphics::GraphicsDevice& gdevice) {
+        const u32 count = (u32)particles.Count();
+        Span<Instance> data = instances.Map(count);
+        for (u32 i = 0; i < count; ++i) {
+            data[i] = {
+                .Offset = particles.PositionOf(i),
+                .Scale  = particles.radius[i],
+                .Speed  = particles.VelocityOf(i).len(),
+            };
+        }
+        instances.Unmap();
+
+        scene.DrawInstanced(quad, (int)count, Graphics::UseArgs({
+            { "u_projection", scene->projection },
+        }, false));
+
+        for (const auto& body : world.bodies) {
+            if (!body.shape.Is<Physics2D::CircleShape>()) continue;
+            scene.Draw(circleMesh, UseShaderWithArgs(obstacleShader, {
+                { "u_projection", scene->projection },
+                { "offset",       body.position },
+                { "scale",        body.shape.As<Physics2D::CircleShape>()->radius },
+            }, false));
+        }
+    }
+
+    void TestParticles2D::OnImGuiRender(Graphics::GraphicsDevice& gdevice) {
+        ImGui::Text("Particles: %zu", particles.Count());
+        ImGui::Text("Update: %.2fms (%.1fns per particle)", updateMs,
+            particles.Count() ? updateMs * 1e6f / (float)particles.Count() : 0.0f);
+
+        ImGui::SliderInt("Count", &particleCount, 1000, 200'000);
+        ImGui::EditScalar("Radius", particleRadius, 0.01f, Math::fRange { 0.02f, 0.5f });
+        ImGui::SliderInt("Sim Updates", &simUpdates, 1, 8);
+        ImGui::Checkbox("Collide Particles", &particles.collideParticles);
+        ImGui::EditVector("Gravity", world.gravity);
+        if (ImGui::Button("Reset Particles")) ResetParticles(gdevice);
+    }
+
+    void TestParticles2D::OnDestroy(Graphics::GraphicsDevice& gdevice) {
+        scene.Destroy();
+    }
+
+    void TestParticles2D::ResetParticles(Graphics::GraphicsDevice& gdevice) {
+        using namespace Physics2D;
+        auto& rand = gdevice.GetRand();
+
+        world = { { 0, -20.0f } };
+        world.CreateBody<RectShape>({ .position = {                0, +viewport.height() * 0.5f }, .type = BodyType::STATIC }, 1.0f, viewport.height() * 0.5f);
+        world.CreateBody<RectShape>({ .position = { viewport.width(), +viewport.height() * 0.5f }, .type = BodyType::STATIC }, 1.0f, viewport.height() * 0.5f);
+        world.CreateBody<RectShape>({ .position = { viewport.width() * 0.5f, +                0 }, .type = BodyType::STATIC }, viewport.width() * 0.5f,  1.0f);
+        for (u32 i = 0; i < OBSTACLE_COUNT; ++i) {
+            world.CreateBody<CircleShape>({
+                .position = fVector2::random(rand, { 8, 72, 8, 35 }),
+                .type = BodyType::STATIC,
+                .density = 0.0f },
+            rand.Get(2.0f, 4.0f));
+        }
+
+        particles = ParticleSystem { world };
+        Vec<ParticleCreateOptions> spawns = Vec<ParticleCreateOptions>::WithCap(particleCount);
+        for (int i = 0; i < particleCount; ++i) {
+            spawns.Push({
+                .position = fVector2::random(rand, { 2, 78, 30, 58 }),
+                .velocity = fVector2::random(rand, { -2, 2, -2, 2 }),
+                .radius = particleRadius,
+            });
+        }
+        particles.SpawnMany(spawns);
+    }
+} // Test
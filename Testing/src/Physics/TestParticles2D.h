@@ -0,0 +1,42 @@
+#pragma once
+#include "InstanceBuffer.h"
+#include "Mesh.h"
+#include "Test.h"
+#include "Physics/ParticleSystem2D.h"
+#include "Physics/World2D.h"
+
+namespace Test {
+    class TestParticles2D : public Test {
+        static constexpr u32 DEFAULT_PARTICLE_COUNT = 100'000, OBSTACLE_COUNT = 6;
+
+        using Vertex = Graphics::Vertex2D;
+        struct Instance {
+            Math::fVector2 Offset;
+            float Scale, Speed;
+
+            QuasiDefineInstance$(Instance, (Offset)(Scale)(Speed));
+        };
+        Graphics::RenderObject<Vertex> scene;
+        Graphics::InstanceBuffer<Instance> instances;
+        Graphics::Mesh<Vertex> quad, circleMesh;
+        Graphics::Shader obstacleShader;
+
+        Physics2D::World world;
+        Physics2D::ParticleSystem particles;
+
+        Math::fRect2D viewport;
+        int particleCount = DEFAULT_PARTICLE_COUNT, simUpdates = 2;
+        float particleRadius = 0.06f;
+        float updateMs = 0;
+
+        DEFINE_TEST_T(TestParticles2D, SIM_PHYSICS);
+    public:
+        void OnInit(Graphics::GraphicsDevice& gdevice) override;
+        void OnUpdate(Graphics::GraphicsDevice& gdevice, float deltaTime) override;
+        void OnRender(Graphics::GraphicsDevice& gdevice) override;
+        void OnImGuiRender(Graphics::GraphicsDevice& gdevice) override;
+        void OnDestroy(Graphics::GraphicsDevice& gdevice) override;
+
+        void ResetParticles(Graphics::GraphicsDevice& gdevice);
+    };
+} // Test
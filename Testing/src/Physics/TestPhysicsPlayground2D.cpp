@@ -4,15 +4,19 @@
 
 #include "VertexBlueprint.h"
 #include "Extension/ImGuiExt.h"
-#include "Meshes/Circle.h"
-#include "Meshes/Stadium.h"
 
+#include "Timer.h"
 #include "Iter/MapIter.h"
 
 namespace Test {
     void TestPhysicsPlayground2D::OnInit(Graphics::GraphicsDevice& gdevice) {
         scene = gdevice.CreateNewRender<Vertex>(2048, 2048);
         scene.UseShaderFromFile(res("shader.vert"), res("shader.frag"));
+        projectionUniform = scene->shader.Uniform("u_projection");
+        scene.WatchShaderFiles(res("shader.vert"), res("shader.frag"));
+        gdevice.GetShaderReloader().OnReload(scene->shader, [this] (Graphics::Shader& shader) {
+            projectionUniform = shader.Uniform("u_projection");
+        });
 
         world = { { 0, -80.0f } };
         scene.SetProjection(Math::Matrix3D::ortho_projection({ -40, 40, -30, 30, -1, 1 }));
@@ -101,69 +105,9 @@ namespace Test {
     void TestPhysicsPlayground2D::OnRender(Graphics::GraphicsDevice& gdevice) {
         worldMesh.Clear();
 
-        u32 i = 0;
-
-        for (const auto& [body, color] : bodyData) {
-            const auto& t = body->GetTransform();
-            Qmatch$(body->shape, (
-                instanceof (const Physics2D::CircleShape& circ) {
-                    Graphics::MeshUtils::CircleCreator::Merge(
-                        { 16 },
-                        QGLCreateBlueprint$(Vertex, (
-                            in (Position),
-                            out (Position) = Position * circ.radius + t.position;,
-                            out (Color)    = color;
-                        )),
-                        worldMesh
-                    );
-                    AddNewPoint(t.Transform({ circ.radius, 0 }), Math::fColor::WHITE());
-                },
-                instanceof (const Physics2D::CapsuleShape& cap) {
-                    Graphics::MeshUtils::StadiumCreator::Merge(
-                        { .start = -cap.forward, .end = cap.forward, .radius = cap.radius, .subdivisions = 4 },
-                        QGLCreateBlueprint$(Vertex, (
-                            in (Position),
-                            out (Position) = t * Position;,
-                            out (Color)    = color;
-                        )), worldMesh
-                    );
-                    AddNewPoint(t.Transform(cap.forward.perpend() * (cap.invLength * cap.radius)), Math::fColor::WHITE());
-                },
-                instanceof (const Physics2D::TriangleShape& tri) {
-                    worldMesh.NewBatch().PushTri(
-                        { t * tri.points[0], color },
-                        { t * tri.points[1], color },
-                        { t * tri.points[2], color }
-                    );
-                },
-                instanceof (const Physics2D::RectShape& rect) {
-                    worldMesh.NewBatch().PushPolygon({
-                        { t * rect.Corner(false, false), color },
-                        { t * rect.Corner(true,  false), color },
-                        { t * rect.Corner(true,  true ), color },
-                        { t * rect.Corner(false, true ), color },
-                    });
-                },
-                instanceof (const Physics2D::QuadShape& quad) {
-                    worldMesh.NewBatch().PushPolygon({
-                        { t * quad.points[0], color },
-                        { t * quad.points[1], color },
-                        { t * quad.points[2], color },
-                        { t * quad.points[3], color },
-                    });
-                },
-                instanceof (const Physics2D::DynPolygonShape& poly) {
-                    worldMesh.NewBatch().PushPolygon(
-                        poly.data.Iter()
-                                 .Map(Operators::Member<&Physics2D::DynPolygonShape::PointWithInvDist::coords> {})
-                                 .Map([&] (const Math::fVector2& p) {
-                                        return Vertex { body->rotation.rotate(p) + body->position, color };
-                        })
-                    );
-                }
-            ))
-            ++i;
-        }
+        for (u32 i = 0; i < bodyData.Length(); ++i)
+            bodyMesh.SetColor(i, bodyData[i].color);
+        bodyMesh.Update();
 
         if (hasAddedForce) {
             const Math::fColor blue = Math::fColor::BLUE();
@@ -185,7 +129,9 @@ namespace Test {
         Math::fRect3D viewport = Math::fRect3D { -40, 40, -30, 30, -1, 1 } * zoomFactor + cameraPosition;
         viewport.min.z = -1;
         viewport.max.z = +1;
-        scene.Draw(worldMesh, Graphics::UseArgs({{ "u_projection", Math::Matrix3D::ortho_projection(viewport) }}, false));
+        const Math::Matrix3D projection = Math::Matrix3D::ortho_projection(viewport);
+        scene.Draw({ &bodyMesh.GetMesh(), &worldMesh },
+            Graphics::UseArgs(Graphics::FixedShaderArgs<1>().then(projectionUniform, projection), false));
     }
 
     void TestPhysicsPlayground2D::OnImGuiRender(Graphics::GraphicsDevice& gdevice) {
@@ -222,7 +168,10 @@ namespace Test {
             };
             ImGui::Text("Type: %s", SHAPE_NAMES[Selected()->body->shape.ID()]);
 
-            EditBody();
+            if (EditBody()) {
+                Selected()->body->SetShapeHasChanged();
+                bodyMesh.MarkShapeChanged(selectedIndex);
+            }
             ImGui::EditComplexRotation("Rotation", Selected()->body->rotation);
             float m = Selected()->body->mass;
             ImGui::EditScalar("Mass", m, 1, Math::fRange { 0, INFINITY });
@@ -232,6 +181,7 @@ namespace Test {
             if (ImGui::Button("Delete")) {
                 Selected()->body.Remove();
                 bodyData.Pop(selectedIndex);
+                bodyMesh.Untrack(selectedIndex);
                 selectedIndex = ~0;
                 controlIndex = ~0;
             }
@@ -239,6 +189,18 @@ namespace Test {
             ImGui::TreePop();
         }
 
+        if (ImGui::TreeNode("Collision Kernels")) {
+            if (ImGui::Button("Run Benchmark")) BenchmarkKernels(rand);
+            constexpr const char* PAIR_NAMES[] = { "Circle-Capsule", "Circle-Rect", "Rect-Capsule", "Capsule-Capsule" };
+            for (u32 i = 0; i < 4; ++i) {
+                if (kernelBenchNs[i][0] > 0)
+                    ImGui::Text("%s: %.1fns/pair (solver %.1fns/pair)", PAIR_NAMES[i], kernelBenchNs[i][1], kernelBenchNs[i][0]);
+                else
+                    ImGui::Text("%s: %.1fns/pair", PAIR_NAMES[i], kernelBenchNs[i][1]);
+            }
+            ImGui::TreePop();
+        }
+
         if (ImGui::Button(onPause ? "Unpause" : "Pause")) {
             onPause = !onPause;
         }
@@ -301,6 +263,7 @@ namespace Test {
 
     void TestPhysicsPlayground2D::AddBodyTint(const Math::fColor& color) {
         bodyData.Push({ world.bodies.Last(), color });
+        bodyMesh.Track(world.bodies.Last(), color);
     }
 
     void TestPhysicsPlayground2D::SelectControl(const Math::fVector2& mouse) {
@@ -403,6 +366,7 @@ namespace Test {
             else return;
         ))
         Selected()->body->SetShapeHasChanged();
+        bodyMesh.MarkShapeChanged(selectedIndex);
     }
 
     void TestPhysicsPlayground2D::EditControlPoint(const Math::fVector2& mouse, Math::fVector2& control, u32 i) {
@@ -450,7 +414,9 @@ namespace Test {
         ))
     }
 
-    void TestPhysicsPlayground2D::EditBody() {
+    bool TestPhysicsPlayground2D::EditBody() {
+        // grouped so the group says if any of the fields were edited
+        ImGui::BeginGroup();
         Qmatch$ (Selected()->body->shape, (
             instanceof (Physics2D::CircleShape& circ) {
                 ImGui::EditScalar("Radius", circ.radius, 0.2, Math::fRange { 0, 100 });
@@ -491,6 +457,8 @@ namespace Test {
                 poly.FixPolygon();
             }
         ))
+        ImGui::EndGroup();
+        return ImGui::IsItemEdited();
     }
 
     void TestPhysicsPlayground2D::AddRandomCircle(Math::RandomGenerator& rand) {
@@ -575,4 +543,36 @@ namespace Test {
 
         AddBodyTint(Math::fColor::random(rand, 0.8, 0.8));
     }
-}
\ No newline at end of file
+
+    void TestPhysicsPlayground2D::BenchmarkKernels(Math::RandomGenerator& rand) {
+        using namespace Physics2D;
+        constexpr u32 PAIRS = 1024, ROUNDS = 100;
+        const Shape circle = CircleShape { 1.0f }, capsule = CapsuleShape { { 1.5f, 0 }, 0.75f }, rect = RectShape { 1.5f, 1.0f };
+        const PhysicsTransform origin;
+
+        Vec<PhysicsTransform> placements = Vec<PhysicsTransform>::WithCap(PAIRS);
+        for (u32 i = 0; i < PAIRS; ++i)
+            placements.Push({ Math::fVector2::random_on_unit(rand) * rand.Get(0.0f, 4.0f), Math::fComplex::rotate(rand.Get(0, Math::TAU)) });
+
+        const auto nsPerPair = [&] (auto&& collide) {
+            float checksum = 0;
+            Debug::Timer timer { "kernel" };
+            for (u32 r = 0; r < ROUNDS; ++r)
+                for (const PhysicsTransform& xf : placements)
+                    checksum += collide(xf).contactDepth[0];
+            const u64 ns = Debug::Timer::UnitConvert<Debug::Nanosecond>(timer.Stop());
+            // keeps the loop from being optimized out
+            [[maybe_unused]] volatile float sink = checksum;
+            return (float)ns / (float)(PAIRS * ROUNDS);
+        };
+
+        kernelBenchNs[0][0] = nsPerPair([&] (const PhysicsTransform& xf) { return CollideCircleShape(circle, origin, capsule, xf); });
+        kernelBenchNs[0][1] = nsPerPair([&] (const PhysicsTransform& xf) { return CollideShapes(circle, origin, capsule, xf); });
+        kernelBenchNs[1][0] = nsPerPair([&] (const PhysicsTransform& xf) { return CollideCircleShape(circle, origin, rect, xf); });
+        kernelBenchNs[1][1] = nsPerPair([&] (const PhysicsTransform& xf) { return CollideShapes(circle, origin, rect, xf); });
+        kernelBenchNs[2][0] = nsPerPair([&] (const PhysicsTransform& xf) { return CollidePolygonCapsule(rect, origin, capsule, xf); });
+        kernelBenchNs[2][1] = nsPerPair([&] (const PhysicsTransform& xf) { return CollideShapes(rect, origin, capsule, xf); });
+        kernelBenchNs[3][0] = nsPerPair([&] (const PhysicsTransform& xf) { return CollideCapsulesSolver(capsule, origin, capsule, xf); });
+        kernelBenchNs[3][1] = nsPerPair([&] (const PhysicsTransform& xf) { return CollideShapes(capsule, origin, capsule, xf); });
+    }
+}
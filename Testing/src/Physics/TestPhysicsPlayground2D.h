@@ -2,6 +2,7 @@
 #include "Mesh.h"
 #include "Test.h"
 #include "Physics/World2D.h"
+#include "Physics/DebugMesh2D.h"
 
 namespace Test {
     class TestPhysicsPlayground2D : public Test {
@@ -13,7 +14,9 @@ namespace Test {
         };
 
         Graphics::RenderObject<Vertex> scene;
-        Graphics::Mesh<Vertex> worldMesh;
+        Graphics::UniformHandle projectionUniform;
+        Graphics::Mesh<Vertex> worldMesh; // overlays, rebuilt every frame
+        Physics2D::DebugMeshBuilder bodyMesh;
         Vec<Object> bodyData;
         Physics2D::World world;
 
@@ -32,6 +35,8 @@ namespace Test {
 
         u32 onPause = 0;
 
+        float kernelBenchNs[4][2] {}; // per pair type: { through the solver, closed form }
+
         DEFINE_TEST_T(TestPhysicsPlayground2D, SIM_PHYSICS)
     public:
         TestPhysicsPlayground2D() = default;
@@ -56,7 +61,7 @@ namespace Test {
         void EditControl(const Math::fVector2& mouse);
         void EditControlPoint(const Math::fVector2& mouse, Math::fVector2& control, u32 i);
         void DrawControlPoints();
-        void EditBody();
+        bool EditBody(); // true if the shape was edited
 
         void AddRandomCircle (Math::RandomGenerator& rand);
         void AddRandomCapsule(Math::RandomGenerator& rand);
@@ -64,5 +69,7 @@ namespace Test {
         void AddRandomRect   (Math::RandomGenerator& rand);
         void AddRandomQuad   (Math::RandomGenerator& rand);
         void AddRandomPolygon(Math::RandomGenerator& rand);
+
+        void BenchmarkKernels(Math::RandomGenerator& rand);
     };
 }
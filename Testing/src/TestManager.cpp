@@ -8,6 +8,7 @@
 #include "Basic/TestBatchedTextured.h"
 #include "Basic/TestDynamicVertexGeometry.h"
 #include "Basic/TestDynamicQuadGeometry.h"
+#include "Basic/TestSpriteBatch.h"
 #include "Basic/TestCubeRender.h"
 
 #include "Advanced/TestFontRender.h"
@@ -19,14 +20,20 @@
 #include "Advanced/TestDrawInstances.h"
 #include "Advanced/TestGeometryShader.h"
 #include "Advanced/TestShadowMap.h"
+#include "Advanced/TestPackedNormals.h"
 
 #include "Demos/DemoFlappyBird.h"
 
 #include "Physics/TestCircleCollision2D.h"
 #include "Physics/TestPhysicsPlayground2D.h"
+#include "Physics/TestParticles2D.h"
 
 namespace Test {
     void TestManager::OnInit() {
+        // shaders compiled once are loaded as binaries on later runs
+        const String cacheDir = std::format("{}shadercache", PROJECT_DIRECTORY);
+        gdevice.GetProgramCache().Enable(cacheDir);
+
         menu = Box<TestMenu>::Build(*this);
         currentTest = *menu;
         {
@@ -45,8 +52,11 @@ namespace Test {
             menu->RegisterTest<TestDynamicQuadGeometry>("Dyn Quad Geometry");
             menu->AddDescription("Draws up to 8 Unique Modifiable squares.");
 
+            menu->RegisterTest<TestSpriteBatch>("Sprite Batching");
+            menu->AddDescription("Moves 50k separate quads every frame and batches them into one draw, built on the worker pool.");
+
             menu->RegisterTest<TestCubeRender>("Cube 3D Rendering");
-            menu->AddDescription("Draws a 3D cube.");
+            menu->AddDescription("Draws a 3D cube with an arm of smaller cubes parented to it through a scene graph.");
 
             // =========================================================================
 
@@ -75,11 +85,14 @@ namespace Test {
             menu->AddDescription("Draws houses using geometry shaders.");
 
             menu->RegisterTest<TestDrawInstances>("Draw Instanced");
-            menu->AddDescription("Draws cubes using instancing.");
+            menu->AddDescription("Draws cubes using instancing, skipping the ones culled by the frustum or hidden behind others.");
 
             menu->RegisterTest<TestShadowMap>("Shadow Map");
             menu->AddDescription("Draws a scene with simple shadows.");
 
+            menu->RegisterTest<TestPackedNormals>("Packed Normals");
+            menu->AddDescription("Draws a sphere with float normals next to one with octahedral packed normals.");
+
             // =========================================================================
 
             menu->DeclareTestType(TestType::SIM_PHYSICS);
@@ -91,6 +104,9 @@ namespace Test {
             menu->RegisterTest<TestPhysicsPlayground2D>("2D Physics Playground");
             menu->AddDescription("A physics sandbox in 2D");
 
+            menu->RegisterTest<TestParticles2D>("2D Particles");
+            menu->AddDescription("Simulates a hundred thousand particles against static bodies.");
+
             // =========================================================================
 
             menu->DeclareTestType(TestType::DEMO);
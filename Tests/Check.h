@@ -0,0 +1,20 @@
+#pragma once
+#include <cstdio>
+
+// a failed check prints where it is and counts towards the exit code, the test keeps going
+namespace Check {
+    inline int failures = 0;
+
+    inline void Fail(const char* file, int line, const char* expr) {
+        ++failures;
+        std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+    }
+
+    inline int Finish(const char* name) {
+        if (failures) std::fprintf(stderr, "%s: %d check(s) failed\n", name, failures);
+        else          std::printf("%s: ok\n", name);
+        return failures;
+    }
+}
+
+#define QCheck$(...) ((__VA_ARGS__) ? (void)0 : Check::Fail(__FILE__, __LINE__, #__VA_ARGS__))
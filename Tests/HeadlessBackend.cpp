@@ -0,0 +1,105 @@
+#include <cstring>
+
+#include "Check.h"
+#include "glp_headless.h"
+
+// the backend itself, the other tests count on what it records
+namespace {
+    void TestBuffers() {
+        GL::Headless::Reset();
+        GL::Uint buffer = 0;
+        GL::GenBuffers(1, &buffer);
+        GL::BindBuffer(GL::ARRAY_BUFFER, buffer);
+        QCheck$(GL::Headless::BoundBuffer(GL::ARRAY_BUFFER) == buffer);
+
+        const GL::Ubyte data[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+        GL::BufferData(GL::ARRAY_BUFFER, sizeof(data), data, GL::DYNAMIC_DRAW);
+        QCheck$(GL::Headless::BufferContents(buffer).size() == sizeof(data));
+        QCheck$(GL::Headless::CurrentFrame().bytesUploaded == sizeof(data));
+
+        const GL::Ubyte patch[] = { 9, 9 };
+        GL::BufferSubData(GL::ARRAY_BUFFER, 2, sizeof(patch), patch);
+        QCheck$(GL::Headless::BufferContents(buffer)[2] == 9 && GL::Headless::BufferContents(buffer)[4] == 5);
+        QCheck$(GL::GetError() == 0);
+
+        GL::BufferSubData(GL::ARRAY_BUFFER, 7, sizeof(patch), patch);
+        QCheck$(GL::GetError() == GL::INVALID_VALUE);
+
+        auto* mapped = (GL::Ubyte*)GL::MapBufferRange(GL::ARRAY_BUFFER, 4, 4, GL::MAP_WRITE_BIT);
+        QCheck$(mapped != nullptr);
+        if (mapped) mapped[0] = 42;
+        GL::UnmapBuffer(GL::ARRAY_BUFFER);
+        QCheck$(GL::Headless::BufferContents(buffer)[4] == 42);
+
+        GL::DeleteBuffers(1, &buffer);
+        QCheck$(GL::Headless::BoundBuffer(GL::ARRAY_BUFFER) == 0);
+        QCheck$(GL::Headless::BufferContents(buffer).empty());
+    }
+
+    void TestFences() {
+        GL::Headless::Reset();
+        const GL::Sync a = GL::FenceSync(GL::SYNC_GPU_COMMANDS_COMPLETE, 0),
+                       b = GL::FenceSync(GL::SYNC_GPU_COMMANDS_COMPLETE, 0);
+        QCheck$(a && b && a != b);
+        QCheck$(GL::Headless::LiveSyncCount() == 2);
+        QCheck$(GL::ClientWaitSync(a, GL::SYNC_FLUSH_COMMANDS_BIT, 0) == GL::ALREADY_SIGNALED);
+
+        GL::DeleteSync(a);
+        QCheck$(GL::Headless::LiveSyncCount() == 1);
+        QCheck$(GL::ClientWaitSync(a, 0, 0) == GL::WAIT_FAILED);
+        QCheck$(GL::GetError() == GL::INVALID_VALUE);
+
+        GL::DeleteSync(nullptr);
+        QCheck$(GL::GetError() == 0);
+        GL::DeleteSync(b);
+        QCheck$(GL::Headless::LiveSyncCount() == 0);
+    }
+
+    void TestProgramBinary() {
+        GL::Headless::Reset();
+        const GL::Uint program = GL::CreateProgram();
+        GL::Int length = 0;
+        GL::GetProgramiv(program, GL::PROGRAM_BINARY_LENGTH, &length);
+        QCheck$(length > 0);
+
+        char binary[64] {};
+        GL::Isize written = 0;
+        GL::Enum format = 0;
+        GL::GetProgramBinary(program, sizeof(binary), &written, &format, binary);
+        QCheck$(written == length);
+
+        const GL::Uint loaded = GL::CreateProgram();
+        GL::Int status = 0;
+        GL::ProgramBinary(loaded, format, binary, written);
+        GL::GetProgramiv(loaded, GL::LINK_STATUS, &status);
+        QCheck$(status == 1);
+
+        binary[0] ^= 0xFF;
+        GL::ProgramBinary(loaded, format, binary, written);
+        GL::GetProgramiv(loaded, GL::LINK_STATUS, &status);
+        QCheck$(status == 0);
+    }
+
+    void TestFrameStats() {
+        GL::Headless::Reset();
+        GL::UseProgram(1);
+        GL::DrawElements(GL::TRIANGLES, 6, GL::UNSIGNED_INT, nullptr);
+        GL::DrawElementsInstanced(GL::TRIANGLES, 3, GL::UNSIGNED_INT, nullptr, 4);
+
+        const GL::Headless::FrameStats frame = GL::Headless::EndFrame();
+        QCheck$(frame.drawCalls == 2);
+        QCheck$(frame.primitivesSubmitted == 6 + 3 * 4);
+        QCheck$(frame.stateChanges == 1);
+        QCheck$(GL::Headless::CurrentFrame().calls == 0);
+        QCheck$(GL::Headless::Totals().drawCalls == 2);
+        QCheck$(GL::Headless::CallCount("DrawElements") == 1);
+    }
+}
+
+int main() {
+    TestBuffers();
+    TestFences();
+    TestProgramBinary();
+    TestFrameStats();
+    return Check::Finish("HeadlessBackend");
+}
@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <random>
+
+#include "Check.h"
+
+#include "Meshes/MeshOptimizer.h"
+
+// the vertex cache pass has to bring a grid close to the best order no matter how its triangles come in
+namespace {
+    using namespace Quasi;
+    using Graphics::TriIndices;
+    namespace MeshOptimizer = Graphics::MeshOptimizer;
+
+    constexpr u32 GRID = 100, SIDE = GRID + 1, VERTEX_COUNT = SIDE * SIDE;
+
+    Vec<TriIndices> GridTriangles() {
+        Vec<TriIndices> tris = Vec<TriIndices>::WithCap(GRID * GRID * 2);
+        for (u32 y = 0; y < GRID; ++y) {
+            for (u32 x = 0; x < GRID; ++x) {
+                const u32 v = y * SIDE + x;
+                tris.Push({ v, v + 1, v + SIDE });
+                tris.Push({ v + 1, v + SIDE + 1, v + SIDE });
+            }
+        }
+        return tris;
+    }
+
+    void Shuffle(Vec<TriIndices>& tris) {
+        std::mt19937 rng { 1234 };
+        std::shuffle(tris.Data(), tris.Data() + tris.Length(), rng);
+    }
+
+    // every triangle, as the sorted vertices, so reordering can be checked to keep the same ones
+    Vec<u64> TriangleSet(Span<const TriIndices> tris) {
+        Vec<u64> set = Vec<u64>::WithCap(tris.Length());
+        for (const TriIndices& t : tris) {
+            u32 v[3] = { t.i, t.j, t.k };
+            std::sort(v, v + 3);
+            set.Push(((u64)v[0] << 42) | ((u64)v[1] << 21) | v[2]);
+        }
+        std::sort(set.Data(), set.Data() + set.Length());
+        return set;
+    }
+
+    void TestShuffledGrid() {
+        const Vec<TriIndices> rowOrder = GridTriangles();
+        const MeshOptimizer::CacheStats rows = MeshOptimizer::AnalyzeVertexCache(rowOrder.AsSpan(), VERTEX_COUNT);
+
+        Vec<TriIndices> tris = rowOrder.Clone();
+        Shuffle(tris);
+        const MeshOptimizer::CacheStats before = MeshOptimizer::AnalyzeVertexCache(tris.AsSpan(), VERTEX_COUNT);
+        MeshOptimizer::OptimizeVertexCache(tris.AsSpan(), VERTEX_COUNT);
+        const MeshOptimizer::CacheStats after = MeshOptimizer::AnalyzeVertexCache(tris.AsSpan(), VERTEX_COUNT);
+        std::printf("grid %ux%u acmr: rows %.3f, shuffled %.3f, optimized %.3f (atvr %.3f)\n",
+            GRID, GRID, rows.acmr, before.acmr, after.acmr, after.atvr);
+
+        QCheck$(before.triangles == GRID * GRID * 2 && after.triangles == before.triangles);
+        // a shuffled grid shares next to nothing between neighbouring triangles
+        QCheck$(before.acmr > 2.8f);
+        // 0.5 is the limit for a grid this size, row order sits around 1
+        QCheck$(after.acmr < 0.75f);
+        QCheck$(after.acmr < rows.acmr);
+        QCheck$(after.atvr < 1.5f);
+        QCheck$(TriangleSet(tris.AsSpan()).AsSpan().Equals(TriangleSet(rowOrder.AsSpan()).AsSpan()));
+    }
+
+    void TestVertexFetch() {
+        Vec<TriIndices> tris = GridTriangles();
+        Shuffle(tris);
+        MeshOptimizer::OptimizeVertexCache(tris.AsSpan(), VERTEX_COUNT);
+        const MeshOptimizer::CacheStats cached = MeshOptimizer::AnalyzeVertexCache(tris.AsSpan(), VERTEX_COUNT);
+
+        const Vec<u32> remap = MeshOptimizer::OptimizeVertexFetch(tris.AsSpan(), VERTEX_COUNT);
+        QCheck$(remap.Length() == VERTEX_COUNT);
+        // a permutation, every new index is handed out once
+        Vec<u32> sorted = remap.Clone();
+        std::sort(sorted.Data(), sorted.Data() + sorted.Length());
+        bool permutation = true;
+        for (u32 v = 0; v < VERTEX_COUNT; ++v) permutation &= sorted[v] == v;
+        QCheck$(permutation);
+
+        // the vertices are now first used in order
+        u32 next = 0;
+        bool inOrder = true;
+        for (const TriIndices& t : tris) {
+            for (const u32 v : { t.i, t.j, t.k }) {
+                if (v > next) inOrder = false;
+                if (v == next) ++next;
+            }
+        }
+        QCheck$(inOrder);
+        // renumbering doesnt change what the cache sees
+        QCheck$(MeshOptimizer::AnalyzeVertexCache(tris.AsSpan(), VERTEX_COUNT).acmr == cached.acmr);
+    }
+
+    void TestEmpty() {
+        const MeshOptimizer::CacheStats stats = MeshOptimizer::AnalyzeVertexCache({}, 0);
+        QCheck$(stats.triangles == 0 && stats.acmr == 0);
+        MeshOptimizer::OptimizeVertexCache({}, 0);
+    }
+}
+
+int main() {
+    TestShuffledGrid();
+    TestVertexFetch();
+    TestEmpty();
+    return Check::Finish("MeshOptimizerACMR");
+}
@@ -0,0 +1,136 @@
+#include <cstring>
+#include <filesystem>
+
+#include <glp.h>
+
+#include "Check.h"
+#include "glp_headless.h"
+
+#include "ProgramCache.h"
+#include "Utils/CStr.h"
+#include "Utils/Text.h"
+
+// program binaries written to disk come back the same, anything else is turned away
+namespace {
+    using namespace Quasi;
+    using Graphics::ProgramCache;
+
+    String PathOf(const std::filesystem::path& p) {
+        const std::string s = p.string();
+        return String { Str::Slice(s.data(), s.size()) };
+    }
+
+    CStr Terminated(String& s) {
+        s += '\0';
+        return CStr::SliceUnchecked(s.Data(), s.Length() - 1);
+    }
+
+    void TestEncodeDecode() {
+        const ProgramCache::Binary binary = { .format = 0x1234, .data = String { "some program"_str } };
+        const String file = ProgramCache::Encode(42, binary);
+
+        const Option<ProgramCache::Binary> decoded = ProgramCache::Decode(file, 42);
+        QCheck$(decoded.HasValue());
+        if (decoded) {
+            QCheck$(decoded->format == 0x1234);
+            QCheck$(Str { decoded->data } == "some program"_str);
+        }
+
+        // empty programs still round trip
+        const String empty = ProgramCache::Encode(7, {});
+        QCheck$(ProgramCache::Decode(empty, 7).HasValue());
+    }
+
+    void TestRejectsCorrupt() {
+        const ProgramCache::Binary binary = { .format = 1, .data = String { "binary"_str } };
+        const String file = ProgramCache::Encode(42, binary);
+        const Str whole = file;
+
+        // another key, like sources that changed since
+        QCheck$(!ProgramCache::Decode(whole, 43));
+        // cut off in the header and in the body
+        QCheck$(!ProgramCache::Decode(whole.First(10), 42));
+        QCheck$(!ProgramCache::Decode(whole.First(whole.Length() - 1), 42));
+        QCheck$(!ProgramCache::Decode({}, 42));
+
+        String trailing = file;
+        trailing += 'x';
+        QCheck$(!ProgramCache::Decode(trailing, 42));
+
+        String badMagic = file;
+        badMagic[0] = 'X';
+        QCheck$(!ProgramCache::Decode(badMagic, 42));
+
+        // written by an older version of the cache
+        String stale = file;
+        const u32 oldVersion = ProgramCache::FILE_VERSION - 1;
+        std::memcpy(stale.Data() + 4, &oldVersion, sizeof(u32));
+        QCheck$(!ProgramCache::Decode(stale, 42));
+    }
+
+    void TestStoreLoad(const std::filesystem::path& dir) {
+        ProgramCache cache;
+        QCheck$(!cache.Store(1, {}));
+        QCheck$(!cache.Load(1));
+
+        cache.EnableWith(PathOf(dir), "headless|"_str);
+        QCheck$(cache.IsEnabled());
+        const u64 key = cache.KeyOf("vert"_str, "frag"_str, ""_str);
+        QCheck$(key != cache.KeyOf("frag"_str, "vert"_str, ""_str));
+        QCheck$(key != cache.KeyOf("ver"_str, "tfrag"_str, ""_str));
+
+        QCheck$(cache.Store(key, { .format = 9, .data = String { "linked"_str } }));
+        QCheck$(cache.GetStats().stores == 1);
+        const Option<ProgramCache::Binary> loaded = cache.Load(key);
+        QCheck$(loaded.HasValue());
+        if (loaded) QCheck$(loaded->format == 9 && Str { loaded->data } == "linked"_str);
+
+        // a file that was tampered with is a miss, not a crash
+        String path = cache.PathOf(key);
+        QCheck$(Text::WriteFileBinary(Terminated(path), "QPRG"_str));
+        QCheck$(!cache.Load(key));
+
+        // another driver doesnt see the entries of this one
+        ProgramCache other;
+        other.EnableWith(PathOf(dir), "another driver|"_str);
+        QCheck$(other.KeyOf("vert"_str, "frag"_str, ""_str) != key);
+    }
+
+    void TestPrograms(const std::filesystem::path& dir) {
+        ProgramCache cache;
+        cache.EnableWith(PathOf(dir), "headless|"_str);
+        const u64 key = cache.KeyOf("a"_str, "b"_str, ""_str);
+
+        QCheck$(cache.LoadProgram(key) == 0);
+        QCheck$(cache.GetStats().misses == 1);
+
+        const Graphics::GraphicsID linked = GL::CreateProgram();
+        GL::LinkProgram(linked);
+        cache.StoreProgram(key, linked);
+        GL::DeleteProgram(linked);
+        QCheck$(cache.GetStats().stores == 1);
+
+        const Graphics::GraphicsID loaded = cache.LoadProgram(key);
+        QCheck$(loaded != 0);
+        QCheck$(cache.GetStats().hits == 1);
+        if (loaded) GL::DeleteProgram(loaded);
+
+        // a binary from another driver version is refused by the driver and counted
+        QCheck$(cache.Store(key, { .format = 1, .data = String { "old driver"_str } }));
+        QCheck$(cache.LoadProgram(key) == 0);
+        QCheck$(cache.GetStats().rejected == 1);
+    }
+}
+
+int main() {
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "quasi-program-cache-test";
+    std::filesystem::remove_all(dir);
+
+    TestEncodeDecode();
+    TestRejectsCorrupt();
+    TestStoreLoad(dir);
+    TestPrograms(dir);
+
+    std::filesystem::remove_all(dir);
+    return Check::Finish("ProgramCacheRoundTrip");
+}
@@ -0,0 +1,146 @@
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <sstream>
+
+#include "Check.h"
+#include "glp_headless.h"
+
+#include "GraphicsDevice.h"
+#include "Mesh.h"
+
+// a streamed RenderData writes each frame into the next region of its buffers and fences it
+namespace {
+    using namespace Quasi;
+    using Vertex = Graphics::Vertex2D;
+
+    void TestRegionsRotate(Graphics::GraphicsDevice& gdevice) {
+        constexpr u32 FRAMES = 3;
+        Graphics::RenderObject<Vertex> scene = gdevice.CreateNewRender<Vertex>(16, 16);
+        Graphics::RenderData& rd = scene.GetRenderData();
+        rd.EnableStreaming(FRAMES);
+        QCheck$(rd.IsStreaming());
+
+        Graphics::Mesh<Vertex> tri = { { { { 0, 0 } }, { { 1, 0 } }, { { 0, 1 } } }, { { 0, 1, 2 } } };
+        u32 lastBase = ~0u;
+        for (u32 frame = 0; frame < 2 * FRAMES; ++frame) {
+            tri.vertices[0].Position.x = (float)frame;
+            scene.BeginContext();
+            scene.AddMesh(tri);
+            scene.EndContext();
+
+            const auto& range = rd.GetDrawRange();
+            QCheck$(range.indexCount == 3 && range.vertexCount == 3);
+            // every frame draws from a different region than the one before
+            QCheck$(range.baseVertex != lastBase);
+            lastBase = range.baseVertex;
+
+            const auto contents = GL::Headless::BufferContents(rd.vbo.rendererID);
+            float x = -1;
+            std::memcpy(&x, contents.data() + range.baseVertex * sizeof(Vertex), sizeof(float));
+            QCheck$(x == (float)frame);
+            // at most one fence per region is alive
+            QCheck$(GL::Headless::LiveSyncCount() <= FRAMES);
+        }
+        QCheck$(rd.StreamStalls() == 0);
+        QCheck$(rd.StreamGrows() == 0);
+        QCheck$(GL::Headless::CallCount("FenceSync") >= 2 * FRAMES - 1);
+
+        rd.DisableStreaming();
+        QCheck$(GL::Headless::LiveSyncCount() == 0);
+        scene.Destroy();
+    }
+
+    void TestGrowKeepsFrame(Graphics::GraphicsDevice& gdevice) {
+        Graphics::RenderObject<Vertex> scene = gdevice.CreateNewRender<Vertex>(4, 4);
+        Graphics::RenderData& rd = scene.GetRenderData();
+        rd.EnableStreaming(2);
+
+        Graphics::Mesh<Vertex> tri = { { { { 0, 0 } }, { { 1, 0 } }, { { 0, 1 } } }, { { 0, 1, 2 } } };
+        scene.BeginContext();
+        for (u32 i = 0; i < 8; ++i) scene.AddMesh(tri);
+        scene.EndContext();
+
+        QCheck$(rd.StreamGrows() > 0);
+        QCheck$(rd.GetDrawRange().indexCount == 8 * 3);
+        QCheck$(rd.GetDrawRange().vertexCount == 8 * 3);
+        scene.Destroy();
+    }
+
+    // queued draws are only issued at the flush, so a region can only be mapped again once a fence
+    // made after its last draw was waited on
+    void TestQueuedFillsWaitForDraws(Graphics::GraphicsDevice& gdevice) {
+        constexpr u32 FRAMES = 3, FILLS = 5;
+        Graphics::RenderObject<Vertex> scene = gdevice.CreateNewRender<Vertex>(16, 16);
+        Graphics::RenderData& rd = scene.GetRenderData();
+        rd.shader = Graphics::Shader::New("#version 330\nvoid main() {}", "#version 330\nvoid main() {}");
+        rd.EnableStreaming(FRAMES);
+
+        GL::Headless::ClearTrace();
+        GL::Headless::EnableTrace();
+        Graphics::Mesh<Vertex> tri = { { { { 0, 0 } }, { { 1, 0 } }, { { 0, 1 } } }, { { 0, 1, 2 } } };
+        for (u32 fill = 0; fill < FILLS; ++fill) {
+            scene.BeginContext();
+            scene.AddMesh(tri);
+            scene.EndContext();
+            // a layer each, so the draws arent merged and every one shows its base vertex
+            rd.Submit({ .useDefaultArguments = false }, fill);
+            QCheck$(GL::Headless::LiveSyncCount() <= FRAMES);
+        }
+        gdevice.GetRenderQueue().Flush(gdevice);
+        GL::Headless::EnableTrace(false);
+
+        constexpr usize NONE = ~0ull;
+        std::map<u32, usize> fencedAt;
+        usize lastDraw[FRAMES] = { NONE, NONE, NONE };
+        bool waited[FRAMES] {};
+        long long regionBytes = 0;
+        u32 draws = 0, remaps = 0;
+
+        std::istringstream trace { GL::Headless::DumpTrace() };
+        std::string line;
+        for (usize at = 0; std::getline(trace, line); ++at) {
+            u32 sync = 0;
+            int base = 0;
+            long long offset = 0, length = 0;
+            if (std::sscanf(line.c_str(), "FenceSync %u", &sync) == 1) {
+                fencedAt[sync] = at;
+            } else if (std::sscanf(line.c_str(), "ClientWaitSync %u", &sync) == 1) {
+                const auto fence = fencedAt.find(sync);
+                for (u32 r = 0; r < FRAMES; ++r)
+                    if (fence != fencedAt.end() && lastDraw[r] != NONE && fence->second > lastDraw[r]) waited[r] = true;
+            } else if (std::sscanf(line.c_str(), "DrawElementsBaseVertex 0x%*X %*d @%*lld+%d", &base) == 1) {
+                QCheck$(regionBytes > 0);
+                if (regionBytes <= 0) continue;
+                const u32 region = (u32)(base * sizeof(Vertex) / regionBytes);
+                QCheck$(region < FRAMES);
+                if (region >= FRAMES) continue;
+                lastDraw[region] = at;
+                waited[region] = false;
+                ++draws;
+            } else if (std::sscanf(line.c_str(), "MapBufferRange 0x8892 %lld+%lld", &offset, &length) == 2) {
+                regionBytes = length;
+                const u32 region = (u32)(offset / length);
+                if (region >= FRAMES || lastDraw[region] == NONE) continue;
+                // the region was drawn from before, that draw has to be done
+                QCheck$(waited[region]);
+                ++remaps;
+            }
+        }
+        QCheck$(draws == FILLS);
+        QCheck$(remaps == FILLS - FRAMES);
+
+        rd.DisableStreaming();
+        QCheck$(GL::Headless::LiveSyncCount() == 0);
+        scene.Destroy();
+    }
+}
+
+int main() {
+    // no window, the device only hands out renders here
+    Graphics::GraphicsDevice gdevice { nullptr, { 800, 600 } };
+    TestRegionsRotate(gdevice);
+    TestGrowKeepsFrame(gdevice);
+    TestQueuedFillsWaitForDraws(gdevice);
+    return Check::Finish("RenderDataStreaming");
+}